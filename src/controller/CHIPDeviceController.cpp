@@ -292,6 +292,22 @@ void ChipDeviceController::ServiceEvents()
             printed = true;
         }
     }
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    if (mSystemLayer->State() == System::kLayerState_Initialized)
+        mSystemLayer->PrepareEvents(aSleepTime);
+
+    int eventCount = mSystemLayer->WaitForEvents(aSleepTime);
+    if (eventCount < 0)
+    {
+        ChipLogError(Controller, "epoll_wait failed: %s\n", ErrorStr(System::MapErrorPOSIX(errno)));
+        return;
+    }
+
+    if (mSystemLayer->State() == System::kLayerState_Initialized)
+    {
+        mSystemLayer->HandleEvents(eventCount);
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     fd_set readFDs, writeFDs, exceptFDs;
     int numFDs = 0;
 
@@ -321,6 +337,7 @@ void ChipDeviceController::ServiceEvents()
     {
         mInetLayer->HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 #endif
 }
 
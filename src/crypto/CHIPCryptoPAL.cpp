@@ -0,0 +1,252 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Platform agnostic implementation of the CHIP crypto primitives that are
+ *      built on top of the platform specific ones.
+ */
+
+#include "CHIPCryptoPAL.h"
+
+#include <support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace Crypto {
+
+CHIP_ERROR AES_CCM_Context::EncryptSegments(unsigned char * const * segments, const size_t * segment_lengths, size_t segment_count,
+                                            const unsigned char * aad, size_t aad_length, const unsigned char * iv,
+                                            size_t iv_length, unsigned char * tag, size_t tag_length)
+{
+    return CryptSegments(true, segments, segment_lengths, segment_count, aad, aad_length, iv, iv_length, tag, tag_length);
+}
+
+CHIP_ERROR AES_CCM_Context::DecryptSegments(unsigned char * const * segments, const size_t * segment_lengths, size_t segment_count,
+                                            const unsigned char * aad, size_t aad_length, const unsigned char * tag,
+                                            size_t tag_length, const unsigned char * iv, size_t iv_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    unsigned char expected_tag[kBlockLength];
+
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag_length <= sizeof(expected_tag), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    memcpy(expected_tag, tag, tag_length);
+
+    error = CryptSegments(false, segments, segment_lengths, segment_count, aad, aad_length, iv, iv_length, expected_tag,
+                          tag_length);
+
+exit:
+    return error;
+}
+
+/**
+ * AES-CCM as specified by RFC 3610. The CBC-MAC and the counter mode keystream
+ * are both advanced as the segments are walked, so each byte is read and written
+ * once, wherever the segment boundaries fall.
+ *
+ * When decrypting, @a tag holds the expected tag, and is overwritten.
+ */
+CHIP_ERROR AES_CCM_Context::CryptSegments(bool encrypt, unsigned char * const * segments, const size_t * segment_lengths,
+                                          size_t segment_count, const unsigned char * aad, size_t aad_length,
+                                          const unsigned char * iv, size_t iv_length, unsigned char * tag, size_t tag_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    unsigned char mac[kBlockLength];     // CBC-MAC state
+    unsigned char counter[kBlockLength]; // counter block A_i
+    unsigned char stream[kBlockLength];  // keystream block S_i
+    unsigned char tag_mask[kBlockLength];
+    unsigned char aad_header[6];
+    size_t aad_header_length = 0;
+    size_t mac_fill          = 0;
+    size_t stream_used       = kBlockLength;
+    size_t message_length    = 0;
+    size_t counter_length    = 0;
+    unsigned char diff       = 0;
+
+    VerifyOrExit(IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(segments != NULL && segment_lengths != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length >= 7 && iv_length <= 13, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag_length == 8 || tag_length == 12 || tag_length == 16, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(aad != NULL || aad_length == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(aad_length <= UINT32_MAX, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (size_t i = 0; i < segment_count; i++)
+    {
+        VerifyOrExit(segments[i] != NULL || segment_lengths[i] == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+        message_length += segment_lengths[i];
+    }
+    VerifyOrExit(message_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The message length must fit into the bytes of the block left over by the IV.
+    counter_length = kBlockLength - 1 - iv_length;
+    VerifyOrExit(counter_length >= sizeof(size_t) || (message_length >> (8 * counter_length)) == 0,
+                 error = CHIP_ERROR_MESSAGE_TOO_LONG);
+
+    // B_0: flags, IV and message length, which starts the CBC-MAC.
+    memset(mac, 0, sizeof(mac));
+    mac[0] = static_cast<unsigned char>(((aad_length > 0) ? 0x40 : 0) | (((tag_length - 2) / 2) << 3) | (counter_length - 1));
+    memcpy(&mac[1], iv, iv_length);
+    for (size_t i = 0; i < counter_length && i < sizeof(size_t); i++)
+    {
+        mac[kBlockLength - 1 - i] = static_cast<unsigned char>(message_length >> (8 * i));
+    }
+    SuccessOrExit(error = EncryptBlock(mac, mac));
+
+    // The AAD, prefixed with its length and padded to a block.
+    if (aad_length > 0)
+    {
+        if (aad_length < 0xFF00)
+        {
+            aad_header[aad_header_length++] = static_cast<unsigned char>(aad_length >> 8);
+            aad_header[aad_header_length++] = static_cast<unsigned char>(aad_length);
+        }
+        else
+        {
+            aad_header[aad_header_length++] = 0xFF;
+            aad_header[aad_header_length++] = 0xFE;
+            aad_header[aad_header_length++] = static_cast<unsigned char>(aad_length >> 24);
+            aad_header[aad_header_length++] = static_cast<unsigned char>(aad_length >> 16);
+            aad_header[aad_header_length++] = static_cast<unsigned char>(aad_length >> 8);
+            aad_header[aad_header_length++] = static_cast<unsigned char>(aad_length);
+        }
+
+        SuccessOrExit(error = MacUpdate(mac, mac_fill, aad_header, aad_header_length));
+        SuccessOrExit(error = MacUpdate(mac, mac_fill, aad, aad_length));
+        SuccessOrExit(error = MacFinishBlock(mac, mac_fill));
+    }
+
+    // A_0 encrypts the tag, A_1 onwards the message.
+    memset(counter, 0, sizeof(counter));
+    counter[0] = static_cast<unsigned char>(counter_length - 1);
+    memcpy(&counter[1], iv, iv_length);
+    SuccessOrExit(error = EncryptBlock(counter, tag_mask));
+
+    for (size_t i = 0; i < segment_count; i++)
+    {
+        unsigned char * data = segments[i];
+        size_t remaining     = segment_lengths[i];
+
+        while (remaining > 0)
+        {
+            size_t chunk;
+
+            if (stream_used == kBlockLength)
+            {
+                // Big-endian increment of the counter bytes following the IV.
+                size_t j = kBlockLength - 1;
+                while (++counter[j] == 0 && j > iv_length + 1)
+                {
+                    j--;
+                }
+                SuccessOrExit(error = EncryptBlock(counter, stream));
+                stream_used = 0;
+            }
+
+            chunk = kBlockLength - stream_used;
+            if (chunk > remaining)
+            {
+                chunk = remaining;
+            }
+
+            // The MAC covers the plaintext: before encrypting, after decrypting.
+            if (encrypt)
+            {
+                SuccessOrExit(error = MacUpdate(mac, mac_fill, data, chunk));
+            }
+            for (size_t j = 0; j < chunk; j++)
+            {
+                data[j] ^= stream[stream_used + j];
+            }
+            if (!encrypt)
+            {
+                SuccessOrExit(error = MacUpdate(mac, mac_fill, data, chunk));
+            }
+
+            stream_used += chunk;
+            data += chunk;
+            remaining -= chunk;
+        }
+    }
+
+    SuccessOrExit(error = MacFinishBlock(mac, mac_fill));
+
+    for (size_t i = 0; i < tag_length; i++)
+    {
+        const unsigned char computed = static_cast<unsigned char>(mac[i] ^ tag_mask[i]);
+
+        if (encrypt)
+        {
+            tag[i] = computed;
+        }
+        else
+        {
+            // Constant time, to not tell how much of the tag was right.
+            diff = static_cast<unsigned char>(diff | (tag[i] ^ computed));
+        }
+    }
+    VerifyOrExit(diff == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    memset(stream, 0, sizeof(stream));
+    memset(tag_mask, 0, sizeof(tag_mask));
+    return error;
+}
+
+CHIP_ERROR AES_CCM_Context::MacUpdate(unsigned char * mac, size_t & mac_fill, const unsigned char * data, size_t length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        mac[mac_fill++] ^= data[i];
+
+        if (mac_fill == kBlockLength)
+        {
+            SuccessOrExit(error = EncryptBlock(mac, mac));
+            mac_fill = 0;
+        }
+    }
+
+exit:
+    return error;
+}
+
+/**
+ * Zero-pad the CBC-MAC input to the end of the current block.
+ */
+CHIP_ERROR AES_CCM_Context::MacFinishBlock(unsigned char * mac, size_t & mac_fill)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    if (mac_fill > 0)
+    {
+        // Padding with zeros leaves the XORed state as it is.
+        SuccessOrExit(error = EncryptBlock(mac, mac));
+        mac_fill = 0;
+    }
+
+exit:
+    return error;
+}
+
+} // namespace Crypto
+} // namespace chip
@@ -27,8 +27,11 @@
 #include <stddef.h>
 
 #if CHIP_CRYPTO_OPENSSL
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 #elif CHIP_CRYPTO_MBEDTLS
+#include <mbedtls/aes.h>
+#include <mbedtls/ccm.h>
 #include <mbedtls/sha256.h>
 #endif
 
@@ -38,6 +41,7 @@ namespace Crypto {
 const size_t kMax_ECDSA_Signature_Length = 72;
 const size_t kMax_ECDH_Secret_Length     = 32;
 const size_t kSHA256_Hash_Length         = 32;
+const size_t kMax_AES_CCM_Key_Length     = 32;
 
 /**
  * @brief A function that implements AES-CCM encryption
@@ -78,6 +82,118 @@ CHIP_ERROR AES_CCM_decrypt(const unsigned char * ciphertext, size_t ciphertext_l
                            const unsigned char * tag, size_t tag_length, const unsigned char * key, size_t key_length,
                            const unsigned char * iv, size_t iv_length, unsigned char * plaintext);
 
+/**
+ * @brief A class that implements AES-CCM encryption and decryption with a key that is
+ *        expanded once, at initialization, and reused for every message.
+ *
+ * The per-message cost of AES_CCM_encrypt/AES_CCM_decrypt includes allocating a cipher
+ * context and running the key schedule. Long lived users of a key (e.g. secure sessions)
+ * should keep an AES_CCM_Context instead.
+ *
+ * Copies of a context expand their own key schedule and do not share state with the
+ * original.
+ **/
+
+class AES_CCM_Context
+{
+public:
+    AES_CCM_Context(void);
+    AES_CCM_Context(const AES_CCM_Context & other);
+    AES_CCM_Context & operator=(const AES_CCM_Context & other);
+    ~AES_CCM_Context(void);
+
+    /**
+     * @brief Set the key used by subsequent Encrypt/Decrypt calls
+     * @param key Encryption key
+     * @param key_length Length of encryption key (in bytes)
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR Init(const unsigned char * key, size_t key_length);
+
+    /**
+     * @brief Same as AES_CCM_encrypt, using the key of this context
+     **/
+    CHIP_ERROR Encrypt(const unsigned char * plaintext, size_t plaintext_length, const unsigned char * aad, size_t aad_length,
+                       const unsigned char * iv, size_t iv_length, unsigned char * ciphertext, unsigned char * tag,
+                       size_t tag_length);
+
+    /**
+     * @brief Same as AES_CCM_decrypt, using the key of this context
+     **/
+    CHIP_ERROR Decrypt(const unsigned char * ciphertext, size_t ciphertext_length, const unsigned char * aad, size_t aad_length,
+                       const unsigned char * tag, size_t tag_length, const unsigned char * iv, size_t iv_length,
+                       unsigned char * plaintext);
+
+    /**
+     * @brief Encrypt a message split across several buffers, in place
+     *
+     * The result is the same as encrypting the concatenation of the segments with Encrypt,
+     * without copying them into one buffer first.
+     *
+     * @param segments Buffers holding the plaintext, in order; overwritten with the ciphertext
+     * @param segment_lengths Length of each segment, which may be zero
+     * @param segment_count Number of segments
+     * @param aad Additional authentication data
+     * @param aad_length Length of additional authentication data
+     * @param iv Initial vector, 7 to 13 bytes
+     * @param iv_length Length of initial vector
+     * @param tag Buffer to write tag into
+     * @param tag_length Expected length of tag
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR EncryptSegments(unsigned char * const * segments, const size_t * segment_lengths, size_t segment_count,
+                               const unsigned char * aad, size_t aad_length, const unsigned char * iv, size_t iv_length,
+                               unsigned char * tag, size_t tag_length);
+
+    /**
+     * @brief Decrypt a message split across several buffers, in place
+     *
+     * Returns CHIP_ERROR_INTERNAL, like Decrypt, when the tag does not match, in which case
+     * the content of the segments is unspecified.
+     **/
+    CHIP_ERROR DecryptSegments(unsigned char * const * segments, const size_t * segment_lengths, size_t segment_count,
+                               const unsigned char * aad, size_t aad_length, const unsigned char * tag, size_t tag_length,
+                               const unsigned char * iv, size_t iv_length);
+
+    bool IsInitialized(void) const { return mKeyLength != 0; }
+
+    /**
+     * @brief Release the expanded key and clear the key material
+     **/
+    void Clear(void);
+
+private:
+    static const size_t kBlockLength = 16;
+
+    // Neither backend can stream CCM, so the segmented variants implement it on top of
+    // single AES block encryptions, provided by each backend.
+    CHIP_ERROR CryptSegments(bool encrypt, unsigned char * const * segments, const size_t * segment_lengths,
+                             size_t segment_count, const unsigned char * aad, size_t aad_length, const unsigned char * iv,
+                             size_t iv_length, unsigned char * tag, size_t tag_length);
+    CHIP_ERROR MacUpdate(unsigned char * mac, size_t & mac_fill, const unsigned char * data, size_t length);
+    CHIP_ERROR MacFinishBlock(unsigned char * mac, size_t & mac_fill);
+    CHIP_ERROR EncryptBlock(const unsigned char * in, unsigned char * out);
+
+    unsigned char mKey[kMax_AES_CCM_Key_Length]; ///< Kept so that copies can expand their own key
+    size_t mKeyLength;
+#if CHIP_CRYPTO_OPENSSL
+    EVP_CIPHER_CTX * mEncryptContext;
+    EVP_CIPHER_CTX * mDecryptContext;
+    EVP_CIPHER_CTX * mBlockContext; ///< AES-ECB with the same key, for EncryptBlock
+    // OpenSSL binds the IV and tag lengths to the key schedule, so each context
+    // remembers the lengths it was keyed for.
+    size_t mEncryptIVLength;
+    size_t mEncryptTagLength;
+    size_t mDecryptIVLength;
+    size_t mDecryptTagLength;
+#elif CHIP_CRYPTO_MBEDTLS
+    mbedtls_ccm_context mContext;
+    mbedtls_aes_context mBlockContext; ///< for EncryptBlock
+#else
+    AES_CCM_CTX_PLATFORM mContext; // To be defined by the platform specific implementation of AES-CCM.
+#endif
+};
+
 /**
  * @brief A function that implements SHA-256 hash
  * @param data The data to hash
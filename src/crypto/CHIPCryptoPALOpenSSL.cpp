@@ -260,6 +260,249 @@ exit:
     return error;
 }
 
+AES_CCM_Context::AES_CCM_Context(void) :
+    mKeyLength(0), mEncryptContext(NULL), mDecryptContext(NULL), mBlockContext(NULL), mEncryptIVLength(0), mEncryptTagLength(0),
+    mDecryptIVLength(0), mDecryptTagLength(0)
+{}
+
+AES_CCM_Context::AES_CCM_Context(const AES_CCM_Context & other) : AES_CCM_Context()
+{
+    *this = other;
+}
+
+AES_CCM_Context & AES_CCM_Context::operator=(const AES_CCM_Context & other)
+{
+    if (this != &other)
+    {
+        Clear();
+        if (other.IsInitialized())
+        {
+            // On failure the copy is left uninitialized, which Encrypt/Decrypt report.
+            (void) Init(other.mKey, other.mKeyLength);
+        }
+    }
+    return *this;
+}
+
+AES_CCM_Context::~AES_CCM_Context(void)
+{
+    Clear();
+}
+
+CHIP_ERROR AES_CCM_Context::Init(const unsigned char * key, size_t key_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    VerifyOrExit(key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    Clear();
+
+    mEncryptContext = EVP_CIPHER_CTX_new();
+    VerifyOrExit(mEncryptContext != NULL, error = CHIP_ERROR_NO_MEMORY);
+
+    mDecryptContext = EVP_CIPHER_CTX_new();
+    VerifyOrExit(mDecryptContext != NULL, error = CHIP_ERROR_NO_MEMORY);
+
+    mBlockContext = EVP_CIPHER_CTX_new();
+    VerifyOrExit(mBlockContext != NULL, error = CHIP_ERROR_NO_MEMORY);
+
+    result = EVP_EncryptInit_ex(mBlockContext, (key_length == 16) ? EVP_aes_128_ecb() : EVP_aes_256_ecb(), NULL, key, NULL);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    result = EVP_CIPHER_CTX_set_padding(mBlockContext, 0);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    memcpy(mKey, key, key_length);
+    mKeyLength = key_length;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        Clear();
+    }
+    return error;
+}
+
+void AES_CCM_Context::Clear(void)
+{
+    if (mEncryptContext != NULL)
+    {
+        EVP_CIPHER_CTX_free(mEncryptContext);
+        mEncryptContext = NULL;
+    }
+
+    if (mDecryptContext != NULL)
+    {
+        EVP_CIPHER_CTX_free(mDecryptContext);
+        mDecryptContext = NULL;
+    }
+
+    if (mBlockContext != NULL)
+    {
+        EVP_CIPHER_CTX_free(mBlockContext);
+        mBlockContext = NULL;
+    }
+
+    OPENSSL_cleanse(mKey, sizeof(mKey));
+    mKeyLength        = 0;
+    mEncryptIVLength  = 0;
+    mEncryptTagLength = 0;
+    mDecryptIVLength  = 0;
+    mDecryptTagLength = 0;
+}
+
+CHIP_ERROR AES_CCM_Context::Encrypt(const unsigned char * plaintext, size_t plaintext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * iv, size_t iv_length, unsigned char * ciphertext,
+                                    unsigned char * tag, size_t tag_length)
+{
+    int bytesWritten         = 0;
+    size_t ciphertext_length = 0;
+    CHIP_ERROR error         = CHIP_NO_ERROR;
+    int result               = 1;
+
+    VerifyOrExit(IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(plaintext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(plaintext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (iv_length != mEncryptIVLength || tag_length != mEncryptTagLength)
+    {
+        // Expand the key for this IV/tag length combination. This only happens on the
+        // first use of the context, as sessions use fixed lengths.
+        mEncryptIVLength  = 0;
+        mEncryptTagLength = 0;
+
+        result = EVP_EncryptInit_ex(mEncryptContext, (mKeyLength == 16) ? EVP_aes_128_ccm() : EVP_aes_256_ccm(), NULL, NULL, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        result = EVP_CIPHER_CTX_ctrl(mEncryptContext, EVP_CTRL_CCM_SET_IVLEN, iv_length, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        result = EVP_CIPHER_CTX_ctrl(mEncryptContext, EVP_CTRL_CCM_SET_TAG, tag_length, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        result = EVP_EncryptInit_ex(mEncryptContext, NULL, NULL, mKey, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        mEncryptIVLength  = iv_length;
+        mEncryptTagLength = tag_length;
+    }
+
+    // Pass in iv, keeping the already expanded key
+    result = EVP_EncryptInit_ex(mEncryptContext, NULL, NULL, NULL, iv);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in plain text length
+    result = EVP_EncryptUpdate(mEncryptContext, NULL, &bytesWritten, NULL, plaintext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in AAD
+    if (aad_length > 0 && aad != NULL)
+    {
+        result = EVP_EncryptUpdate(mEncryptContext, NULL, &bytesWritten, aad, aad_length);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+    // Encrypt
+    result = EVP_EncryptUpdate(mEncryptContext, ciphertext, &bytesWritten, plaintext, plaintext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    ciphertext_length = bytesWritten;
+
+    // Finalize encryption
+    result = EVP_EncryptFinal_ex(mEncryptContext, ciphertext + ciphertext_length, &bytesWritten);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    ciphertext_length += bytesWritten;
+
+    // Get tag
+    result = EVP_CIPHER_CTX_ctrl(mEncryptContext, EVP_CTRL_CCM_GET_TAG, tag_length, tag);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_Context::Decrypt(const unsigned char * ciphertext, size_t ciphertext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * tag, size_t tag_length, const unsigned char * iv,
+                                    size_t iv_length, unsigned char * plaintext)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int bytesOutput  = 0;
+    int result       = 1;
+
+    VerifyOrExit(IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(ciphertext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(ciphertext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (iv_length != mDecryptIVLength || tag_length != mDecryptTagLength)
+    {
+        mDecryptIVLength  = 0;
+        mDecryptTagLength = 0;
+
+        result = EVP_DecryptInit_ex(mDecryptContext, (mKeyLength == 16) ? EVP_aes_128_ccm() : EVP_aes_256_ccm(), NULL, NULL, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        result = EVP_CIPHER_CTX_ctrl(mDecryptContext, EVP_CTRL_CCM_SET_IVLEN, iv_length, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        result = EVP_CIPHER_CTX_ctrl(mDecryptContext, EVP_CTRL_CCM_SET_TAG, tag_length, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        result = EVP_DecryptInit_ex(mDecryptContext, NULL, NULL, mKey, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        mDecryptIVLength  = iv_length;
+        mDecryptTagLength = tag_length;
+    }
+
+    // Pass in expected tag
+    result = EVP_CIPHER_CTX_ctrl(mDecryptContext, EVP_CTRL_CCM_SET_TAG, tag_length, (void *) tag);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in iv, keeping the already expanded key
+    result = EVP_DecryptInit_ex(mDecryptContext, NULL, NULL, NULL, iv);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in cipher text length
+    result = EVP_DecryptUpdate(mDecryptContext, NULL, &bytesOutput, NULL, ciphertext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in aad
+    if (aad_length > 0 && aad != NULL)
+    {
+        result = EVP_DecryptUpdate(mDecryptContext, NULL, &bytesOutput, aad, aad_length);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+    // Pass in ciphertext. We wont get anything if validation fails.
+    result = EVP_DecryptUpdate(mDecryptContext, plaintext, &bytesOutput, ciphertext, ciphertext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_Context::EncryptBlock(const unsigned char * in, unsigned char * out)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int bytesWritten = 0;
+    int result       = 1;
+
+    result = EVP_EncryptUpdate(mBlockContext, out, &bytesWritten, in, kBlockLength);
+    VerifyOrExit(result == 1 && bytesWritten == static_cast<int>(kBlockLength), error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
 CHIP_ERROR Hash_SHA256(const unsigned char * data, const size_t data_length, unsigned char * out_buffer)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
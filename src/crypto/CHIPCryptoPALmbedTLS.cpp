@@ -22,6 +22,7 @@
 
 #include "CHIPCryptoPAL.h"
 
+#include <mbedtls/aes.h>
 #include <mbedtls/bignum.h>
 #include <mbedtls/ccm.h>
 #include <mbedtls/ctr_drbg.h>
@@ -32,6 +33,7 @@
 #include <mbedtls/hkdf.h>
 #include <mbedtls/md.h>
 #include <mbedtls/pkcs5.h>
+#include <mbedtls/platform_util.h>
 #include <mbedtls/sha256.h>
 
 #include <support/CodeUtils.h>
@@ -159,6 +161,146 @@ exit:
     return error;
 }
 
+AES_CCM_Context::AES_CCM_Context(void) : mKeyLength(0)
+{
+    mbedtls_ccm_init(&mContext);
+    mbedtls_aes_init(&mBlockContext);
+}
+
+AES_CCM_Context::AES_CCM_Context(const AES_CCM_Context & other) : AES_CCM_Context()
+{
+    *this = other;
+}
+
+AES_CCM_Context & AES_CCM_Context::operator=(const AES_CCM_Context & other)
+{
+    if (this != &other)
+    {
+        Clear();
+        if (other.IsInitialized())
+        {
+            // On failure the copy is left uninitialized, which Encrypt/Decrypt report.
+            (void) Init(other.mKey, other.mKeyLength);
+        }
+    }
+    return *this;
+}
+
+AES_CCM_Context::~AES_CCM_Context(void)
+{
+    Clear();
+}
+
+CHIP_ERROR AES_CCM_Context::Init(const unsigned char * key, size_t key_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    VerifyOrExit(key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    Clear();
+
+    // Size of key = key_length * number of bits in a byte (8)
+    result = mbedtls_ccm_setkey(&mContext, MBEDTLS_CIPHER_ID_AES, key, key_length * 8);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    result = mbedtls_aes_setkey_enc(&mBlockContext, key, key_length * 8);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    memcpy(mKey, key, key_length);
+    mKeyLength = key_length;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        Clear();
+    }
+    return error;
+}
+
+void AES_CCM_Context::Clear(void)
+{
+    mbedtls_ccm_free(&mContext);
+    mbedtls_ccm_init(&mContext);
+    mbedtls_aes_free(&mBlockContext);
+    mbedtls_aes_init(&mBlockContext);
+
+    mbedtls_platform_zeroize(mKey, sizeof(mKey));
+    mKeyLength = 0;
+}
+
+CHIP_ERROR AES_CCM_Context::Encrypt(const unsigned char * plaintext, size_t plaintext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * iv, size_t iv_length, unsigned char * ciphertext,
+                                    unsigned char * tag, size_t tag_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    VerifyOrExit(IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(plaintext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(plaintext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_length > 0)
+    {
+        VerifyOrExit(aad != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Encrypt
+    result = mbedtls_ccm_encrypt_and_tag(&mContext, plaintext_length, iv, iv_length, aad, aad_length, plaintext, ciphertext, tag,
+                                         tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_Context::Decrypt(const unsigned char * ciphertext, size_t ciphertext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * tag, size_t tag_length, const unsigned char * iv,
+                                    size_t iv_length, unsigned char * plaintext)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    VerifyOrExit(IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(ciphertext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(ciphertext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_length > 0)
+    {
+        VerifyOrExit(aad != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Decrypt
+    result = mbedtls_ccm_auth_decrypt(&mContext, ciphertext_length, iv, iv_length, aad, aad_length, ciphertext, plaintext, tag,
+                                      tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_Context::EncryptBlock(const unsigned char * in, unsigned char * out)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    result = mbedtls_aes_crypt_ecb(&mBlockContext, MBEDTLS_AES_ENCRYPT, in, out);
+    _log_mbedTLS_error(result);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
 CHIP_ERROR Hash_SHA256(const unsigned char * data, const size_t data_length, unsigned char * out_buffer)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
@@ -342,6 +342,164 @@ static void TestAES_CCM_128DecryptTestVectors(nlTestSuite * inSuite, void * inCo
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+template <typename Vector>
+static void CheckAES_CCM_ContextVector(nlTestSuite * inSuite, const Vector * vector)
+{
+    AES_CCM_Context context;
+    unsigned char out_ct[vector->ct_len];
+    unsigned char out_tag[vector->tag_len];
+    unsigned char out_pt[vector->pt_len];
+    unsigned char bad_tag[vector->tag_len];
+
+    CHIP_ERROR err = context.Init(vector->key, vector->key_len);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The same expanded key must be reusable for several messages
+    for (int round = 0; round < 2; round++)
+    {
+        err = context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len, out_ct, out_tag,
+                              vector->tag_len);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(out_ct, vector->ct, vector->ct_len) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(out_tag, vector->tag, vector->tag_len) == 0);
+    }
+
+    // A failed authentication must not prevent decrypting the next message
+    memcpy(bad_tag, vector->tag, vector->tag_len);
+    bad_tag[0] ^= 0x01;
+    err = context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, bad_tag, vector->tag_len, vector->iv,
+                          vector->iv_len, out_pt);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INTERNAL);
+
+    err = context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len, vector->iv,
+                          vector->iv_len, out_pt);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(out_pt, vector->pt, vector->pt_len) == 0);
+
+    // Copies carry their own expanded key
+    AES_CCM_Context copy(context);
+    context.Clear();
+
+    memset(out_pt, 0, vector->pt_len);
+    err = copy.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len, vector->iv,
+                       vector->iv_len, out_pt);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(out_pt, vector->pt, vector->pt_len) == 0);
+
+    err = context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len, out_ct, out_tag,
+                          vector->tag_len);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INCORRECT_STATE);
+}
+
+static void TestAES_CCM_ContextTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    int numOfTestsRan = 0;
+
+    for (size_t vectorIndex = 0; vectorIndex < ArraySize(ccm_128_test_vectors); vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            CheckAES_CCM_ContextVector(inSuite, vector);
+        }
+    }
+
+    for (size_t vectorIndex = 0; vectorIndex < ArraySize(ccm_test_vectors); vectorIndex++)
+    {
+        const ccm_test_vector * vector = ccm_test_vectors[vectorIndex];
+        if (vector->key_len == 32 && vector->pt_len > 0)
+        {
+            numOfTestsRan++;
+            CheckAES_CCM_ContextVector(inSuite, vector);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
+template <typename Vector>
+static void CheckAES_CCM_SegmentsVector(nlTestSuite * inSuite, const Vector * vector)
+{
+    AES_CCM_Context context;
+    unsigned char buffer[vector->pt_len];
+    unsigned char out_tag[vector->tag_len];
+    unsigned char bad_tag[vector->tag_len];
+
+    CHIP_ERROR err = context.Init(vector->key, vector->key_len);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Split the message in three at every pair of points, including empty segments
+    for (size_t first = 0; first <= vector->pt_len; first++)
+    {
+        for (size_t second = first; second <= vector->pt_len; second++)
+        {
+            unsigned char * const segments[] = { buffer, buffer + first, buffer + second };
+            const size_t lengths[]           = { first, second - first, vector->pt_len - second };
+
+            memcpy(buffer, vector->pt, vector->pt_len);
+            err = context.EncryptSegments(segments, lengths, ArraySize(segments), vector->aad, vector->aad_len, vector->iv,
+                                          vector->iv_len, out_tag, vector->tag_len);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(buffer, vector->ct, vector->ct_len) == 0);
+            NL_TEST_ASSERT(inSuite, memcmp(out_tag, vector->tag, vector->tag_len) == 0);
+
+            err = context.DecryptSegments(segments, lengths, ArraySize(segments), vector->aad, vector->aad_len, vector->tag,
+                                          vector->tag_len, vector->iv, vector->iv_len);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(buffer, vector->pt, vector->pt_len) == 0);
+        }
+    }
+
+    unsigned char * const segments[] = { buffer };
+    const size_t lengths[]           = { vector->ct_len };
+
+    memcpy(bad_tag, vector->tag, vector->tag_len);
+    bad_tag[vector->tag_len - 1] ^= 0x80;
+    memcpy(buffer, vector->ct, vector->ct_len);
+    err = context.DecryptSegments(segments, lengths, ArraySize(segments), vector->aad, vector->aad_len, bad_tag, vector->tag_len,
+                                  vector->iv, vector->iv_len);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INTERNAL);
+}
+
+static void TestAES_CCM_SegmentsTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    int numOfTestsRan = 0;
+
+    for (size_t vectorIndex = 0; vectorIndex < ArraySize(ccm_128_test_vectors); vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            CheckAES_CCM_SegmentsVector(inSuite, vector);
+        }
+    }
+
+    for (size_t vectorIndex = 0; vectorIndex < ArraySize(ccm_test_vectors); vectorIndex++)
+    {
+        const ccm_test_vector * vector = ccm_test_vectors[vectorIndex];
+        if (vector->key_len == 32 && vector->pt_len > 0)
+        {
+            numOfTestsRan++;
+            CheckAES_CCM_SegmentsVector(inSuite, vector);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
+static void TestAES_CCM_ContextInvalidParams(nlTestSuite * inSuite, void * inContext)
+{
+    const unsigned char key[16] = { 0 };
+    AES_CCM_Context context;
+
+    NL_TEST_ASSERT(inSuite, !context.IsInitialized());
+    NL_TEST_ASSERT(inSuite, context.Init(NULL, sizeof(key)) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, context.Init(key, 15) == CHIP_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+    NL_TEST_ASSERT(inSuite, !context.IsInitialized());
+    NL_TEST_ASSERT(inSuite, context.Init(key, sizeof(key)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.IsInitialized());
+}
+
 static void TestAES_CCM_128EncryptInvalidPlainText(nlTestSuite * inSuite, void * inContext)
 {
     int numOfTestVectors = ArraySize(ccm_128_test_vectors);
@@ -926,6 +1084,9 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid key", TestAES_CCM_256DecryptInvalidKey),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid IV", TestAES_CCM_256DecryptInvalidIVLen),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid vectors", TestAES_CCM_256DecryptInvalidTestVectors),
+    NL_TEST_DEF("Test AES-CCM context test vectors", TestAES_CCM_ContextTestVectors),
+    NL_TEST_DEF("Test AES-CCM context invalid params", TestAES_CCM_ContextInvalidParams),
+    NL_TEST_DEF("Test AES-CCM segmented test vectors", TestAES_CCM_SegmentsTestVectors),
     NL_TEST_DEF("Test ECDSA signing and validation using SHA256", TestECDSA_Signing_SHA256),
     NL_TEST_DEF("Test ECDSA signature validation fail - Different msg", TestECDSA_ValidationFailsDifferentMessage),
     NL_TEST_DEF("Test ECDSA signature validation fail - Different signature", TestECDSA_ValidationFailIncorrectSignature),
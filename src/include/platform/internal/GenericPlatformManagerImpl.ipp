@@ -34,6 +34,7 @@
 
 #include <support/CodeUtils.h>
 #include <support/logging/CHIPLogging.h>
+#include <system/SystemLoopMetrics.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -181,17 +182,25 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const ChipDeviceEvent
         // Do nothing for no-op events.
         break;
 
-    case DeviceEventType::kChipSystemLayerEvent:
+    case DeviceEventType::kChipSystemLayerEvent: {
+        SYSTEM_LOOP_METRICS_SCOPE(kSource_Event, event->Type);
+
         // If the event is a CHIP System or Inet Layer event, deliver it to the SystemLayer event handler.
         Impl()->DispatchEventToSystemLayer(event);
         break;
+    }
+
+    case DeviceEventType::kCallWorkFunct: {
+        SYSTEM_LOOP_METRICS_SCOPE(kSource_Work, event->CallWorkFunct.WorkFunct);
 
-    case DeviceEventType::kCallWorkFunct:
         // If the event is a "call work function" event, call the specified function.
         event->CallWorkFunct.WorkFunct(event->CallWorkFunct.Arg);
         break;
+    }
+
+    default: {
+        SYSTEM_LOOP_METRICS_SCOPE(kSource_Event, event->Type);
 
-    default:
         // For all other events, deliver the event to each of the components in the Device Layer.
         Impl()->DispatchEventToDeviceLayer(event);
 
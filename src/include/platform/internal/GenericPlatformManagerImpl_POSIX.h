@@ -26,6 +26,7 @@
 #define GENERIC_PLATFORM_MANAGER_IMPL_POSIX_H
 
 #include <platform/internal/GenericPlatformManagerImpl.h>
+#include <support/MPSCQueue.h>
 
 #include <fcntl.h>
 #include <sched.h>
@@ -34,6 +35,7 @@
 #include <unistd.h>
 
 #include <pthread.h>
+
 #include <queue>
 
 namespace chip {
@@ -53,15 +55,22 @@ class GenericPlatformManagerImpl_POSIX : public GenericPlatformManagerImpl<ImplC
 {
 protected:
     // Members for select loop
+#if !CHIP_SYSTEM_CONFIG_USE_EPOLL
     int mMaxFd;
     fd_set mReadSet;
     fd_set mWriteSet;
     fd_set mErrorSet;
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     struct timeval mNextTimeout;
 
     // OS-specific members (pthread)
     pthread_mutex_t mChipStackLock;
-    std::queue<ChipDeviceEvent> mChipEventQueue;
+    // Posted to from any thread without taking the stack lock; drained by the event loop.
+    MPSCQueue<ChipDeviceEvent, CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE> mChipEventQueue;
+    // Events posted while mChipEventQueue is full, or while earlier events are still waiting here, so that none is dropped.
+    std::queue<ChipDeviceEvent> mChipEventOverflow;
+    pthread_mutex_t mChipEventOverflowLock;
+    size_t mChipEventOverflowCount; // Size of mChipEventOverflow, readable without the lock.
 
     pthread_t mChipTask;
     pthread_attr_t mChipTaskAttr;
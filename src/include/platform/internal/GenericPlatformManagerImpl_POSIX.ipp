@@ -33,6 +33,7 @@
 #include <platform/internal/GenericPlatformManagerImpl.ipp>
 
 #include <system/SystemLayer.h>
+#include <system/SystemLoopMetrics.h>
 
 #include <poll.h>
 #include <assert.h>
@@ -56,7 +57,9 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_InitChipStack(void)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    mChipStackLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+    mChipStackLock          = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+    mChipEventOverflowLock  = PTHREAD_MUTEX_INITIALIZER;
+    mChipEventOverflowCount = 0;
 
     // Initialize the Configuration Manager object.
     err = ConfigurationMgr().Init();
@@ -102,17 +105,49 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartChipTimer(uint32_t
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDeviceEvent * event)
 {
-    mChipEventQueue.push(*event); // Thread safe due to ChipStackLock taken by App thread
-    SysOnEventSignal(this);       // Trigger wake select on CHIP thread
+    // Once an event has overflowed, the following ones overflow too until the event loop catches up, so that they are
+    // dispatched in the order they were posted.
+    if (__atomic_load_n(&mChipEventOverflowCount, __ATOMIC_ACQUIRE) != 0 || !mChipEventQueue.Push(*event))
+    {
+        pthread_mutex_lock(&mChipEventOverflowLock);
+        mChipEventOverflow.push(*event);
+        __atomic_store_n(&mChipEventOverflowCount, mChipEventOverflow.size(), __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&mChipEventOverflowLock);
+    }
+
+    SysOnEventSignal(this); // Trigger wake select on CHIP thread
 }
 
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessDeviceEvents()
 {
-    while (!mChipEventQueue.empty())
+    ChipDeviceEvent event;
+    size_t i = 0;
+
+    // Bound the pass, so that handlers posting further events cannot starve the rest of the loop.
+    for (; i < CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE && mChipEventQueue.Pop(event); i++)
     {
-        Impl()->DispatchEvent(&mChipEventQueue.front());
-        mChipEventQueue.pop();
+        Impl()->DispatchEvent(&event);
+    }
+
+    // The overflowed events were posted after those left in mChipEventQueue.
+    for (; i < CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE && mChipEventQueue.IsEmpty() &&
+         __atomic_load_n(&mChipEventOverflowCount, __ATOMIC_ACQUIRE) != 0;
+         i++)
+    {
+        pthread_mutex_lock(&mChipEventOverflowLock);
+        event = mChipEventOverflow.front();
+        mChipEventOverflow.pop();
+        __atomic_store_n(&mChipEventOverflowCount, mChipEventOverflow.size(), __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&mChipEventOverflowLock);
+
+        Impl()->DispatchEvent(&event);
+    }
+
+    // Come back for the events left by the bound.
+    if (!mChipEventQueue.IsEmpty() || __atomic_load_n(&mChipEventOverflowCount, __ATOMIC_ACQUIRE) != 0)
+    {
+        SysOnEventSignal(this);
     }
 }
 
@@ -125,15 +160,24 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysOnEventSignal(void * arg)
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::SysUpdate()
 {
+#if !CHIP_SYSTEM_CONFIG_USE_EPOLL
     FD_ZERO(&mReadSet);
     FD_ZERO(&mWriteSet);
     FD_ZERO(&mErrorSet);
     mMaxFd = 0;
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 
     // Max out this duration and let CHIP set it appropriately.
     mNextTimeout.tv_sec  = DEFAULT_MIN_SLEEP_PERIOD;
     mNextTimeout.tv_usec = 0;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    // Endpoints are registered with the system layer, which also owns the timers.
+    if (SystemLayer.State() == System::kLayerState_Initialized)
+    {
+        SystemLayer.PrepareEvents(mNextTimeout);
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     if (SystemLayer.State() == System::kLayerState_Initialized)
     {
         SystemLayer.PrepareSelect(mMaxFd, &mReadSet, &mWriteSet, &mErrorSet, mNextTimeout);
@@ -143,6 +187,7 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysUpdate()
     {
         InetLayer.PrepareSelect(mMaxFd, &mReadSet, &mWriteSet, &mErrorSet, mNextTimeout);
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 template <class ImplClass>
@@ -156,7 +201,13 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysProcess()
     _StartChipTimer(nextTimeoutMs);
 
     Impl()->UnlockChipStack();
+    SYSTEM_LOOP_METRICS_WAIT_BEGIN();
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    selectRes = SystemLayer.WaitForEvents(mNextTimeout);
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     selectRes = select(mMaxFd + 1, &mReadSet, &mWriteSet, &mErrorSet, &mNextTimeout);
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+    SYSTEM_LOOP_METRICS_WAIT_END();
     Impl()->LockChipStack();
 
     if (selectRes < 0)
@@ -165,6 +216,12 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysProcess()
         return;
     }
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    if (SystemLayer.State() == System::kLayerState_Initialized)
+    {
+        SystemLayer.HandleEvents(selectRes);
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     if (SystemLayer.State() == System::kLayerState_Initialized)
     {
         SystemLayer.HandleSelectResult(mMaxFd, &mReadSet, &mWriteSet, &mErrorSet);
@@ -174,6 +231,7 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysProcess()
     {
         InetLayer.HandleSelectResult(mMaxFd, &mReadSet, &mWriteSet, &mErrorSet);
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 
     ProcessDeviceEvents();
 }
@@ -0,0 +1,282 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements DNSCache, the object that keeps the results of
+ *      recent host name lookups in InetLayer.
+ *
+ */
+
+#include <inet/DNSCache.h>
+
+#include <inet/InetLayer.h>
+
+#include <support/CodeUtils.h>
+#include <system/SystemStats.h>
+
+#include <string.h>
+#include <strings.h>
+
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE > 0
+
+namespace chip {
+namespace Inet {
+
+void DNSCache::Init(InetLayer & inet)
+{
+    mInet = &inet;
+
+    for (Entry & entry : mEntries)
+    {
+        entry.state   = kEntryState_Free;
+        entry.waiters = NULL;
+    }
+}
+
+/**
+ *  Forget all results, e.g. because the network changed. Requests in flight
+ *  still complete the lookups waiting for them.
+ */
+void DNSCache::Flush(void)
+{
+    for (Entry & entry : mEntries)
+    {
+        if (entry.state == kEntryState_Valid)
+            entry.state = kEntryState_Free;
+    }
+}
+
+/**
+ *  Release the lookups waiting for requests in flight, and forget all
+ *  entries. The requests themselves must have been canceled.
+ */
+void DNSCache::Shutdown(void)
+{
+    for (Entry & entry : mEntries)
+    {
+        DNSResolver * waiter = entry.waiters;
+
+        while (waiter != NULL)
+        {
+            DNSResolver * nextWaiter = waiter->pNextCacheWaiter;
+
+            waiter->Release();
+            waiter = nextWaiter;
+        }
+
+        entry.state   = kEntryState_Free;
+        entry.waiters = NULL;
+    }
+}
+
+/**
+ *  Resolve a host name from the cache if possible, or through the resolver
+ *  otherwise, taking over the DNSResolver object allocated for the lookup.
+ *
+ *  A lookup answered from the cache completes before this method returns.
+ *  A lookup of a name whose request is already in flight waits for it.
+ *  Otherwise a request is made with a DNSResolver object of its own, and
+ *  its result kept once it completes; if no entry or DNSResolver object is
+ *  available for this, the lookup bypasses the cache.
+ *
+ *  The parameters and return values are those of
+ *  InetLayer::ResolveHostAddress().
+ */
+INET_ERROR DNSCache::Resolve(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen, uint8_t options,
+                             uint8_t maxAddrs, IPAddress * addrArray, DNSResolver::OnResolveCompleteFunct onComplete,
+                             void * appState)
+{
+    const uint64_t nowMS  = System::Layer::GetClock_MonotonicMS();
+    Entry * entry         = Find(hostName, hostNameLen, options, maxAddrs);
+    DNSResolver * fetcher = NULL;
+    INET_ERROR err        = INET_NO_ERROR;
+
+    if (entry != NULL && entry->state == kEntryState_Valid && nowMS < entry->expiryMS)
+    {
+        SYSTEM_STATS_COUNT(chip::System::Stats::kInetLayer_DNSCacheHits);
+
+        entry->lastUseMS = nowMS;
+
+        for (uint8_t i = 0; i < entry->numAddrs; i++)
+            addrArray[i] = entry->addrs[i];
+
+        if (onComplete != NULL)
+            onComplete(appState, entry->error, entry->numAddrs, addrArray);
+
+        resolver.Release();
+        ExitNow();
+    }
+
+    resolver.AddrArray        = addrArray;
+    resolver.MaxAddrs         = maxAddrs;
+    resolver.NumAddrs         = 0;
+    resolver.DNSOptions       = options;
+    resolver.AppState         = appState;
+    resolver.OnComplete       = onComplete;
+    resolver.pNextCacheWaiter = NULL;
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+    resolver.mState = DNSResolver::kState_Active;
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+
+    if (entry != NULL && entry->state == kEntryState_Fetching)
+    {
+        DNSResolver ** tail = &entry->waiters;
+
+        SYSTEM_STATS_COUNT(chip::System::Stats::kInetLayer_DNSCacheCoalesced);
+
+        // Waiters are completed in the order they looked the name up.
+        while (*tail != NULL)
+            tail = &(*tail)->pNextCacheWaiter;
+        *tail = &resolver;
+
+        entry->lastUseMS = nowMS;
+        ExitNow();
+    }
+
+    SYSTEM_STATS_COUNT(chip::System::Stats::kInetLayer_DNSCacheMisses);
+
+    // An expired entry is refreshed in place.
+    if (entry == NULL)
+        entry = Allocate(nowMS);
+
+    if (entry != NULL)
+        fetcher = mInet->NewDNSResolver();
+
+    if (fetcher == NULL)
+    {
+        err = mInet->StartResolve(resolver, hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
+        ExitNow();
+    }
+
+    memcpy(entry->hostName, hostName, hostNameLen);
+    entry->hostName[hostNameLen] = 0;
+    entry->options               = options;
+    entry->maxAddrs              = maxAddrs;
+    entry->numAddrs              = 0;
+    entry->lastUseMS             = nowMS;
+    entry->state                 = kEntryState_Fetching;
+    entry->waiters               = &resolver;
+
+    // The request may complete synchronously, so the entry has to be ready for it.
+    err = mInet->StartResolve(*fetcher, entry->hostName, hostNameLen, options, maxAddrs, entry->addrs, HandleFetchComplete, entry);
+    if (err != INET_NO_ERROR)
+    {
+        // The fetcher released itself, and nothing else can be waiting for an entry just filled in.
+        entry->state   = kEntryState_Free;
+        entry->waiters = NULL;
+        resolver.Release();
+    }
+
+exit:
+    return err;
+}
+
+DNSCache::Entry * DNSCache::Find(const char * hostName, uint16_t hostNameLen, uint8_t options, uint8_t maxAddrs)
+{
+    for (Entry & entry : mEntries)
+    {
+        if (entry.state != kEntryState_Free && entry.options == options && entry.maxAddrs == maxAddrs &&
+            strncasecmp(entry.hostName, hostName, hostNameLen) == 0 && entry.hostName[hostNameLen] == 0)
+        {
+            return &entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ *  Return a free entry, else the least recently used one of those not
+ *  waiting for a request, preferring expired ones, or NULL if all requests
+ *  are in flight.
+ */
+DNSCache::Entry * DNSCache::Allocate(uint64_t nowMS)
+{
+    Entry * victim = NULL;
+
+    for (Entry & entry : mEntries)
+    {
+        if (entry.state == kEntryState_Free)
+            return &entry;
+
+        if (entry.state != kEntryState_Valid)
+            continue;
+
+        if (victim == NULL || (nowMS >= entry.expiryMS && nowMS < victim->expiryMS) ||
+            ((nowMS >= entry.expiryMS) == (nowMS >= victim->expiryMS) && entry.lastUseMS < victim->lastUseMS))
+        {
+            victim = &entry;
+        }
+    }
+
+    return victim;
+}
+
+void DNSCache::HandleFetchComplete(void * appState, INET_ERROR err, uint8_t addrCount, IPAddress * addrArray)
+{
+    Entry & entry          = *static_cast<Entry *>(appState);
+    DNSResolver * waiters  = entry.waiters;
+    const uint8_t numAddrs = (err == INET_NO_ERROR) ? addrCount : 0;
+    IPAddress addrs[INET_CONFIG_DNS_CACHE_MAX_ADDRS];
+
+    // The waiters may look names up again from their callbacks, and so reuse the entry: settle it first, and work on a copy.
+    for (uint8_t i = 0; i < numAddrs; i++)
+        addrs[i] = addrArray[i];
+
+    entry.waiters  = NULL;
+    entry.error    = err;
+    entry.numAddrs = numAddrs;
+
+    if (err == INET_NO_ERROR)
+    {
+        entry.state    = kEntryState_Valid;
+        entry.expiryMS = System::Layer::GetClock_MonotonicMS() + INET_CONFIG_DNS_CACHE_POSITIVE_TTL_MS;
+    }
+    else if (err == INET_ERROR_HOST_NOT_FOUND || err == INET_ERROR_DNS_TRY_AGAIN)
+    {
+        entry.state    = kEntryState_Valid;
+        entry.expiryMS = System::Layer::GetClock_MonotonicMS() + INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS;
+    }
+    else
+    {
+        entry.state = kEntryState_Free;
+    }
+
+    while (waiters != NULL)
+    {
+        DNSResolver & waiter = *waiters;
+
+        waiters = waiter.pNextCacheWaiter;
+
+        // Canceled lookups have no callback anymore.
+        if (waiter.OnComplete != NULL)
+        {
+            for (uint8_t i = 0; i < numAddrs; i++)
+                waiter.AddrArray[i] = addrs[i];
+
+            waiter.OnComplete(waiter.AppState, err, numAddrs, waiter.AddrArray);
+        }
+
+        waiter.Release();
+    }
+}
+
+} // namespace Inet
+} // namespace chip
+
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE > 0
@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines DNSCache, the object that keeps the results of
+ *      recent host name lookups in InetLayer.
+ *
+ */
+
+#ifndef DNSCACHE_H
+#define DNSCACHE_H
+
+#include <inet/DNSResolver.h>
+#include <inet/IPAddress.h>
+#include <inet/InetError.h>
+
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE > 0
+
+namespace chip {
+namespace Inet {
+
+class InetLayer;
+
+/**
+ *  @class DNSCache
+ *
+ *  @brief
+ *    This is an internal class to InetLayer that keeps the results of
+ *    recent host name lookups, and has concurrent lookups of a name share
+ *    a single request to the resolver. There is no public interface
+ *    available for the application layer.
+ *
+ *  @details
+ *    Entries are keyed by host name, DNS options and maximum number of
+ *    addresses, so that a cached result is exactly what the resolver
+ *    would have returned. Once full, the least recently used entry is
+ *    replaced; entries whose request is in flight are never replaced.
+ *
+ *    Everything happens on the thread running the event loop.
+ */
+class DNSCache
+{
+    friend class InetLayer;
+
+private:
+    enum EntryState
+    {
+        kEntryState_Free     = 0, ///< Holds nothing.
+        kEntryState_Fetching = 1, ///< A request to the resolver is in flight; lookups wait for it.
+        kEntryState_Valid    = 2, ///< Holds the result of a request until it expires.
+    };
+
+    struct Entry
+    {
+        DNSResolver * waiters; ///< Lookups waiting for the request in flight, linked by DNSResolver::pNextCacheWaiter.
+        uint64_t expiryMS;     ///< When a valid entry expires, on the monotonic clock.
+        uint64_t lastUseMS;    ///< When the entry was last looked up, on the monotonic clock.
+        INET_ERROR error;      ///< Result of the request.
+        uint8_t state;         ///< An EntryState.
+        uint8_t options;       ///< DNS options of the lookup.
+        uint8_t maxAddrs;      ///< Maximum number of addresses of the lookup.
+        uint8_t numAddrs;      ///< Number of addresses in addrs.
+        IPAddress addrs[INET_CONFIG_DNS_CACHE_MAX_ADDRS];
+        char hostName[NL_DNS_HOSTNAME_MAX_LEN + 1];
+    };
+
+    void Init(InetLayer & inet);
+    void Flush(void);
+    void Shutdown(void);
+
+    INET_ERROR Resolve(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen, uint8_t options, uint8_t maxAddrs,
+                       IPAddress * addrArray, DNSResolver::OnResolveCompleteFunct onComplete, void * appState);
+
+    Entry * Find(const char * hostName, uint16_t hostNameLen, uint8_t options, uint8_t maxAddrs);
+    Entry * Allocate(uint64_t nowMS);
+
+    static void HandleFetchComplete(void * appState, INET_ERROR err, uint8_t addrCount, IPAddress * addrArray);
+
+    InetLayer * mInet;
+    Entry mEntries[INET_CONFIG_DNS_CACHE_SIZE];
+};
+
+} // namespace Inet
+} // namespace chip
+
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE > 0
+
+#endif // !defined(DNSCACHE_H)
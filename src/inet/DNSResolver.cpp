@@ -51,8 +51,6 @@
 namespace chip {
 namespace Inet {
 
-chip::System::ObjectPool<DNSResolver, INET_CONFIG_NUM_DNS_RESOLVERS> DNSResolver::sPool;
-
 /**
  *  This method revolves a host name into a list of IP addresses.
  *
@@ -272,7 +270,7 @@ INET_ERROR DNSResolver::Cancel()
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
-    // NOTE: DNS lookups can be canceled only when using the asynchronous mode.
+    // NOTE: DNS lookups can be canceled only when using the asynchronous or the native mode.
 
     InetLayer & inet = Layer();
 
@@ -280,7 +278,16 @@ INET_ERROR DNSResolver::Cancel()
     AppState   = NULL;
     inet.mAsyncDNSResolver.Cancel(*this);
 
-#endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#elif INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
+    InetLayer & inet = Layer();
+
+    // Lookups waiting for a request of the DNS cache are not known to the client; they are released once it completes.
+    OnComplete = NULL;
+    AppState   = NULL;
+    inet.mNativeDNSResolver.Cancel(*this);
+
+#endif // INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     return INET_NO_ERROR;
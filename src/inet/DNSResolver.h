@@ -75,6 +75,9 @@ class DNSResolver : public InetLayerBasis
 {
 private:
     friend class InetLayer;
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    friend class DNSCache;
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
@@ -90,6 +93,10 @@ private:
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+    friend class NativeDNSResolverSockets;
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
     /**
      * @brief   Type of event handling function called when a DNS request completes.
      *
@@ -104,8 +111,6 @@ private:
      */
     typedef void (*OnResolveCompleteFunct)(void * appState, INET_ERROR err, uint8_t addrCount, IPAddress * addrArray);
 
-    static chip::System::ObjectPool<DNSResolver, INET_CONFIG_NUM_DNS_RESOLVERS> sPool;
-
     /**
      *  A pointer to the callback function when a DNS request is complete.
      */
@@ -131,6 +136,11 @@ private:
      */
     uint8_t DNSOptions;
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    /* The next lookup waiting for the same DNS cache entry. */
+    DNSResolver * pNextCacheWaiter;
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     void InitAddrInfoHints(struct addrinfo & hints);
@@ -44,5 +44,50 @@ void EndPointBasis::InitEndPointBasis(InetLayer & aInetLayer, void * aAppState)
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+static_assert(static_cast<int>(SocketEvents::kRead) == static_cast<int>(chip::System::SocketWatch::kRead) &&
+                  static_cast<int>(SocketEvents::kWrite) == static_cast<int>(chip::System::SocketWatch::kWrite) &&
+                  static_cast<int>(SocketEvents::kError) == static_cast<int>(chip::System::SocketWatch::kError),
+              "SocketEvents and SocketWatch events must match");
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+/**
+ *  Start delivering the I/O events of a newly opened socket to this endpoint. Has no effect with select(), where the sockets
+ *  of all endpoints are polled on every iteration of the event loop.
+ */
+void EndPointBasis::WatchSocket(void)
+{
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    SystemLayer().StartWatch(mSocketWatch, mSocket);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+
+/**
+ *  Stop delivering the I/O events of the socket to this endpoint. Must be called before the socket is closed.
+ */
+void EndPointBasis::UnwatchSocket(void)
+{
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    SystemLayer().StopWatch(mSocketWatch);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+
+/**
+ *  Notify the system layer that the I/O events this endpoint waits for may have changed, e.g. after a state change or a
+ *  callback assignment. With select(), this wakes the thread calling select so that it re-evaluates the endpoint.
+ */
+void EndPointBasis::RefreshSocketWatch(void)
+{
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    SystemLayer().RefreshWatch(mSocketWatch);
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+    SystemLayer().WakeSelect();
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 } // namespace Inet
 } // namespace chip
@@ -34,6 +34,11 @@
 #include <inet/InetLayerEvents.h>
 
 #include <support/DLLUtil.h>
+#include <system/SystemStats.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <system/SystemLayer.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 #include <Network/Network.h>
@@ -100,7 +105,22 @@ protected:
     int mSocket;             /**< Encapsulated socket descriptor. */
     IPAddressType mAddrType; /**< Protocol family, i.e. IPv4 or IPv6. */
     SocketEvents mPendingIO; /**< Socket event masks */
-#endif                       // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    chip::System::SocketWatch mSocketWatch; /**< Registration of mSocket with the epoll backend of the system layer. */
+
+    template <class EndPointType>
+    void InitSocketWatch(EndPointType & aEndPoint);
+    template <class EndPointType>
+    static uint8_t PrepareSocketWatch(chip::System::SocketWatch & aWatch, bool & aRecheck);
+    template <class EndPointType>
+    static void HandleSocketWatch(chip::System::SocketWatch & aWatch, uint8_t aEvents);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+    void WatchSocket(void);
+    void UnwatchSocket(void);
+    void RefreshSocketWatch(void);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     /** Encapsulated LwIP protocol control block */
@@ -136,7 +156,14 @@ protected:
     void DeferredFree(chip::System::Object::ReleaseDeferralErrorTactic aTactic);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    int mTrafficCounters; /**< First traffic counter of this type of endpoint, e.g. chip::System::Stats::kInetLayer_UDPPacketsSent. */
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
     void InitEndPointBasis(InetLayer & aInetLayer, void * aAppState = NULL);
+    void InitTrafficCounters(int aFirstCounter);
+    void CountSent(size_t aLength);
+    void CountReceived(size_t aLength);
 };
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -153,6 +180,68 @@ inline bool EndPointBasis::IsSocketsEndPoint(void) const
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+/**
+ *  Select the traffic counters of this endpoint, i.e. the four chip::System::Stats counters starting at @a aFirstCounter.
+ */
+inline void EndPointBasis::InitTrafficCounters(int aFirstCounter)
+{
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    mTrafficCounters = aFirstCounter;
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+
+/**
+ *  Count a packet of @a aLength bytes handed to the network stack.
+ */
+inline void EndPointBasis::CountSent(size_t aLength)
+{
+    SYSTEM_STATS_COUNT(mTrafficCounters + chip::System::Stats::kTraffic_PacketsSent);
+    SYSTEM_STATS_COUNT_N(mTrafficCounters + chip::System::Stats::kTraffic_BytesSent, aLength);
+}
+
+/**
+ *  Count a packet of @a aLength bytes received from the network stack.
+ */
+inline void EndPointBasis::CountReceived(size_t aLength)
+{
+    SYSTEM_STATS_COUNT(mTrafficCounters + chip::System::Stats::kTraffic_PacketsReceived);
+    SYSTEM_STATS_COUNT_N(mTrafficCounters + chip::System::Stats::kTraffic_BytesReceived, aLength);
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Associate the socket watch of this endpoint with the I/O handling of @a aEndPoint, i.e. its PrepareIO() and
+ *  HandlePendingIO() methods.
+ */
+template <class EndPointType>
+inline void EndPointBasis::InitSocketWatch(EndPointType & aEndPoint)
+{
+    mSocketWatch.Init(PrepareSocketWatch<EndPointType>, HandleSocketWatch<EndPointType>, &aEndPoint);
+}
+
+template <class EndPointType>
+uint8_t EndPointBasis::PrepareSocketWatch(chip::System::SocketWatch & aWatch, bool & aRecheck)
+{
+    EndPointType * lEndPoint   = static_cast<EndPointType *>(aWatch.GetOwner());
+    const SocketEvents lEvents = lEndPoint->PrepareIO();
+
+    // An open endpoint waiting for nothing is typically waiting for the application to assign a callback, which happens
+    // without notice; keep re-evaluating it until it waits for something.
+    aRecheck = !lEvents.IsSet();
+
+    return static_cast<uint8_t>(lEvents.Value);
+}
+
+template <class EndPointType>
+void EndPointBasis::HandleSocketWatch(chip::System::SocketWatch & aWatch, uint8_t aEvents)
+{
+    EndPointType * lEndPoint = static_cast<EndPointType *>(aWatch.GetOwner());
+
+    lEndPoint->mPendingIO.Value = aEvents;
+    lEndPoint->HandlePendingIO();
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 inline bool EndPointBasis::IsLWIPEndPoint(void) const
 {
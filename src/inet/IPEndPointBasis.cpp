@@ -29,6 +29,7 @@
 
 #include "IPEndPointBasis.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <inet/EndPointBasis.h>
@@ -102,6 +103,81 @@ union PeerSockAddr
     sockaddr_in in;
     sockaddr_in6 in6;
 };
+
+#if HAVE_RECVMMSG && INET_CONFIG_UDP_RECV_BATCH_SIZE > 1
+#define INET_USE_RECVMMSG 1
+typedef struct mmsghdr ReceiveMsgHeader;
+#else
+#define INET_USE_RECVMMSG 0
+struct ReceiveMsgHeader
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif // HAVE_RECVMMSG && INET_CONFIG_UDP_RECV_BATCH_SIZE > 1
+
+#if INET_USE_RECVMMSG
+/**
+ *  Number of datagrams read per recvmmsg() call. The buffers of a batch are allocated before the call, so when packet
+ *  buffers come from a fixed pool, a batch is limited to a quarter of the pool, leaving the rest to other users.
+ */
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+constexpr size_t kReceivePoolShare =
+    (CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC / 4 > 1) ? CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC / 4 : 1;
+constexpr size_t kReceiveBatchSize =
+    (INET_CONFIG_UDP_RECV_BATCH_SIZE < kReceivePoolShare) ? INET_CONFIG_UDP_RECV_BATCH_SIZE : kReceivePoolShare;
+#else  // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+constexpr size_t kReceiveBatchSize = INET_CONFIG_UDP_RECV_BATCH_SIZE;
+#endif // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+#else
+constexpr size_t kReceiveBatchSize = 1;
+#endif // INET_USE_RECVMMSG
+
+#if HAVE_SENDMMSG && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+#define INET_USE_SENDMMSG 1
+constexpr size_t kSendBatchSize = INET_CONFIG_UDP_SEND_BATCH_SIZE;
+#else
+#define INET_USE_SENDMMSG 0
+#endif // HAVE_SENDMMSG && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+
+/**
+ *  Maximum number of buffers in a chain sent as one datagram, each referenced by an iovec.
+ */
+constexpr size_t kMaxSendSegments = 16;
+
+/**
+ *  Per-datagram storage referenced by the msghdr built for a send.
+ */
+struct SendSlot
+{
+    PeerSockAddr peerSockAddr;
+    struct iovec iov[kMaxSendSegments];
+    size_t length; ///< total length of the datagram
+    uint8_t controlData[256];
+};
+
+#if INET_USE_SENDMMSG
+/**
+ *  Storage for building one sendmmsg() call; too large for the stack, so each endpoint allocates it on its first batched
+ *  send and keeps it until the endpoint is closed.
+ */
+struct SendBatch
+{
+    SendSlot slots[kSendBatchSize];
+    struct mmsghdr msgHeaders[kSendBatchSize];
+};
+#endif // INET_USE_SENDMMSG
+
+/**
+ *  Per-datagram storage referenced by a ReceiveMsgHeader.
+ */
+struct ReceiveSlot
+{
+    PacketBuffer * buffer;
+    struct iovec iov;
+    PeerSockAddr peerSockAddr;
+    uint8_t controlData[256];
+};
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -576,12 +652,15 @@ void IPEndPointBasis::Init(InetLayer * aInetLayer)
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     mBoundIntfId = INET_NULL_INTERFACEID;
+    mSendBatch   = NULL;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 void IPEndPointBasis::HandleDataReceived(PacketBuffer * aBuffer)
 {
+    CountReceived(aBuffer->TotalLength());
+
     if ((mState == kState_Listening) && (OnMessageReceived != NULL))
     {
         const IPPacketInfo * pktInfo = GetPacketInfo(aBuffer);
@@ -766,32 +845,42 @@ INET_ERROR IPEndPointBasis::BindInterface(IPAddressType aAddressType, InterfaceI
     return (lRetval);
 }
 
-INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBuffer * aBuffer, uint16_t aSendFlags)
+/**
+ *  Build the msghdr for sending \c aBuffer to the destination in \c aPktInfo
+ *  from an endpoint of type \c aAddrType, bound to \c aBoundIntfId. The header
+ *  points into \c aSlot, which must outlive it.
+ */
+static INET_ERROR PrepareSend(IPAddressType aAddrType, InterfaceId aBoundIntfId, const IPPacketInfo * aPktInfo,
+                              PacketBuffer * aBuffer, SendSlot & aSlot, struct msghdr & msgHeader)
 {
-    INET_ERROR res = INET_NO_ERROR;
-    PeerSockAddr peerSockAddr;
-    struct iovec msgIOV;
-    uint8_t controlData[256];
-    struct msghdr msgHeader;
-    InterfaceId intfId = aPktInfo->Interface;
+    INET_ERROR res              = INET_NO_ERROR;
+    PeerSockAddr & peerSockAddr = aSlot.peerSockAddr;
+    uint8_t * controlData       = aSlot.controlData;
+    InterfaceId intfId          = aPktInfo->Interface;
+    size_t numSegments          = 0;
 
     // Ensure the destination address type is compatible with the endpoint address type.
-    VerifyOrExit(mAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
-
-    // For now the entire message must fit within a single buffer.
-    VerifyOrExit(aBuffer->Next() == NULL, res = INET_ERROR_MESSAGE_TOO_LONG);
+    VerifyOrExit(aAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
 
     memset(&msgHeader, 0, sizeof(msgHeader));
 
-    msgIOV.iov_base      = aBuffer->Start();
-    msgIOV.iov_len       = aBuffer->DataLength();
-    msgHeader.msg_iov    = &msgIOV;
-    msgHeader.msg_iovlen = 1;
+    // A chain of buffers is gathered by the kernel, one iovec per buffer.
+    for (PacketBuffer * lBuffer = aBuffer; lBuffer != NULL; lBuffer = lBuffer->Next())
+    {
+        VerifyOrExit(numSegments < kMaxSendSegments, res = INET_ERROR_MESSAGE_TOO_LONG);
+
+        aSlot.iov[numSegments].iov_base = lBuffer->Start();
+        aSlot.iov[numSegments].iov_len  = lBuffer->DataLength();
+        numSegments++;
+    }
+    msgHeader.msg_iov    = aSlot.iov;
+    msgHeader.msg_iovlen = numSegments;
+    aSlot.length         = aBuffer->TotalLength();
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
     msgHeader.msg_name = &peerSockAddr;
-    if (mAddrType == kIPAddressType_IPv6)
+    if (aAddrType == kIPAddressType_IPv6)
     {
         peerSockAddr.in6.sin6_family   = AF_INET6;
         peerSockAddr.in6.sin6_port     = htons(aPktInfo->DestPort);
@@ -817,7 +906,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
     // don't seem to get sent out the correct interface, despite
     // the socket being bound.
     if (intfId == INET_NULL_INTERFACEID)
-        intfId = mBoundIntfId;
+        intfId = aBoundIntfId;
 
     // If the packet should be sent over a specific interface, or with a specific source
     // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
@@ -826,15 +915,15 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
     if (intfId != INET_NULL_INTERFACEID || aPktInfo->SrcAddress.Type() != kIPAddressType_Any)
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        memset(controlData, 0, sizeof(controlData));
+        memset(controlData, 0, sizeof(aSlot.controlData));
         msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_controllen = sizeof(aSlot.controlData);
 
         struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader);
 
 #if INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv4)
+        if (aAddrType == kIPAddressType_IPv4)
         {
 #if defined(IP_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IP;
@@ -853,7 +942,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
 
 #endif // INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv6)
+        if (aAddrType == kIPAddressType_IPv6)
         {
 #if defined(IPV6_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IPV6;
@@ -877,19 +966,135 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
 #endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
     }
 
+exit:
+    return (res);
+}
+
+INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBuffer * aBuffer, uint16_t aSendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+    SendSlot lSlot;
+    struct msghdr msgHeader;
+
+    res = PrepareSend(mAddrType, mBoundIntfId, aPktInfo, aBuffer, lSlot, msgHeader);
+    SuccessOrExit(res);
+
     // Send IP packet.
     {
         const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
         if (lenSent == -1)
             res = chip::System::MapErrorPOSIX(errno);
-        else if (lenSent != aBuffer->DataLength())
-            res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
+        else
+        {
+            CountSent(static_cast<size_t>(lenSent));
+            if (lenSent != aBuffer->TotalLength())
+                res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
+        }
     }
 
 exit:
     return (res);
 }
 
+/**
+ *  Send a batch of datagrams.
+ *
+ *  When sendmmsg() is available, up to INET_CONFIG_UDP_SEND_BATCH_SIZE
+ *  datagrams are submitted per system call. A datagram that cannot be sent
+ *  does not prevent the ones after it from being sent.
+ *
+ *  @return the error of the first datagram that could not be sent, or
+ *          INET_NO_ERROR if all of them were sent.
+ */
+INET_ERROR IPEndPointBasis::SendMsgBatch(const IPPacketBatchEntry * aEntries, size_t aCount, uint16_t aSendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+
+#if INET_USE_SENDMMSG
+    // Without the storage for a batch, the datagrams are sent one at a time.
+    if (mSendBatch == NULL)
+        mSendBatch = malloc(sizeof(SendBatch));
+
+    SendBatch * const lBatch = static_cast<SendBatch *>(mSendBatch);
+
+    if (lBatch != NULL)
+    {
+        SendSlot * const lSlots            = lBatch->slots;
+        struct mmsghdr * const lMsgHeaders = lBatch->msgHeaders;
+
+        while (aCount > 0)
+        {
+            size_t lNumConsumed = 0;
+            size_t lNumPrepared = 0;
+            size_t lNumSent     = 0;
+
+            // Build the next batch, skipping datagrams that cannot be sent on this endpoint.
+            while (lNumConsumed < aCount && lNumPrepared < kSendBatchSize)
+            {
+                const IPPacketBatchEntry & lEntry = aEntries[lNumConsumed++];
+                INET_ERROR lErr = PrepareSend(mAddrType, mBoundIntfId, lEntry.PktInfo, lEntry.Buffer, lSlots[lNumPrepared],
+                                              lMsgHeaders[lNumPrepared].msg_hdr);
+
+                if (lErr != INET_NO_ERROR)
+                {
+                    if (res == INET_NO_ERROR)
+                        res = lErr;
+                    continue;
+                }
+
+                lMsgHeaders[lNumPrepared].msg_len = 0;
+                lNumPrepared++;
+            }
+
+            // sendmmsg() stops at the first datagram that fails; report it, skip it and carry on with the rest.
+            while (lNumSent < lNumPrepared)
+            {
+                const int lResult = sendmmsg(mSocket, &lMsgHeaders[lNumSent], lNumPrepared - lNumSent, 0);
+
+                if (lResult < 0)
+                {
+                    if (res == INET_NO_ERROR)
+                        res = chip::System::MapErrorPOSIX(errno);
+                    lNumSent++;
+                    continue;
+                }
+
+                for (int i = 0; i < lResult; i++, lNumSent++)
+                {
+                    CountSent(lMsgHeaders[lNumSent].msg_len);
+                    if (lMsgHeaders[lNumSent].msg_len != lSlots[lNumSent].length && res == INET_NO_ERROR)
+                        res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
+                }
+            }
+
+            aEntries += lNumConsumed;
+            aCount -= lNumConsumed;
+        }
+
+        return res;
+    }
+#endif // INET_USE_SENDMMSG
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        INET_ERROR lErr = SendMsg(aEntries[i].PktInfo, aEntries[i].Buffer, aSendFlags);
+
+        if (res == INET_NO_ERROR)
+            res = lErr;
+    }
+
+    return res;
+}
+
+/**
+ *  Free the storage kept by SendMsgBatch(), if any. Called when the endpoint is closed.
+ */
+void IPEndPointBasis::ReleaseSendBatch(void)
+{
+    free(mSendBatch);
+    mSendBatch = NULL;
+}
+
 INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int aProtocol)
 {
     INET_ERROR res = INET_NO_ERROR;
@@ -993,6 +1198,8 @@ INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int
             }
         }
 #endif // defined(SO_NOSIGPIPE)
+
+        WatchSocket();
     }
     else if (mAddrType != aAddressType)
     {
@@ -1012,113 +1219,174 @@ SocketEvents IPEndPointBasis::PrepareIO(void)
     return res;
 }
 
-void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
+static void PrepareReceive(ReceiveSlot & aSlot, struct msghdr & aMsgHeader)
 {
-    INET_ERROR lStatus = INET_NO_ERROR;
-    IPPacketInfo lPacketInfo;
-    PacketBuffer * lBuffer;
+    aSlot.iov.iov_base = aSlot.buffer->Start();
+    aSlot.iov.iov_len  = aSlot.buffer->AvailableDataLength();
 
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort = aPort;
-
-    lBuffer = PacketBuffer::New(0);
-
-    if (lBuffer != NULL)
-    {
-        struct iovec msgIOV;
-        PeerSockAddr lPeerSockAddr;
-        uint8_t controlData[256];
-        struct msghdr msgHeader;
+    memset(&aSlot.peerSockAddr, 0, sizeof(aSlot.peerSockAddr));
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
+    memset(&aMsgHeader, 0, sizeof(aMsgHeader));
 
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
-
-        memset(&msgHeader, 0, sizeof(msgHeader));
+    aMsgHeader.msg_name       = &aSlot.peerSockAddr;
+    aMsgHeader.msg_namelen    = sizeof(aSlot.peerSockAddr);
+    aMsgHeader.msg_iov        = &aSlot.iov;
+    aMsgHeader.msg_iovlen     = 1;
+    aMsgHeader.msg_control    = aSlot.controlData;
+    aMsgHeader.msg_controllen = sizeof(aSlot.controlData);
+}
 
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+static INET_ERROR ParseReceivedMessage(ReceiveSlot & aSlot, struct msghdr & aMsgHeader, size_t aLength, IPPacketInfo & aPacketInfo)
+{
+    const PeerSockAddr & lPeerSockAddr = aSlot.peerSockAddr;
 
-        ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+    if ((aMsgHeader.msg_flags & MSG_TRUNC) != 0 || aLength > aSlot.buffer->AvailableDataLength())
+    {
+        return INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
+    }
 
-        if (rcvLen < 0)
-        {
-            lStatus = chip::System::MapErrorPOSIX(errno);
-        }
-        else if (rcvLen > lBuffer->AvailableDataLength())
-        {
-            lStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
-        else
-        {
-            lBuffer->SetDataLength((uint16_t) rcvLen);
+    aSlot.buffer->SetDataLength((uint16_t) aLength);
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
+    if (lPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
+        aPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
+    }
 #if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
+    else if (lPeerSockAddr.any.sa_family == AF_INET)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
+        aPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
+    }
 #endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = INET_ERROR_INCORRECT_STATE;
-            }
-        }
+    else
+    {
+        return INET_ERROR_INCORRECT_STATE;
+    }
 
-        if (lStatus == INET_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != NULL;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&aMsgHeader); controlHdr != NULL;
+         controlHdr                  = CMSG_NXTHDR(&aMsgHeader, controlHdr))
+    {
 #if INET_CONFIG_ENABLE_IPV4
 #ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    struct in_pktinfo * inPktInfo = (struct in_pktinfo *) CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface         = inPktInfo->ipi_ifindex;
-                    lPacketInfo.DestAddress       = IPAddress::FromIPv4(inPktInfo->ipi_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo * inPktInfo = (struct in_pktinfo *) CMSG_DATA(controlHdr);
+            aPacketInfo.Interface         = inPktInfo->ipi_ifindex;
+            aPacketInfo.DestAddress       = IPAddress::FromIPv4(inPktInfo->ipi_addr);
+            continue;
+        }
 #endif // defined(IP_PKTINFO)
 #endif // INET_CONFIG_ENABLE_IPV4
 
 #ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    struct in6_pktinfo * in6PktInfo = (struct in6_pktinfo *) CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface           = in6PktInfo->ipi6_ifindex;
-                    lPacketInfo.DestAddress         = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            struct in6_pktinfo * in6PktInfo = (struct in6_pktinfo *) CMSG_DATA(controlHdr);
+            aPacketInfo.Interface           = in6PktInfo->ipi6_ifindex;
+            aPacketInfo.DestAddress         = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
+            continue;
+        }
 #endif // defined(IPV6_PKTINFO)
-            }
+    }
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  Read the datagrams pending on the socket and deliver them to
+ *  OnMessageReceived.
+ *
+ *  When recvmmsg() is available, up to INET_CONFIG_UDP_RECV_BATCH_SIZE
+ *  datagrams are read with a single system call and delivered in one pass.
+ */
+void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
+{
+    INET_ERROR lStatus = INET_NO_ERROR;
+    ReceiveSlot lSlots[kReceiveBatchSize];
+    ReceiveMsgHeader lMsgHeaders[kReceiveBatchSize];
+    size_t lNumSlots = 0;
+    int lNumReceived = 0;
+
+    for (lNumSlots = 0; lNumSlots < kReceiveBatchSize; lNumSlots++)
+    {
+        lSlots[lNumSlots].buffer = PacketBuffer::New(0);
+        if (lSlots[lNumSlots].buffer == NULL)
+            break;
+
+        PrepareReceive(lSlots[lNumSlots], lMsgHeaders[lNumSlots].msg_hdr);
+    }
+
+    VerifyOrExit(lNumSlots > 0, lStatus = INET_ERROR_NO_MEMORY);
+
+#if INET_USE_RECVMMSG
+    lNumReceived = recvmmsg(mSocket, lMsgHeaders, lNumSlots, MSG_DONTWAIT, NULL);
+#else  // !INET_USE_RECVMMSG
+    {
+        ssize_t rcvLen = recvmsg(mSocket, &lMsgHeaders[0].msg_hdr, MSG_DONTWAIT);
+
+        if (rcvLen >= 0)
+        {
+            lMsgHeaders[0].msg_len = (unsigned int) rcvLen;
+            lNumReceived           = 1;
+        }
+        else
+        {
+            lNumReceived = -1;
         }
     }
-    else
+#endif // !INET_USE_RECVMMSG
+
+    VerifyOrExit(lNumReceived >= 0, lStatus = chip::System::MapErrorPOSIX(errno));
+
+    // A handler may close or free this endpoint; hold a reference until every
+    // received datagram has been dealt with.
+    Retain();
+
+    for (int i = 0; i < lNumReceived; i++)
     {
-        lStatus = INET_ERROR_NO_MEMORY;
+        IPPacketInfo lPacketInfo;
+        PacketBuffer * lBuffer = lSlots[i].buffer;
+        INET_ERROR lMsgStatus;
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort = aPort;
+
+        CountReceived(lMsgHeaders[i].msg_len);
+        lMsgStatus = ParseReceivedMessage(lSlots[i], lMsgHeaders[i].msg_hdr, lMsgHeaders[i].msg_len, lPacketInfo);
+
+        lSlots[i].buffer = NULL;
+
+        if (mState != kState_Listening || OnMessageReceived == NULL)
+        {
+            PacketBuffer::Free(lBuffer);
+        }
+        else if (lMsgStatus == INET_NO_ERROR)
+        {
+            OnMessageReceived(this, lBuffer, &lPacketInfo);
+        }
+        else
+        {
+            PacketBuffer::Free(lBuffer);
+            if (OnReceiveError != NULL)
+                OnReceiveError(this, lMsgStatus, NULL);
+        }
     }
 
-    if (lStatus == INET_NO_ERROR)
-        OnMessageReceived(this, lBuffer, &lPacketInfo);
-    else
+    Release();
+
+exit:
+    for (size_t i = 0; i < lNumSlots; i++)
     {
-        PacketBuffer::Free(lBuffer);
-        if (OnReceiveError != NULL && lStatus != chip::System::MapErrorPOSIX(EAGAIN))
-            OnReceiveError(this, lStatus, NULL);
+        if (lSlots[i].buffer != NULL)
+        {
+            PacketBuffer::Free(lSlots[i].buffer);
+        }
     }
 
+    if (lStatus != INET_NO_ERROR && OnReceiveError != NULL && lStatus != chip::System::MapErrorPOSIX(EAGAIN))
+        OnReceiveError(this, lStatus, NULL);
+
     return;
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
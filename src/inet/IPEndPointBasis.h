@@ -42,6 +42,17 @@ namespace Inet {
 class InetLayer;
 class IPPacketInfo;
 
+/**
+ * @struct IPPacketBatchEntry
+ *
+ * @brief One datagram of a batch passed to UDPEndPoint::SendMsgBatch.
+ */
+struct IPPacketBatchEntry
+{
+    const IPPacketInfo * PktInfo;        /**< Destination, and optionally source and interface, of the datagram. */
+    chip::System::PacketBuffer * Buffer; /**< The datagram to send. */
+};
+
 /**
  * @class IPEndPointBasis
  *
@@ -142,10 +153,13 @@ protected:
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 protected:
     InterfaceId mBoundIntfId;
+    void * mSendBatch; ///< storage for SendMsgBatch(), allocated on the first batched send and freed by ReleaseSendBatch()
 
     INET_ERROR Bind(IPAddressType aAddressType, IPAddress aAddress, uint16_t aPort, InterfaceId aInterfaceId);
     INET_ERROR BindInterface(IPAddressType aAddressType, InterfaceId aInterfaceId);
     INET_ERROR SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBuffer * aBuffer, uint16_t aSendFlags);
+    INET_ERROR SendMsgBatch(const IPPacketBatchEntry * aEntries, size_t aCount, uint16_t aSendFlags);
+    void ReleaseSendBatch(void);
     INET_ERROR GetSocket(IPAddressType aAddressType, int aType, int aProtocol);
     SocketEvents PrepareIO(void);
     void HandlePendingIO(uint16_t aPort);
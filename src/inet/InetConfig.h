@@ -416,15 +416,39 @@
 #define INET_CONFIG_TUNNEL_DEVICE_NAME                      "/dev/net/tun"
 #endif //INET_CONFIG_TUNNEL_DEVICE_NAME
 
+/**
+ *  @def INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+ *
+ *  @brief
+ *    Resolve host names on sockets with the DNS client of InetLayer, which
+ *    queries the name servers over UDP endpoints from the event loop,
+ *    instead of calling getaddrinfo() on threads.
+ *
+ *  @note
+ *    The client neither consults /etc/hosts nor applies search domains:
+ *    names other than "localhost" are looked up as given.
+ */
+#ifndef INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+#define INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS              0
+#endif // INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
 /**
  * @def INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
  *
  * @brief Enable asynchronous dns name resolution for Linux sockets.
  */
 #ifndef INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+#define INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS               0
+#else
 #define INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS               1
+#endif
 #endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
+#if INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#error "INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS and INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS are mutually exclusive"
+#endif
+
 /**
  * @def INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT
  *
@@ -435,6 +459,129 @@
 #define INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT             2
 #endif // INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT
 
+/**
+ *  @def INET_CONFIG_NATIVE_DNS_RESOLV_CONF_PATH
+ *
+ *  @brief
+ *    The file the native DNS client reads its name servers and options
+ *    from, in the format of resolv.conf(5).
+ */
+#ifndef INET_CONFIG_NATIVE_DNS_RESOLV_CONF_PATH
+#define INET_CONFIG_NATIVE_DNS_RESOLV_CONF_PATH            "/etc/resolv.conf"
+#endif // INET_CONFIG_NATIVE_DNS_RESOLV_CONF_PATH
+
+/**
+ *  @def INET_CONFIG_NATIVE_DNS_RANDOM_DEVICE
+ *
+ *  @brief
+ *    The device the native DNS client reads the IDs of its queries from,
+ *    which must provide cryptographically strong random data.
+ */
+#ifndef INET_CONFIG_NATIVE_DNS_RANDOM_DEVICE
+#define INET_CONFIG_NATIVE_DNS_RANDOM_DEVICE               "/dev/urandom"
+#endif // INET_CONFIG_NATIVE_DNS_RANDOM_DEVICE
+
+/**
+ *  @def INET_CONFIG_NATIVE_DNS_MAX_SERVERS
+ *
+ *  @brief
+ *    The maximum number of name servers the native DNS client queries, in
+ *    turn; further "nameserver" lines of resolv.conf are ignored.
+ */
+#ifndef INET_CONFIG_NATIVE_DNS_MAX_SERVERS
+#define INET_CONFIG_NATIVE_DNS_MAX_SERVERS                 3
+#endif // INET_CONFIG_NATIVE_DNS_MAX_SERVERS
+
+/**
+ *  @def INET_CONFIG_NATIVE_DNS_TIMEOUT_MS
+ *
+ *  @brief
+ *    How long, in milliseconds, the native DNS client waits for a name
+ *    server to answer before asking the next one, unless resolv.conf
+ *    sets "options timeout:".
+ */
+#ifndef INET_CONFIG_NATIVE_DNS_TIMEOUT_MS
+#define INET_CONFIG_NATIVE_DNS_TIMEOUT_MS                  5000
+#endif // INET_CONFIG_NATIVE_DNS_TIMEOUT_MS
+
+/**
+ *  @def INET_CONFIG_NATIVE_DNS_ATTEMPTS
+ *
+ *  @brief
+ *    How many times the native DNS client asks each name server before
+ *    giving up, unless resolv.conf sets "options attempts:".
+ */
+#ifndef INET_CONFIG_NATIVE_DNS_ATTEMPTS
+#define INET_CONFIG_NATIVE_DNS_ATTEMPTS                    2
+#endif // INET_CONFIG_NATIVE_DNS_ATTEMPTS
+
+/**
+ *  @def INET_CONFIG_DNS_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of host name lookups whose results InetLayer keeps,
+ *    or 0 to resolve every name afresh.
+ *
+ *  @details
+ *    Concurrent lookups of a name also share a single request to the
+ *    resolver. Each such request takes a DNS resolver context of its
+ *    own, on top of those of the lookups waiting for it.
+ *
+ *    LwIP keeps a cache of its own, so the cache is only enabled by
+ *    default on platforms using sockets.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_SIZE
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#define INET_CONFIG_DNS_CACHE_SIZE                         8
+#else
+#define INET_CONFIG_DNS_CACHE_SIZE                         0
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#endif // INET_CONFIG_DNS_CACHE_SIZE
+
+/**
+ *  @def INET_CONFIG_DNS_CACHE_MAX_ADDRS
+ *
+ *  @brief
+ *    The number of addresses each entry of the DNS cache holds.
+ *
+ *  @details
+ *    Lookups asking for more addresses bypass the cache.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_MAX_ADDRS
+#define INET_CONFIG_DNS_CACHE_MAX_ADDRS                    4
+#endif // INET_CONFIG_DNS_CACHE_MAX_ADDRS
+
+/**
+ *  @def INET_CONFIG_DNS_CACHE_POSITIVE_TTL_MS
+ *
+ *  @brief
+ *    How long, in milliseconds, the DNS cache keeps the addresses
+ *    of a host name.
+ *
+ *  @details
+ *    getaddrinfo() does not report the TTLs of the records it used,
+ *    so the cache applies this one to all of them.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_POSITIVE_TTL_MS
+#define INET_CONFIG_DNS_CACHE_POSITIVE_TTL_MS              60000
+#endif // INET_CONFIG_DNS_CACHE_POSITIVE_TTL_MS
+
+/**
+ *  @def INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS
+ *
+ *  @brief
+ *    How long, in milliseconds, the DNS cache keeps the failure to
+ *    resolve a host name.
+ *
+ *  @details
+ *    Only INET_ERROR_HOST_NOT_FOUND and INET_ERROR_DNS_TRY_AGAIN are
+ *    kept; other failures are reported to the lookups waiting for
+ *    them, then forgotten.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS
+#define INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS              5000
+#endif // INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS
+
 /**
  *  @def INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
  *
@@ -543,6 +690,113 @@
 #ifndef INET_CONFIG_IP_MULTICAST_HOP_LIMIT
 #define INET_CONFIG_IP_MULTICAST_HOP_LIMIT                 (64)
 #endif // INET_CONFIG_IP_MULTICAST_HOP_LIMIT
+
+/**
+ *  @def INET_CONFIG_UDP_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams read from a UDP or raw socket
+ *    each time it is reported readable.
+ *
+ *  @details
+ *    On platforms providing recvmmsg(), this many packet buffers are
+ *    allocated up front and the socket is drained with a single system
+ *    call, and every datagram received is delivered before returning to
+ *    the event loop. With a fixed pool of packet buffers, a batch uses at
+ *    most a quarter of #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC buffers.
+ *    A value of 1 disables batching, and one datagram is read with
+ *    recvmsg() per event loop iteration.
+ */
+#ifndef INET_CONFIG_UDP_RECV_BATCH_SIZE
+#define INET_CONFIG_UDP_RECV_BATCH_SIZE                    8
+#endif // INET_CONFIG_UDP_RECV_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_UDP_SEND_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams submitted to the network stack
+ *    with a single system call by UDPEndPoint::SendMsgBatch.
+ *
+ *  @details
+ *    On platforms providing sendmmsg(), larger batches are split into
+ *    chunks of this size. A value of 1 disables batching, and each
+ *    datagram is sent with its own sendmsg() call.
+ */
+#ifndef INET_CONFIG_UDP_SEND_BATCH_SIZE
+#define INET_CONFIG_UDP_SEND_BATCH_SIZE                    16
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_TCP_SEND_IOV_MAX
+ *
+ *  @brief
+ *    The maximum number of buffers of the send queue of a TCP socket
+ *    written with a single system call.
+ *
+ *  @details
+ *    On platforms using sockets, TCPEndPoint gathers this many buffers
+ *    of its send queue into one sendmsg() call, so that a queue of many
+ *    small messages does not cost one system call each.
+ */
+#ifndef INET_CONFIG_TCP_SEND_IOV_MAX
+#define INET_CONFIG_TCP_SEND_IOV_MAX                       64
+#endif // INET_CONFIG_TCP_SEND_IOV_MAX
+
+/**
+ *  @def INET_CONFIG_TCP_RECV_BUDGET
+ *
+ *  @brief
+ *    The number of bytes a TCP socket reads, at most, each time it
+ *    becomes readable.
+ *
+ *  @details
+ *    On platforms using sockets, TCPEndPoint allocates enough buffers
+ *    to receive the data waiting on the socket, up to this many bytes,
+ *    and fills them with a single readv() call, handing a chain of
+ *    buffers to the application. Buffers that receive nothing are
+ *    freed right away.
+ *
+ *    The free space of the last buffer of the receive queue is always
+ *    read into, so a value of 0 reads at most one buffer per event.
+ *    This is the default when the buffer pool is of fixed size, since
+ *    a single connection could otherwise exhaust it.
+ */
+#ifndef INET_CONFIG_TCP_RECV_BUDGET
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#define INET_CONFIG_TCP_RECV_BUDGET                        16384
+#else
+#define INET_CONFIG_TCP_RECV_BUDGET                        0
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#endif // INET_CONFIG_TCP_RECV_BUDGET
+
+/**
+ *  @def INET_CONFIG_ENABLE_INTERFACE_TABLE
+ *
+ *  @brief
+ *    Keep a snapshot of the network interfaces and their addresses,
+ *    and have InterfaceIterator and InterfaceAddressIterator read from
+ *    it rather than query the system each time they start.
+ *
+ *  @details
+ *    While an InetLayer is initialized, a netlink socket watched by
+ *    its event loop reports link and address changes, upon which the
+ *    snapshot is dropped, and taken again by the next iteration.
+ *    Without InetLayer, every iteration takes a snapshot of its own.
+ *
+ *    Only available on Linux with sockets.
+ */
+#ifndef INET_CONFIG_ENABLE_INTERFACE_TABLE
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__) && !defined(__ANDROID__)
+#define INET_CONFIG_ENABLE_INTERFACE_TABLE                 1
+#else
+#define INET_CONFIG_ENABLE_INTERFACE_TABLE                 0
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__) && !defined(__ANDROID__)
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+#error "INET_CONFIG_ENABLE_INTERFACE_TABLE requires CHIP_SYSTEM_CONFIG_USE_SOCKETS on Linux"
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
 // clang-format on
 
 #endif /* INETCONFIG_H */
@@ -31,6 +31,7 @@
 
 #include "InetLayer.h"
 #include "InetLayerEvents.h"
+#include "InterfaceTable.h"
 
 #include <support/CodeUtils.h>
 #include <support/DLLUtil.h>
@@ -226,10 +227,15 @@ void CloseIOCTLSocket(void)
 
 InterfaceIterator::InterfaceIterator(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    mTable   = NULL;
+    mCurIntf = 0;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     mIntfArray       = NULL;
     mCurIntf         = 0;
     mIntfFlags       = 0;
     mIntfFlagsCached = 0;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -247,11 +253,19 @@ InterfaceIterator::InterfaceIterator(void)
 
 InterfaceIterator::~InterfaceIterator(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    if (mTable != NULL)
+    {
+        InterfaceTable::Release(mTable);
+        mTable = NULL;
+    }
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     if (mIntfArray != NULL)
     {
         if_freenameindex(mIntfArray);
         mIntfArray = NULL;
     }
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -269,7 +283,11 @@ InterfaceIterator::~InterfaceIterator(void)
 
 bool InterfaceIterator::HasCurrent(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    return (mTable != NULL) ? mCurIntf < mTable->mNumInterfaces : Next();
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     return (mIntfArray != NULL) ? mIntfArray[mCurIntf].if_index != 0 : Next();
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -298,6 +316,18 @@ bool InterfaceIterator::Next(void)
 {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    if (mTable == NULL)
+    {
+        mTable   = InterfaceTable::Acquire();
+        mCurIntf = 0;
+    }
+    else if (mCurIntf < mTable->mNumInterfaces)
+    {
+        mCurIntf++;
+    }
+    return (mTable != NULL && mCurIntf < mTable->mNumInterfaces);
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     if (mIntfArray == NULL)
     {
         mIntfArray = if_nameindex();
@@ -309,6 +339,7 @@ bool InterfaceIterator::Next(void)
         mIntfFlagsCached = false;
     }
     return (mIntfArray != NULL && mIntfArray[mCurIntf].if_index != 0);
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -354,7 +385,11 @@ bool InterfaceIterator::Next(void)
 
 InterfaceId InterfaceIterator::GetInterfaceId(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    return (HasCurrent()) ? mTable->mInterfaces[mCurIntf].id : INET_NULL_INTERFACEID;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     return (HasCurrent()) ? mIntfArray[mCurIntf].if_index : INET_NULL_INTERFACEID;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -383,9 +418,17 @@ INET_ERROR InterfaceIterator::GetInterfaceName(char * nameBuf, size_t nameBufSiz
     VerifyOrExit(HasCurrent(), err = INET_ERROR_INCORRECT_STATE);
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    VerifyOrExit(strlen(mIntfArray[mCurIntf].if_name) < nameBufSize, err = INET_ERROR_NO_MEMORY);
-    strncpy(nameBuf, mIntfArray[mCurIntf].if_name, nameBufSize);
-    err = INET_NO_ERROR;
+    {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+        const char * intfName = mTable->mInterfaces[mCurIntf].name;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+        const char * intfName = mIntfArray[mCurIntf].if_name;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+        VerifyOrExit(strlen(intfName) < nameBufSize, err = INET_ERROR_NO_MEMORY);
+        strncpy(nameBuf, intfName, nameBufSize);
+        err = INET_NO_ERROR;
+    }
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -462,6 +505,9 @@ bool InterfaceIterator::HasBroadcastAddress(void)
 
 short InterfaceIterator::GetFlags(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    return (HasCurrent()) ? static_cast<short>(mTable->mInterfaces[mCurIntf].flags) : 0;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     struct ifreq intfData;
 
     if (!mIntfFlagsCached && HasCurrent())
@@ -478,6 +524,7 @@ short InterfaceIterator::GetFlags(void)
     }
 
     return mIntfFlags;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -496,8 +543,13 @@ short InterfaceIterator::GetFlags(void)
 
 InterfaceAddressIterator::InterfaceAddressIterator(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    mTable   = NULL;
+    mCurAddr = 0;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     mAddrsList = NULL;
     mCurAddr   = NULL;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -515,11 +567,19 @@ InterfaceAddressIterator::InterfaceAddressIterator(void)
 
 InterfaceAddressIterator::~InterfaceAddressIterator(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    if (mTable != NULL)
+    {
+        InterfaceTable::Release(mTable);
+        mTable = NULL;
+    }
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     if (mAddrsList != NULL)
     {
         freeifaddrs(mAddrsList);
         mAddrsList = mCurAddr = NULL;
     }
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -536,7 +596,11 @@ bool InterfaceAddressIterator::HasCurrent(void)
 {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    return (mTable != NULL) ? (mCurAddr < mTable->mNumAddresses) : Next();
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     return (mAddrsList != NULL) ? (mCurAddr != NULL) : Next();
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
@@ -567,6 +631,18 @@ bool InterfaceAddressIterator::Next(void)
 {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    if (mTable == NULL)
+    {
+        mTable   = InterfaceTable::Acquire();
+        mCurAddr = 0;
+    }
+    else if (mCurAddr < mTable->mNumAddresses)
+    {
+        mCurAddr++;
+    }
+    return (mTable != NULL && mCurAddr < mTable->mNumAddresses);
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     while (true)
     {
         if (mAddrsList == NULL)
@@ -598,6 +674,7 @@ bool InterfaceAddressIterator::Next(void)
             return true;
         }
     }
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -650,7 +727,11 @@ IPAddress InterfaceAddressIterator::GetAddress(void)
     if (HasCurrent())
     {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+        return mTable->mAddresses[mCurAddr].addr;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
         return IPAddress::FromSockAddr(*mCurAddr->ifa_addr);
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -694,6 +775,9 @@ uint8_t InterfaceAddressIterator::GetPrefixLength(void)
     if (HasCurrent())
     {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+        return mTable->mAddresses[mCurAddr].prefixLen;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
         if (mCurAddr->ifa_addr->sa_family == AF_INET6)
         {
             struct sockaddr_in6 & netmask = *(struct sockaddr_in6 *) (mCurAddr->ifa_netmask);
@@ -704,6 +788,7 @@ uint8_t InterfaceAddressIterator::GetPrefixLength(void)
             struct sockaddr_in & netmask = *(struct sockaddr_in *) (mCurAddr->ifa_netmask);
             return NetmaskToPrefixLength((const uint8_t *) &netmask.sin_addr.s_addr, 4);
         }
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -737,7 +822,11 @@ InterfaceId InterfaceAddressIterator::GetInterfaceId(void)
     if (HasCurrent())
     {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+        return mTable->mAddresses[mCurAddr].intfId;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
         return if_nametoindex(mCurAddr->ifa_name);
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -774,9 +863,17 @@ INET_ERROR InterfaceAddressIterator::GetInterfaceName(char * nameBuf, size_t nam
     VerifyOrExit(HasCurrent(), err = INET_ERROR_INCORRECT_STATE);
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    VerifyOrExit(strlen(mCurAddr->ifa_name) < nameBufSize, err = INET_ERROR_NO_MEMORY);
-    strncpy(nameBuf, mCurAddr->ifa_name, nameBufSize);
-    err = INET_NO_ERROR;
+    {
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+        const char * intfName = mTable->mAddresses[mCurAddr].name;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+        const char * intfName = mCurAddr->ifa_name;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+        VerifyOrExit(strlen(intfName) < nameBufSize, err = INET_ERROR_NO_MEMORY);
+        strncpy(nameBuf, intfName, nameBufSize);
+        err = INET_NO_ERROR;
+    }
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -801,7 +898,7 @@ bool InterfaceAddressIterator::IsUp(void)
     if (HasCurrent())
     {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-        return (mCurAddr->ifa_flags & IFF_UP) != 0;
+        return (GetFlags() & IFF_UP) != 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -825,7 +922,7 @@ bool InterfaceAddressIterator::SupportsMulticast(void)
     if (HasCurrent())
     {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-        return (mCurAddr->ifa_flags & IFF_MULTICAST) != 0;
+        return (GetFlags() & IFF_MULTICAST) != 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -849,7 +946,7 @@ bool InterfaceAddressIterator::HasBroadcastAddress(void)
     if (HasCurrent())
     {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-        return (mCurAddr->ifa_flags & IFF_BROADCAST) != 0;
+        return (GetFlags() & IFF_BROADCAST) != 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -859,6 +956,28 @@ bool InterfaceAddressIterator::HasBroadcastAddress(void)
     return false;
 }
 
+/**
+ * @fn      unsigned int InterfaceAddressIterator::GetFlags(void)
+ *
+ * @brief   Returns the ifa_flags value for the current interface address.
+ *
+ * @details
+ *     The iterator must be positioned on an interface address.
+ */
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+unsigned int InterfaceAddressIterator::GetFlags(void)
+{
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    return mTable->mAddresses[mCurAddr].flags;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+    return mCurAddr->ifa_flags;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 /**
  * @fn       void InterfaceAddressIterator::GetAddressWithPrefix(IPPrefix & addrWithPrefix)
  *
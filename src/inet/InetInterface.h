@@ -35,10 +35,10 @@
 #include <lwip/netif.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+#if (CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK) && !INET_CONFIG_ENABLE_INTERFACE_TABLE
 struct if_nameindex;
 struct ifaddrs;
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+#endif // (CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK) && !INET_CONFIG_ENABLE_INTERFACE_TABLE
 
 #include <stddef.h>
 #include <stdint.h>
@@ -48,6 +48,9 @@ namespace Inet {
 
 class IPAddress;
 class IPPrefix;
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+class InterfaceTable;
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
 
 /**
  * @typedef     InterfaceId
@@ -120,7 +123,9 @@ extern uint8_t NetmaskToPrefixLength(const uint8_t * netmask, uint16_t netmaskLe
  *  themselves are never destroyed.
  *
  *  On sockets-based systems, iteration is always stable in the face of changes
- *  to the underlying system's interfaces.
+ *  to the underlying system's interfaces. With
+ *  #INET_CONFIG_ENABLE_INTERFACE_TABLE, iteration reads a snapshot of the
+ *  interfaces shared with other iterators, rather than query the system.
  *
  *  On LwIP systems, iteration is stable except in the case where the currently
  *  selected interface is removed from the list, in which case iteration ends
@@ -147,10 +152,15 @@ protected:
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    const InterfaceTable * mTable;
+    size_t mCurIntf;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     struct if_nameindex * mIntfArray;
     size_t mCurIntf;
     short mIntfFlags;
     bool mIntfFlagsCached;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
 
     short GetFlags(void);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -172,7 +182,9 @@ protected:
  *  themselves are never destroyed.
  *
  *  On sockets-based systems, iteration is always stable in the face of changes
- *  to the underlying system's interfaces and/or addresses.
+ *  to the underlying system's interfaces and/or addresses. With
+ *  #INET_CONFIG_ENABLE_INTERFACE_TABLE, iteration reads a snapshot of the
+ *  addresses shared with other iterators, rather than query the system.
  *
  *  On LwIP systems, iteration is stable except in the case where the interface
  *  associated with the current address is removed, in which case iteration may
@@ -209,8 +221,15 @@ private:
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    const InterfaceTable * mTable;
+    size_t mCurAddr;
+#else  // !INET_CONFIG_ENABLE_INTERFACE_TABLE
     struct ifaddrs * mAddrsList;
     struct ifaddrs * mCurAddr;
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+    unsigned int GetFlags(void);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 };
 
@@ -47,6 +47,7 @@
 #include "InetLayer.h"
 
 #include "InetFaultInjection.h"
+#include "InterfaceTable.h"
 
 #include <system/SystemTimer.h>
 
@@ -75,27 +76,32 @@
 namespace chip {
 namespace Inet {
 
+/**
+ *  Fill in the statistics of the resources allocated from the pools of this InetLayer, i.e. its endpoints and DNS resolvers.
+ *
+ *  @param[out] aSnapshot   The snapshot to update.
+ */
 void InetLayer::UpdateSnapshot(chip::System::Stats::Snapshot & aSnapshot)
 {
 #if INET_CONFIG_ENABLE_DNS_RESOLVER
-    DNSResolver::sPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumDNSResolvers],
-                                     aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumDNSResolvers]);
+    mDNSResolverPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumDNSResolvers],
+                                   aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumDNSResolvers]);
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-    TCPEndPoint::sPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumTCPEps],
-                                     aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumTCPEps]);
+    mTCPEndPointPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumTCPEps],
+                                   aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumTCPEps]);
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 #if INET_CONFIG_ENABLE_UDP_ENDPOINT
-    UDPEndPoint::sPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumUDPEps],
-                                     aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumUDPEps]);
+    mUDPEndPointPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumUDPEps],
+                                   aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumUDPEps]);
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
-    RawEndPoint::sPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumRawEps],
-                                     aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumRawEps]);
+    mRawEndPointPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumRawEps],
+                                   aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumRawEps]);
 #endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
 #if INET_CONFIG_ENABLE_TUN_ENDPOINT
-    TunEndPoint::sPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumTunEps],
-                                     aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumTunEps]);
+    mTunEndPointPool.GetStatistics(aSnapshot.mResourcesInUse[chip::System::Stats::kInetLayer_NumTunEps],
+                                   aSnapshot.mHighWatermarks[chip::System::Stats::kInetLayer_NumTunEps]);
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
 }
 
@@ -279,6 +285,19 @@ INET_ERROR InetLayer::Init(chip::System::Layer & aSystemLayer, void * aContext)
 
     State = kState_Initialized;
 
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    InterfaceTable::StartMonitoring();
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    mInterfaceTableWatch.Init(PrepareInterfaceTableWatch, HandleInterfaceTableWatch, this);
+    if (InterfaceTable::GetMonitorSocket() >= 0)
+        mSystemLayer->StartWatch(mInterfaceTableWatch, InterfaceTable::GetMonitorSocket());
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE > 0
+    mDNSCache.Init(*this);
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE > 0
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
@@ -286,6 +305,12 @@ INET_ERROR InetLayer::Init(chip::System::Layer & aSystemLayer, void * aContext)
     SuccessOrExit(err);
 
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
+    err = mNativeDNSResolver.Init(*this);
+    SuccessOrExit(err);
+
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 exit:
@@ -319,27 +344,37 @@ INET_ERROR InetLayer::Shutdown(void)
     {
 #if INET_CONFIG_ENABLE_DNS_RESOLVER
         // Cancel all DNS resolution requests owned by this instance.
-        for (size_t i = 0; i < DNSResolver::sPool.Size(); i++)
+        for (size_t i = 0; i < mDNSResolverPool.Size(); i++)
         {
-            DNSResolver * lResolver = DNSResolver::sPool.Get(*mSystemLayer, i);
+            DNSResolver * lResolver = mDNSResolverPool.Get(*mSystemLayer, i);
             if ((lResolver != NULL) && lResolver->IsCreatedByInetLayer(*this))
             {
                 lResolver->Cancel();
             }
         }
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+        // The lookups waiting for the canceled requests of the cache would never be released otherwise.
+        mDNSCache.Shutdown();
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
         err = mAsyncDNSResolver.Shutdown();
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
+        err = mNativeDNSResolver.Shutdown();
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
         // Close all raw endpoints owned by this Inet layer instance.
-        for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mRawEndPointPool.Size(); i++)
         {
-            RawEndPoint * lEndPoint = RawEndPoint::sPool.Get(*mSystemLayer, i);
+            RawEndPoint * lEndPoint = mRawEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->Close();
@@ -349,9 +384,9 @@ INET_ERROR InetLayer::Shutdown(void)
 
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
         // Abort all TCP endpoints owned by this instance.
-        for (size_t i = 0; i < TCPEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mTCPEndPointPool.Size(); i++)
         {
-            TCPEndPoint * lEndPoint = TCPEndPoint::sPool.Get(*mSystemLayer, i);
+            TCPEndPoint * lEndPoint = mTCPEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->Abort();
@@ -361,15 +396,22 @@ INET_ERROR InetLayer::Shutdown(void)
 
 #if INET_CONFIG_ENABLE_UDP_ENDPOINT
         // Close all UDP endpoints owned by this instance.
-        for (size_t i = 0; i < UDPEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mUDPEndPointPool.Size(); i++)
         {
-            UDPEndPoint * lEndPoint = UDPEndPoint::sPool.Get(*mSystemLayer, i);
+            UDPEndPoint * lEndPoint = mUDPEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->Close();
             }
         }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        mSystemLayer->StopWatch(mInterfaceTableWatch);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+        InterfaceTable::StopMonitoring();
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
     }
 
     State = kState_NotInitialized;
@@ -411,9 +453,9 @@ bool InetLayer::IsIdleTimerRunning(void)
     bool timerRunning = false;
 
     // see if there are any TCP connections with the idle timer check in use.
-    for (size_t i = 0; i < TCPEndPoint::sPool.Size(); i++)
+    for (size_t i = 0; i < mTCPEndPointPool.Size(); i++)
     {
-        TCPEndPoint * lEndPoint = TCPEndPoint::sPool.Get(*mSystemLayer, i);
+        TCPEndPoint * lEndPoint = mTCPEndPointPool.Get(*mSystemLayer, i);
 
         if ((lEndPoint != NULL) && (lEndPoint->mIdleTimeout != 0))
         {
@@ -546,7 +588,7 @@ INET_ERROR InetLayer::NewRawEndPoint(IPVersion ipVer, IPProtocol ipProto, RawEnd
 
     VerifyOrExit(State == kState_Initialized, err = INET_ERROR_INCORRECT_STATE);
 
-    *retEndPoint = RawEndPoint::sPool.TryCreate(*mSystemLayer);
+    *retEndPoint = mRawEndPointPool.TryCreate(*mSystemLayer);
     if (*retEndPoint != NULL)
     {
         (*retEndPoint)->Inet::RawEndPoint::Init(this, ipVer, ipProto);
@@ -588,7 +630,7 @@ INET_ERROR InetLayer::NewTCPEndPoint(TCPEndPoint ** retEndPoint)
 
     VerifyOrExit(State == kState_Initialized, err = INET_ERROR_INCORRECT_STATE);
 
-    *retEndPoint = TCPEndPoint::sPool.TryCreate(*mSystemLayer);
+    *retEndPoint = mTCPEndPointPool.TryCreate(*mSystemLayer);
     if (*retEndPoint != NULL)
     {
         (*retEndPoint)->Init(this);
@@ -630,7 +672,7 @@ INET_ERROR InetLayer::NewUDPEndPoint(UDPEndPoint ** retEndPoint)
 
     VerifyOrExit(State == kState_Initialized, err = INET_ERROR_INCORRECT_STATE);
 
-    *retEndPoint = UDPEndPoint::sPool.TryCreate(*mSystemLayer);
+    *retEndPoint = mUDPEndPointPool.TryCreate(*mSystemLayer);
     if (*retEndPoint != NULL)
     {
         (*retEndPoint)->Init(this);
@@ -672,7 +714,7 @@ INET_ERROR InetLayer::NewTunEndPoint(TunEndPoint ** retEndPoint)
 
     VerifyOrExit(State == kState_Initialized, err = INET_ERROR_INCORRECT_STATE);
 
-    *retEndPoint = TunEndPoint::sPool.TryCreate(*mSystemLayer);
+    *retEndPoint = mTunEndPointPool.TryCreate(*mSystemLayer);
     if (*retEndPoint != NULL)
     {
         (*retEndPoint)->Init(this);
@@ -843,16 +885,8 @@ INET_ERROR InetLayer::ResolveHostAddress(const char * hostName, uint16_t hostNam
     VerifyOrExit(hostNameLen <= NL_DNS_HOSTNAME_MAX_LEN, err = INET_ERROR_HOST_NAME_TOO_LONG);
     VerifyOrExit(maxAddrs > 0, err = INET_ERROR_NO_MEMORY);
 
-    resolver = DNSResolver::sPool.TryCreate(*mSystemLayer);
-    if (resolver != NULL)
-    {
-        resolver->InitInetLayerBasis(*this);
-    }
-    else
-    {
-        ChipLogError(Inet, "%s resolver pool FULL", "DNS");
-        ExitNow(err = INET_ERROR_NO_MEMORY);
-    }
+    resolver = NewDNSResolver();
+    VerifyOrExit(resolver != NULL, err = INET_ERROR_NO_MEMORY);
 
     // Short-circuit full address resolution if the supplied host name is a text-form
     // IP address...
@@ -882,24 +916,72 @@ INET_ERROR InetLayer::ResolveHostAddress(const char * hostName, uint16_t hostNam
     }
 
     // After this point, the resolver will be released by:
+    // - mDNSCache (in case of a cache hit, or when waiting for a request of the cache)
     // - mAsyncDNSResolver (in case of ASYNC_DNS_SOCKETS)
+    // - mNativeDNSResolver (in case of NATIVE_DNS_SOCKETS)
     // - resolver->Resolve() (in case of synchronous resolving)
     // - the event handlers (in case of LwIP)
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    if (maxAddrs <= INET_CONFIG_DNS_CACHE_MAX_ADDRS)
+    {
+        err = mDNSCache.Resolve(*resolver, hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
+        ExitNow();
+    }
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
+    err = StartResolve(*resolver, hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
+
+exit:
+
+    return err;
+}
+
+/**
+ *  Allocate a DNSResolver object from the pool of this layer, or return NULL
+ *  if the pool is exhausted.
+ */
+DNSResolver * InetLayer::NewDNSResolver(void)
+{
+    DNSResolver * resolver = mDNSResolverPool.TryCreate(*mSystemLayer);
+
+    if (resolver != NULL)
+    {
+        resolver->InitInetLayerBasis(*this);
+    }
+    else
+    {
+        ChipLogError(Inet, "%s resolver pool FULL", "DNS");
+    }
+
+    return resolver;
+}
+
+/**
+ *  Hand a host name lookup to the underlying resolver, which takes over the
+ *  DNSResolver object: it releases it once the lookup completes, or right
+ *  away if it fails to start it.
+ */
+INET_ERROR InetLayer::StartResolve(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen, uint8_t options,
+                                   uint8_t maxAddrs, IPAddress * addrArray, DNSResolveCompleteFunct onComplete, void * appState)
+{
+    INET_ERROR err = INET_NO_ERROR;
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
-    err =
-        mAsyncDNSResolver.PrepareDNSResolver(*resolver, hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
-    SuccessOrExit(err);
+    err = mAsyncDNSResolver.PrepareDNSResolver(resolver, hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
+    if (err == INET_NO_ERROR)
+        mAsyncDNSResolver.EnqueueRequest(resolver);
 
-    mAsyncDNSResolver.EnqueueRequest(*resolver);
+#elif CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
 
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+    err = mNativeDNSResolver.Resolve(resolver, hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
 
-#if !INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
-    err = resolver->Resolve(hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
-#endif // !INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
-exit:
+#else // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && (INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS))
+
+    err = resolver.Resolve(hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
+
+#endif // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && (INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS))
 
     return err;
 }
@@ -925,9 +1007,9 @@ void InetLayer::CancelResolveHostAddress(DNSResolveCompleteFunct onComplete, voi
     if (State != kState_Initialized)
         return;
 
-    for (size_t i = 0; i < DNSResolver::sPool.Size(); i++)
+    for (size_t i = 0; i < mDNSResolverPool.Size(); i++)
     {
-        DNSResolver * lResolver = DNSResolver::sPool.Get(*mSystemLayer, i);
+        DNSResolver * lResolver = mDNSResolverPool.Get(*mSystemLayer, i);
 
         if (lResolver == NULL)
         {
@@ -961,6 +1043,53 @@ void InetLayer::CancelResolveHostAddress(DNSResolveCompleteFunct onComplete, voi
     }
 }
 
+/**
+ *  Forget the results of all past host name lookups, e.g. after the network
+ *  configuration changed. Lookups in progress are not affected.
+ */
+void InetLayer::FlushDNSCache(void)
+{
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    if (State == kState_Initialized)
+        mDNSCache.Flush();
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+/**
+ *  Have host names resolved by the given name servers, instead of those of
+ *  resolv.conf, e.g. when the network provides its own. This forgets the
+ *  results of past lookups.
+ *
+ *  @param[in]  servers     The addresses of the name servers, asked in turn.
+ *  @param[in]  numServers  The number of servers, at most
+ *                          #INET_CONFIG_NATIVE_DNS_MAX_SERVERS.
+ *  @param[in]  port        The UDP port the servers listen on, normally 53.
+ *  @param[in]  timeoutMS   How long to wait for a server to answer before
+ *                          asking the next one.
+ *  @param[in]  attempts    How many times each server is asked.
+ *
+ *  @retval #INET_NO_ERROR               on success.
+ *  @retval #INET_ERROR_INCORRECT_STATE  if the layer is not initialized.
+ *  @retval #INET_ERROR_BAD_ARGS         if an argument is out of range.
+ */
+INET_ERROR InetLayer::SetDNSServers(const IPAddress * servers, uint8_t numServers, uint16_t port, uint32_t timeoutMS,
+                                    uint8_t attempts)
+{
+    INET_ERROR err = INET_NO_ERROR;
+
+    VerifyOrExit(State == kState_Initialized, err = INET_ERROR_INCORRECT_STATE);
+
+    err = mNativeDNSResolver.SetServers(servers, numServers, port, timeoutMS, attempts);
+    SuccessOrExit(err);
+
+    FlushDNSCache();
+
+exit:
+    return err;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
 /**
@@ -1039,7 +1168,7 @@ void InetLayer::HandleTCPInactivityTimer(chip::System::Layer * aSystemLayer, voi
 
     for (size_t i = 0; i < INET_CONFIG_NUM_TCP_ENDPOINTS; i++)
     {
-        TCPEndPoint * lEndPoint = TCPEndPoint::sPool.Get(*aSystemLayer, i);
+        TCPEndPoint * lEndPoint = lInetLayer.mTCPEndPointPool.Get(*aSystemLayer, i);
 
         if (lEndPoint == NULL)
             continue;
@@ -1144,7 +1273,7 @@ exit:
 
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_EPOLL
 /**
  *  Prepare the sets of file descriptors for @p select() to work with.
  *
@@ -1166,40 +1295,49 @@ void InetLayer::PrepareSelect(int & nfds, fd_set * readfds, fd_set * writefds, f
         return;
 
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
-    for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
+    for (size_t i = 0; i < mRawEndPointPool.Size(); i++)
     {
-        RawEndPoint * lEndPoint = RawEndPoint::sPool.Get(*mSystemLayer, i);
+        RawEndPoint * lEndPoint = mRawEndPointPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
     }
 #endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
 
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-    for (size_t i = 0; i < TCPEndPoint::sPool.Size(); i++)
+    for (size_t i = 0; i < mTCPEndPointPool.Size(); i++)
     {
-        TCPEndPoint * lEndPoint = TCPEndPoint::sPool.Get(*mSystemLayer, i);
+        TCPEndPoint * lEndPoint = mTCPEndPointPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
     }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
 #if INET_CONFIG_ENABLE_UDP_ENDPOINT
-    for (size_t i = 0; i < UDPEndPoint::sPool.Size(); i++)
+    for (size_t i = 0; i < mUDPEndPointPool.Size(); i++)
     {
-        UDPEndPoint * lEndPoint = UDPEndPoint::sPool.Get(*mSystemLayer, i);
+        UDPEndPoint * lEndPoint = mUDPEndPointPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
     }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 
 #if INET_CONFIG_ENABLE_TUN_ENDPOINT
-    for (size_t i = 0; i < TunEndPoint::sPool.Size(); i++)
+    for (size_t i = 0; i < mTunEndPointPool.Size(); i++)
     {
-        TunEndPoint * lEndPoint = TunEndPoint::sPool.Get(*mSystemLayer, i);
+        TunEndPoint * lEndPoint = mTunEndPointPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
     }
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+    {
+        SocketEvents lEvents;
+
+        lEvents.SetRead();
+        lEvents.SetFDs(InterfaceTable::GetMonitorSocket(), nfds, readfds, writefds, exceptfds);
+    }
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
 }
 
 /**
@@ -1241,9 +1379,9 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
     {
         // Set the pending I/O field for each active endpoint based on the value returned by select.
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
-        for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mRawEndPointPool.Size(); i++)
         {
-            RawEndPoint * lEndPoint = RawEndPoint::sPool.Get(*mSystemLayer, i);
+            RawEndPoint * lEndPoint = mRawEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->mPendingIO = SocketEvents::FromFDs(lEndPoint->mSocket, readfds, writefds, exceptfds);
@@ -1252,9 +1390,9 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
 #endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
 
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-        for (size_t i = 0; i < TCPEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mTCPEndPointPool.Size(); i++)
         {
-            TCPEndPoint * lEndPoint = TCPEndPoint::sPool.Get(*mSystemLayer, i);
+            TCPEndPoint * lEndPoint = mTCPEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->mPendingIO = SocketEvents::FromFDs(lEndPoint->mSocket, readfds, writefds, exceptfds);
@@ -1263,9 +1401,9 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
 #if INET_CONFIG_ENABLE_UDP_ENDPOINT
-        for (size_t i = 0; i < UDPEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mUDPEndPointPool.Size(); i++)
         {
-            UDPEndPoint * lEndPoint = UDPEndPoint::sPool.Get(*mSystemLayer, i);
+            UDPEndPoint * lEndPoint = mUDPEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->mPendingIO = SocketEvents::FromFDs(lEndPoint->mSocket, readfds, writefds, exceptfds);
@@ -1274,9 +1412,9 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 
 #if INET_CONFIG_ENABLE_TUN_ENDPOINT
-        for (size_t i = 0; i < TunEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mTunEndPointPool.Size(); i++)
         {
-            TunEndPoint * lEndPoint = TunEndPoint::sPool.Get(*mSystemLayer, i);
+            TunEndPoint * lEndPoint = mTunEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->mPendingIO = SocketEvents::FromFDs(lEndPoint->mSocket, readfds, writefds, exceptfds);
@@ -1286,9 +1424,9 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
 
         // Now call each active endpoint to handle its pending I/O.
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
-        for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mRawEndPointPool.Size(); i++)
         {
-            RawEndPoint * lEndPoint = RawEndPoint::sPool.Get(*mSystemLayer, i);
+            RawEndPoint * lEndPoint = mRawEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->HandlePendingIO();
@@ -1297,9 +1435,9 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
 #endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
 
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-        for (size_t i = 0; i < TCPEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mTCPEndPointPool.Size(); i++)
         {
-            TCPEndPoint * lEndPoint = TCPEndPoint::sPool.Get(*mSystemLayer, i);
+            TCPEndPoint * lEndPoint = mTCPEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->HandlePendingIO();
@@ -1308,9 +1446,9 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
 #if INET_CONFIG_ENABLE_UDP_ENDPOINT
-        for (size_t i = 0; i < UDPEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mUDPEndPointPool.Size(); i++)
         {
-            UDPEndPoint * lEndPoint = UDPEndPoint::sPool.Get(*mSystemLayer, i);
+            UDPEndPoint * lEndPoint = mUDPEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->HandlePendingIO();
@@ -1319,19 +1457,36 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 
 #if INET_CONFIG_ENABLE_TUN_ENDPOINT
-        for (size_t i = 0; i < TunEndPoint::sPool.Size(); i++)
+        for (size_t i = 0; i < mTunEndPointPool.Size(); i++)
         {
-            TunEndPoint * lEndPoint = TunEndPoint::sPool.Get(*mSystemLayer, i);
+            TunEndPoint * lEndPoint = mTunEndPointPool.Get(*mSystemLayer, i);
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->HandlePendingIO();
             }
         }
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+        if (SocketEvents::FromFDs(InterfaceTable::GetMonitorSocket(), readfds, writefds, exceptfds).IsReadable())
+            InterfaceTable::HandleChanges();
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
     }
 }
 
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE && CHIP_SYSTEM_CONFIG_USE_EPOLL
+uint8_t InetLayer::PrepareInterfaceTableWatch(chip::System::SocketWatch & aWatch, bool & aRecheck)
+{
+    return chip::System::SocketWatch::kRead;
+}
+
+void InetLayer::HandleInterfaceTableWatch(chip::System::SocketWatch & aWatch, uint8_t aEvents)
+{
+    InterfaceTable::HandleChanges();
+}
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE && CHIP_SYSTEM_CONFIG_USE_EPOLL
 
 /**
  *  Reset the members of the IPPacketInfo object.
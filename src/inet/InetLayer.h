@@ -59,6 +59,7 @@
 #include <inet/InetLayerEvents.h>
 
 #if INET_CONFIG_ENABLE_DNS_RESOLVER
+#include <inet/DNSCache.h>
 #include <inet/DNSResolver.h>
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
@@ -82,9 +83,13 @@
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 #include <inet/AsyncDNSResolverSockets.h>
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+#include <inet/NativeDNSResolverSockets.h>
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #include <system/SystemLayer.h>
+#include <system/SystemLoopMetrics.h>
 #include <system/SystemStats.h>
 
 #include <support/DLLUtil.h>
@@ -146,6 +151,9 @@ class DLL_EXPORT InetLayer
 {
 #if INET_CONFIG_ENABLE_DNS_RESOLVER
     friend class DNSResolver;
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    friend class DNSCache;
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
@@ -168,6 +176,9 @@ class DLL_EXPORT InetLayer
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
     friend class AsyncDNSResolverSockets;
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+    friend class NativeDNSResolverSockets;
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 public:
@@ -219,6 +230,10 @@ public:
     INET_ERROR ResolveHostAddress(const char * hostName, uint8_t maxAddrs, IPAddress * addrArray,
                                   DNSResolveCompleteFunct onComplete, void * appState);
     void CancelResolveHostAddress(DNSResolveCompleteFunct onComplete, void * appState);
+    void FlushDNSCache(void);
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+    INET_ERROR SetDNSServers(const IPAddress * servers, uint8_t numServers, uint16_t port, uint32_t timeoutMS, uint8_t attempts);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
 
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
@@ -227,12 +242,12 @@ public:
     INET_ERROR GetLinkLocalAddr(InterfaceId link, IPAddress * llAddr);
     bool MatchLocalIPv6Subnet(const IPAddress & addr);
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_EPOLL
     void PrepareSelect(int & nfds, fd_set * readfds, fd_set * writefds, fd_set * exceptfds, struct timeval & sleepTime);
     void HandleSelectResult(int selectRes, fd_set * readfds, fd_set * writefds, fd_set * exceptfds);
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_EPOLL
 
-    static void UpdateSnapshot(chip::System::Stats::Snapshot & aSnapshot);
+    void UpdateSnapshot(chip::System::Stats::Snapshot & aSnapshot);
 
     void * GetPlatformData(void);
     void SetPlatformData(void * aPlatformData);
@@ -307,10 +322,43 @@ private:
     void * mPlatformData;
     chip::System::Layer * mSystemLayer;
 
+    // Endpoints of this InetLayer only, so that independent layers running on different threads share no state.
+#if INET_CONFIG_ENABLE_DNS_RESOLVER
+    chip::System::ObjectPool<DNSResolver, INET_CONFIG_NUM_DNS_RESOLVERS> mDNSResolverPool;
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    DNSCache mDNSCache;
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
+    DNSResolver * NewDNSResolver(void);
+    INET_ERROR StartResolve(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen, uint8_t options, uint8_t maxAddrs,
+                            IPAddress * addrArray, DNSResolveCompleteFunct onComplete, void * appState);
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER
+#if INET_CONFIG_ENABLE_RAW_ENDPOINT
+    chip::System::ObjectPool<RawEndPoint, INET_CONFIG_NUM_RAW_ENDPOINTS> mRawEndPointPool;
+#endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    chip::System::ObjectPool<TCPEndPoint, INET_CONFIG_NUM_TCP_ENDPOINTS> mTCPEndPointPool;
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+    chip::System::ObjectPool<UDPEndPoint, INET_CONFIG_NUM_UDP_ENDPOINTS> mUDPEndPointPool;
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+    chip::System::ObjectPool<TunEndPoint, INET_CONFIG_NUM_TUN_ENDPOINTS> mTunEndPointPool;
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
     AsyncDNSResolverSockets mAsyncDNSResolver;
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+    NativeDNSResolverSockets mNativeDNSResolver;
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE && CHIP_SYSTEM_CONFIG_USE_EPOLL
+    chip::System::SocketWatch mInterfaceTableWatch; ///< Registration of the netlink socket of InterfaceTable with the system layer.
+
+    static uint8_t PrepareInterfaceTableWatch(chip::System::SocketWatch & aWatch, bool & aRecheck);
+    static void HandleInterfaceTableWatch(chip::System::SocketWatch & aWatch, uint8_t aEvents);
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE && CHIP_SYSTEM_CONFIG_USE_EPOLL
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
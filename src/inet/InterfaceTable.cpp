@@ -0,0 +1,382 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements InterfaceTable, the snapshot of the network
+ *      interfaces and addresses that the interface iterators read from.
+ *
+ */
+
+#include <inet/InterfaceTable.h>
+
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+#include <errno.h>
+#include <ifaddrs.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <netpacket/packet.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace chip {
+namespace Inet {
+
+namespace {
+
+pthread_mutex_t sLock = PTHREAD_MUTEX_INITIALIZER;
+
+// All of the following are guarded by sLock.
+InterfaceTable * sCurrent;  ///< Snapshot kept for the iterators to come, or NULL if there is none or it became stale.
+unsigned int sMonitorUsers; ///< Number of InetLayer objects monitoring changes.
+int sMonitorSocket = -1;    ///< Netlink socket reporting link and address changes, or -1 when not monitoring.
+
+bool IsListedAddress(const struct ifaddrs & ifa)
+{
+    return ifa.ifa_addr != NULL &&
+        (ifa.ifa_addr->sa_family == AF_INET6
+#if INET_CONFIG_ENABLE_IPV4
+         || ifa.ifa_addr->sa_family == AF_INET
+#endif // INET_CONFIG_ENABLE_IPV4
+        );
+}
+
+uint8_t GetPrefixLength(const struct ifaddrs & ifa)
+{
+    if (ifa.ifa_netmask == NULL)
+        return 0;
+
+    if (ifa.ifa_addr->sa_family == AF_INET6)
+    {
+        const struct sockaddr_in6 & netmask = *reinterpret_cast<const struct sockaddr_in6 *>(ifa.ifa_netmask);
+        return NetmaskToPrefixLength(netmask.sin6_addr.s6_addr, 16);
+    }
+
+    const struct sockaddr_in & netmask = *reinterpret_cast<const struct sockaddr_in *>(ifa.ifa_netmask);
+    return NetmaskToPrefixLength(reinterpret_cast<const uint8_t *>(&netmask.sin_addr.s_addr), 4);
+}
+
+void CopyName(char (&dest)[IF_NAMESIZE], const char * name)
+{
+    strncpy(dest, name, IF_NAMESIZE - 1);
+    dest[IF_NAMESIZE - 1] = 0;
+}
+
+} // anonymous namespace
+
+/**
+ *  Return the current snapshot, taking a new one if needed, or NULL if the
+ *  system interfaces could not be read. The snapshot must be released with
+ *  Release() once done with.
+ */
+const InterfaceTable * InterfaceTable::Acquire(void)
+{
+    InterfaceTable * table;
+
+    pthread_mutex_lock(&sLock);
+
+    // Changes are picked up here too, in case the event loop has not run since they were made.
+    if (sMonitorSocket >= 0 && DrainChanges())
+        Invalidate();
+
+    table = sCurrent;
+
+    if (table == NULL)
+    {
+        table = Take();
+
+        // Without monitoring, nothing would tell when the snapshot becomes stale, so it is not kept.
+        if (table != NULL && sMonitorSocket >= 0)
+        {
+            table->mRefCount++;
+            sCurrent = table;
+        }
+    }
+    else
+    {
+        table->mRefCount++;
+    }
+
+    pthread_mutex_unlock(&sLock);
+
+    return table;
+}
+
+void InterfaceTable::Release(const InterfaceTable * table)
+{
+    bool last;
+
+    pthread_mutex_lock(&sLock);
+    last = (--table->mRefCount == 0);
+    pthread_mutex_unlock(&sLock);
+
+    if (last)
+        free(const_cast<InterfaceTable *>(table));
+}
+
+/**
+ *  Start keeping snapshots, refreshed upon link and address changes. Called
+ *  by each InetLayer when initialized.
+ *
+ *  If the netlink socket cannot be opened, the iterators read the system
+ *  interfaces each time they start, as they would without InetLayer.
+ */
+void InterfaceTable::StartMonitoring(void)
+{
+    pthread_mutex_lock(&sLock);
+
+    sMonitorUsers++;
+
+    if (sMonitorSocket < 0)
+    {
+        struct sockaddr_nl addr;
+        int s = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+
+        memset(&addr, 0, sizeof(addr));
+        addr.nl_family = AF_NETLINK;
+        addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV6_IFADDR;
+#if INET_CONFIG_ENABLE_IPV4
+        addr.nl_groups |= RTMGRP_IPV4_IFADDR;
+#endif // INET_CONFIG_ENABLE_IPV4
+
+        if (s >= 0 && bind(s, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0)
+        {
+            const int bindErr = errno;
+
+            close(s);
+            s     = -1;
+            errno = bindErr;
+        }
+
+        if (s < 0)
+            ChipLogError(Inet, "Interface changes not monitored: %d", errno);
+
+        sMonitorSocket = s;
+    }
+
+    pthread_mutex_unlock(&sLock);
+}
+
+/**
+ *  Undo a call to StartMonitoring(). Called by each InetLayer when shut down.
+ */
+void InterfaceTable::StopMonitoring(void)
+{
+    pthread_mutex_lock(&sLock);
+
+    if (--sMonitorUsers == 0)
+    {
+        if (sMonitorSocket >= 0)
+        {
+            close(sMonitorSocket);
+            sMonitorSocket = -1;
+        }
+
+        Invalidate();
+    }
+
+    pthread_mutex_unlock(&sLock);
+}
+
+/**
+ *  Return the netlink socket for the event loop to watch, or -1 if none.
+ */
+int InterfaceTable::GetMonitorSocket(void)
+{
+    int s;
+
+    pthread_mutex_lock(&sLock);
+    s = sMonitorSocket;
+    pthread_mutex_unlock(&sLock);
+
+    return s;
+}
+
+/**
+ *  Handle the netlink socket becoming readable.
+ */
+void InterfaceTable::HandleChanges(void)
+{
+    pthread_mutex_lock(&sLock);
+
+    if (sMonitorSocket >= 0 && DrainChanges())
+        Invalidate();
+
+    pthread_mutex_unlock(&sLock);
+}
+
+/**
+ *  Take a new snapshot with a reference count of one, or return NULL on
+ *  failure. Interfaces and addresses are listed in the order the system
+ *  reports them.
+ */
+InterfaceTable * InterfaceTable::Take(void)
+{
+    InterfaceTable * table = NULL;
+    struct ifaddrs * addrsList;
+    Interface * intfs;
+    Address * addrs;
+    size_t maxIntfs = 0;
+    size_t maxAddrs = 0;
+
+    if (getifaddrs(&addrsList) != 0)
+        return NULL;
+
+    // Each interface is listed as an AF_PACKET entry, without an address if it has no link layer address.
+    for (struct ifaddrs * ifa = addrsList; ifa != NULL; ifa = ifa->ifa_next)
+    {
+        if (ifa->ifa_addr == NULL || ifa->ifa_addr->sa_family == AF_PACKET)
+            maxIntfs++;
+        else if (IsListedAddress(*ifa))
+            maxAddrs++;
+    }
+
+    table =
+        static_cast<InterfaceTable *>(malloc(sizeof(InterfaceTable) + maxAddrs * sizeof(Address) + maxIntfs * sizeof(Interface)));
+    VerifyOrExit(table != NULL, );
+
+    addrs = reinterpret_cast<Address *>(table + 1);
+    intfs = reinterpret_cast<Interface *>(addrs + maxAddrs);
+
+    table->mRefCount      = 1;
+    table->mNumInterfaces = 0;
+    table->mNumAddresses  = 0;
+    table->mInterfaces    = intfs;
+    table->mAddresses     = addrs;
+
+    for (struct ifaddrs * ifa = addrsList; ifa != NULL; ifa = ifa->ifa_next)
+    {
+        if (ifa->ifa_addr != NULL && ifa->ifa_addr->sa_family == AF_PACKET)
+        {
+            Interface & intf = intfs[table->mNumInterfaces++];
+
+            intf.id    = reinterpret_cast<const struct sockaddr_ll *>(ifa->ifa_addr)->sll_ifindex;
+            intf.flags = ifa->ifa_flags;
+            CopyName(intf.name, ifa->ifa_name);
+        }
+        else if (ifa->ifa_addr == NULL)
+        {
+            Interface & intf = intfs[table->mNumInterfaces];
+            bool listed      = false;
+
+            for (size_t i = 0; i < table->mNumInterfaces && !listed; i++)
+                listed = (strcmp(intfs[i].name, ifa->ifa_name) == 0);
+
+            intf.id = listed ? INET_NULL_INTERFACEID : if_nametoindex(ifa->ifa_name);
+            if (intf.id != INET_NULL_INTERFACEID)
+            {
+                intf.flags = ifa->ifa_flags;
+                CopyName(intf.name, ifa->ifa_name);
+                table->mNumInterfaces++;
+            }
+        }
+        else if (IsListedAddress(*ifa))
+        {
+            Address & address = addrs[table->mNumAddresses++];
+
+            address.addr      = IPAddress::FromSockAddr(*ifa->ifa_addr);
+            address.intfId    = INET_NULL_INTERFACEID;
+            address.flags     = ifa->ifa_flags;
+            address.prefixLen = GetPrefixLength(*ifa);
+            CopyName(address.name, ifa->ifa_name);
+        }
+    }
+
+    for (size_t i = 0; i < table->mNumAddresses; i++)
+    {
+        Address & address = addrs[i];
+
+        for (size_t j = 0; j < table->mNumInterfaces && address.intfId == INET_NULL_INTERFACEID; j++)
+        {
+            if (strcmp(address.name, intfs[j].name) == 0)
+                address.intfId = intfs[j].id;
+        }
+
+        // IPv4 addresses may be listed under their label rather than the name of their interface.
+        if (address.intfId == INET_NULL_INTERFACEID)
+            address.intfId = if_nametoindex(address.name);
+    }
+
+exit:
+    freeifaddrs(addrsList);
+    return table;
+}
+
+/**
+ *  Read all notifications pending on the netlink socket, and return whether
+ *  any of them reported a change. Must be called with sLock held.
+ */
+bool InterfaceTable::DrainChanges(void)
+{
+    bool changed = false;
+
+    while (true)
+    {
+        struct nlmsghdr header;
+
+        // Only the header matters; MSG_TRUNC discards the rest of each notification.
+        const ssize_t len = recv(sMonitorSocket, &header, sizeof(header), MSG_DONTWAIT | MSG_TRUNC);
+
+        if (len < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            // ENOBUFS means that notifications were lost.
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                changed = true;
+
+            break;
+        }
+
+        if (len >= static_cast<ssize_t>(sizeof(header)) &&
+            (header.nlmsg_type == RTM_NEWLINK || header.nlmsg_type == RTM_DELLINK || header.nlmsg_type == RTM_NEWADDR ||
+             header.nlmsg_type == RTM_DELADDR))
+        {
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/**
+ *  Drop the current snapshot; iterators still reading it keep it alive.
+ *  Must be called with sLock held.
+ */
+void InterfaceTable::Invalidate(void)
+{
+    if (sCurrent != NULL)
+    {
+        if (--sCurrent->mRefCount == 0)
+            free(sCurrent);
+
+        sCurrent = NULL;
+    }
+}
+
+} // namespace Inet
+} // namespace chip
+
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
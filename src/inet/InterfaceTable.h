@@ -0,0 +1,111 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines InterfaceTable, the snapshot of the network
+ *      interfaces and addresses that the interface iterators read from.
+ *
+ */
+
+#ifndef INTERFACETABLE_H
+#define INTERFACETABLE_H
+
+#include <inet/IPAddress.h>
+#include <inet/InetError.h>
+#include <inet/InetInterface.h>
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+#include <net/if.h>
+
+namespace chip {
+namespace Inet {
+
+class InetLayer;
+
+/**
+ *  @class InterfaceTable
+ *
+ *  @brief
+ *    This is an internal class to InetInterface and InetLayer that holds a
+ *    snapshot of the network interfaces and their addresses, taken with a
+ *    single getifaddrs() call. There is no public interface available for
+ *    the application layer.
+ *
+ *  @details
+ *    A snapshot is never modified once taken, and is freed when its last
+ *    reader releases it, so that iterators remain stable in the face of
+ *    changes to the system's interfaces.
+ *
+ *    While monitoring, the current snapshot is kept for the iterators that
+ *    follow, until a link or address change is reported on the netlink
+ *    socket. The socket is watched by the event loop of every initialized
+ *    InetLayer, and is also checked whenever an iteration starts, so that
+ *    a change made right before is never missed.
+ *
+ *    All methods are thread-safe.
+ */
+class InterfaceTable
+{
+    friend class InterfaceIterator;
+    friend class InterfaceAddressIterator;
+    friend class InetLayer;
+    friend class InterfaceTableTest;
+
+private:
+    struct Interface
+    {
+        InterfaceId id;         ///< Interface index.
+        unsigned int flags;     ///< IFF_* flags of the interface.
+        char name[IF_NAMESIZE]; ///< Interface name.
+    };
+
+    struct Address
+    {
+        IPAddress addr;         ///< Interface address.
+        InterfaceId intfId;     ///< Index of the interface the address is assigned to.
+        unsigned int flags;     ///< IFF_* flags of the interface.
+        uint8_t prefixLen;      ///< Length of the network prefix, in bits.
+        char name[IF_NAMESIZE]; ///< Name of the interface, or label of the address.
+    };
+
+    static const InterfaceTable * Acquire(void);
+    static void Release(const InterfaceTable * table);
+
+    static void StartMonitoring(void);
+    static void StopMonitoring(void);
+    static int GetMonitorSocket(void);
+    static void HandleChanges(void);
+
+    static InterfaceTable * Take(void);
+    static bool DrainChanges(void);
+    static void Invalidate(void);
+
+    mutable unsigned int mRefCount;
+    size_t mNumInterfaces;
+    size_t mNumAddresses;
+    const Interface * mInterfaces;
+    const Address * mAddresses;
+};
+
+} // namespace Inet
+} // namespace chip
+
+#endif // INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+#endif // !defined(INTERFACETABLE_H)
@@ -0,0 +1,848 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements NativeDNSResolverSockets, the DNS client that
+ *      resolves host names from the event loop of InetLayer.
+ *
+ */
+#include <inet/InetLayer.h>
+#include <core/CHIPEncoding.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
+#include "NativeDNSResolverSockets.h"
+
+namespace chip {
+namespace Inet {
+
+using namespace chip::Encoding;
+using chip::System::PacketBuffer;
+
+namespace {
+
+// DNS message format, per RFC 1035.
+constexpr uint16_t kHeaderLength     = 12;
+constexpr uint16_t kFlag_Response    = 0x8000;
+constexpr uint16_t kFlag_Truncated   = 0x0200;
+constexpr uint16_t kFlag_RecursionOK = 0x0100;
+constexpr uint16_t kRCodeMask        = 0x000F;
+constexpr uint16_t kRCode_NoError    = 0;
+constexpr uint16_t kRCode_NXDomain   = 3;
+constexpr uint16_t kRRType_A         = 1;
+constexpr uint16_t kRRType_CNAME     = 5;
+constexpr uint16_t kRRType_AAAA      = 28;
+constexpr uint16_t kRRClass_IN       = 1;
+constexpr uint8_t kMaxLabelLength    = 63;
+constexpr uint8_t kPointerMask       = 0xC0;
+constexpr uint16_t kMaxQueryLength   = kHeaderLength + NL_DNS_HOSTNAME_MAX_LEN + 2 + 4;
+
+// resolv.conf(5) caps these options too.
+constexpr uint32_t kMaxTimeoutSecs = 30;
+constexpr uint8_t kMaxAttempts     = 5;
+
+const uint16_t sRRTypes[] = { kRRType_A, kRRType_AAAA };
+
+/**
+ *  Check that a host name can be put in a query: labels of 1 to 63
+ *  characters, separated by dots.
+ */
+bool IsValidHostName(const char * name)
+{
+    size_t labelLength = 0;
+
+    VerifyOrExit(*name != 0, );
+
+    for (const char * p = name; *p != 0; p++)
+    {
+        if (*p == '.')
+        {
+            VerifyOrExit(labelLength > 0, );
+            labelLength = 0;
+        }
+        else
+        {
+            VerifyOrExit(++labelLength <= kMaxLabelLength, );
+        }
+    }
+
+    return labelLength > 0;
+
+exit:
+    return false;
+}
+
+/**
+ *  Read a possibly compressed name at @a offset of a message, in dotted
+ *  form, and move @a offset past it. Compression pointers must point
+ *  backwards, which rules out loops.
+ */
+bool ReadName(const uint8_t * msg, uint16_t msgLen, uint16_t & offset, char * name)
+{
+    uint16_t pos     = offset;
+    uint16_t nameLen = 0;
+    bool jumped      = false;
+
+    while (true)
+    {
+        VerifyOrExit(pos < msgLen, );
+
+        const uint8_t labelLength = msg[pos];
+
+        if ((labelLength & kPointerMask) == kPointerMask)
+        {
+            VerifyOrExit(pos + 1 < msgLen, );
+
+            const uint16_t target = BigEndian::Get16(&msg[pos]) & ~(kPointerMask << 8);
+
+            VerifyOrExit(target < pos, );
+
+            if (!jumped)
+                offset = pos + 2;
+            jumped = true;
+            pos    = target;
+        }
+        else if (labelLength == 0)
+        {
+            if (!jumped)
+                offset = pos + 1;
+            break;
+        }
+        else
+        {
+            VerifyOrExit(labelLength <= kMaxLabelLength && pos + 1 + labelLength <= msgLen, );
+            VerifyOrExit(nameLen + (nameLen > 0) + labelLength <= NL_DNS_HOSTNAME_MAX_LEN, );
+
+            if (nameLen > 0)
+                name[nameLen++] = '.';
+
+            for (uint8_t i = 1; i <= labelLength; i++)
+            {
+                // Such labels could pass for several, or for a shorter name.
+                VerifyOrExit(msg[pos + i] != '.' && msg[pos + i] != 0, );
+                name[nameLen++] = static_cast<char>(msg[pos + i]);
+            }
+
+            pos += 1 + labelLength;
+        }
+    }
+
+    name[nameLen] = 0;
+    return true;
+
+exit:
+    return false;
+}
+
+} // namespace
+
+/**
+ *  The explicit initializer for the NativeDNSResolverSockets class. This
+ *  opens the random device and reads the name servers and options from
+ *  resolv.conf; the endpoints are only opened once a query is sent.
+ *
+ *  @param[in]  inet  The InetLayer the client belongs to.
+ *
+ *  @retval #INET_NO_ERROR  on success.
+ *  @retval other           the error opening the random device.
+ */
+INET_ERROR NativeDNSResolverSockets::Init(InetLayer & inet)
+{
+    mInet = &inet;
+
+    mRandomFD = open(INET_CONFIG_NATIVE_DNS_RANDOM_DEVICE, O_RDONLY | O_CLOEXEC);
+    if (mRandomFD < 0)
+        return chip::System::MapErrorPOSIX(errno);
+
+    for (Query & query : mQueries)
+    {
+        query.client   = this;
+        query.resolver = NULL;
+        query.endPoint = NULL;
+    }
+
+    ReadResolvConf();
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  Close the random device. The lookups in progress must have been
+ *  canceled, which closed their endpoints.
+ *
+ *  @retval #INET_NO_ERROR  always.
+ */
+INET_ERROR NativeDNSResolverSockets::Shutdown(void)
+{
+    close(mRandomFD);
+    mRandomFD = -1;
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  Replace the name servers and options read from resolv.conf. Lookups in
+ *  progress move on to the new servers when they next send their queries.
+ *
+ *  @retval #INET_NO_ERROR          on success.
+ *  @retval #INET_ERROR_BAD_ARGS    if no server, too many servers, or a
+ *                                  zero port, timeout or number of attempts
+ *                                  was given.
+ */
+INET_ERROR NativeDNSResolverSockets::SetServers(const IPAddress * servers, uint8_t numServers, uint16_t port, uint32_t timeoutMS,
+                                                uint8_t attempts)
+{
+    INET_ERROR err = INET_NO_ERROR;
+
+    VerifyOrExit(servers != NULL && numServers > 0 && numServers <= INET_CONFIG_NATIVE_DNS_MAX_SERVERS, err = INET_ERROR_BAD_ARGS);
+    VerifyOrExit(port != 0 && timeoutMS != 0 && attempts != 0, err = INET_ERROR_BAD_ARGS);
+
+    for (uint8_t i = 0; i < numServers; i++)
+        mServers[i] = servers[i];
+
+    mNumServers = numServers;
+    mPort       = port;
+    mTimeoutMS  = timeoutMS;
+    mAttempts   = attempts;
+
+exit:
+    return err;
+}
+
+void NativeDNSResolverSockets::ReadResolvConf(void)
+{
+    FILE * file = fopen(INET_CONFIG_NATIVE_DNS_RESOLV_CONF_PATH, "r");
+    char line[256];
+
+    mNumServers = 0;
+    mPort       = 53;
+    mTimeoutMS  = INET_CONFIG_NATIVE_DNS_TIMEOUT_MS;
+    mAttempts   = INET_CONFIG_NATIVE_DNS_ATTEMPTS;
+
+    while (file != NULL && fgets(line, sizeof(line), file) != NULL)
+    {
+        char * savePtr;
+        const char * keyword = strtok_r(line, " \t\r\n", &savePtr);
+        const char * value;
+
+        if (keyword == NULL)
+            continue;
+
+        if (strcmp(keyword, "nameserver") == 0)
+        {
+            IPAddress server;
+
+            value = strtok_r(NULL, " \t\r\n", &savePtr);
+
+            // Addresses with a zone, e.g. "fe80::1%eth0", are not supported.
+            if (value == NULL || mNumServers == INET_CONFIG_NATIVE_DNS_MAX_SERVERS || !IPAddress::FromString(value, server))
+                continue;
+#if !INET_CONFIG_ENABLE_IPV4
+            if (server.Type() == kIPAddressType_IPv4)
+                continue;
+#endif // !INET_CONFIG_ENABLE_IPV4
+
+            mServers[mNumServers++] = server;
+        }
+        else if (strcmp(keyword, "options") == 0)
+        {
+            while ((value = strtok_r(NULL, " \t\r\n", &savePtr)) != NULL)
+            {
+                if (strncmp(value, "timeout:", 8) == 0)
+                {
+                    const unsigned long timeoutSecs = strtoul(value + 8, NULL, 10);
+
+                    if (timeoutSecs > 0)
+                        mTimeoutMS = static_cast<uint32_t>(::chip::min(timeoutSecs, (unsigned long) kMaxTimeoutSecs)) * 1000;
+                }
+                else if (strncmp(value, "attempts:", 9) == 0)
+                {
+                    const unsigned long attempts = strtoul(value + 9, NULL, 10);
+
+                    if (attempts > 0)
+                        mAttempts = static_cast<uint8_t>(::chip::min(attempts, (unsigned long) kMaxAttempts));
+                }
+            }
+        }
+    }
+
+    if (file != NULL)
+        fclose(file);
+
+    // Like the C library, fall back to a server on this host.
+    if (mNumServers == 0)
+    {
+#if INET_CONFIG_ENABLE_IPV4
+        IPAddress::FromString("127.0.0.1", mServers[0]);
+#else  // !INET_CONFIG_ENABLE_IPV4
+        IPAddress::FromString("::1", mServers[0]);
+#endif // !INET_CONFIG_ENABLE_IPV4
+        mNumServers = 1;
+    }
+
+    ChipLogDetail(Inet, "DNS client using %u server(s), timeout %" PRIu32 " ms, %u attempt(s)", mNumServers, mTimeoutMS,
+                  mAttempts);
+}
+
+/**
+ *  Start resolving a host name, taking over the DNSResolver object of the
+ *  lookup: it is released once the lookup completes, which happens before
+ *  this method returns for "localhost", or right away if the lookup cannot
+ *  be started.
+ *
+ *  The parameters and return values are those of
+ *  InetLayer::ResolveHostAddress().
+ */
+INET_ERROR NativeDNSResolverSockets::Resolve(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen, uint8_t options,
+                                             uint8_t maxAddrs, IPAddress * addrArray,
+                                             DNSResolver::OnResolveCompleteFunct onComplete, void * appState)
+{
+    INET_ERROR err = INET_NO_ERROR;
+    Query * query  = NULL;
+    uint8_t types;
+
+    switch (options & kDNSOption_AddrFamily_Mask)
+    {
+    case kDNSOption_AddrFamily_Any:
+    case kDNSOption_AddrFamily_IPv6Preferred:
+#if INET_CONFIG_ENABLE_IPV4
+    case kDNSOption_AddrFamily_IPv4Preferred:
+        types = (1 << kQueryType_A) | (1 << kQueryType_AAAA);
+        break;
+    case kDNSOption_AddrFamily_IPv4Only:
+        types = (1 << kQueryType_A);
+        break;
+#endif // INET_CONFIG_ENABLE_IPV4
+    case kDNSOption_AddrFamily_IPv6Only:
+        types = (1 << kQueryType_AAAA);
+        break;
+    default:
+        ExitNow(err = INET_ERROR_BAD_ARGS);
+    }
+
+    VerifyOrExit((options & kDNSOption_Flags_Mask & ~kDNSOption_ValidFlags) == 0, err = INET_ERROR_BAD_ARGS);
+
+    for (Query & freeQuery : mQueries)
+    {
+        if (freeQuery.resolver == NULL)
+        {
+            query = &freeQuery;
+            break;
+        }
+    }
+
+    // Never happens: every lookup in progress has a DNSResolver object, and there are as many queries.
+    VerifyOrExit(query != NULL, err = INET_ERROR_NO_MEMORY);
+
+    memcpy(query->hostName, hostName, hostNameLen);
+    query->hostName[hostNameLen] = 0;
+
+    // A fully qualified name is looked up the same, as search domains are not applied anyway.
+    if (hostNameLen > 1 && query->hostName[hostNameLen - 1] == '.')
+        query->hostName[hostNameLen - 1] = 0;
+
+    VerifyOrExit(IsValidHostName(query->hostName), err = INET_ERROR_BAD_ARGS);
+
+    resolver.AppState   = appState;
+    resolver.AddrArray  = addrArray;
+    resolver.MaxAddrs   = maxAddrs;
+    resolver.NumAddrs   = 0;
+    resolver.DNSOptions = options;
+    resolver.OnComplete = onComplete;
+
+    err = GetRandomIds(*query);
+    SuccessOrExit(err);
+
+    query->resolver     = &resolver;
+    query->pending      = types;
+    query->sends        = 0;
+    query->nameNotFound = false;
+    query->serverFailed = false;
+
+    for (uint8_t type = 0; type < kQueryType_Count; type++)
+        query->numAddrs[type] = 0;
+
+    if (ResolveLocalhost(*query))
+        Complete(*query);
+    else
+        SendQueries(*query);
+
+exit:
+    if (err != INET_NO_ERROR)
+        resolver.Release();
+
+    return err;
+}
+
+/**
+ *  Stop resolving the host name of a lookup, if the client is resolving
+ *  it, and release its DNSResolver object.
+ */
+void NativeDNSResolverSockets::Cancel(DNSResolver & resolver)
+{
+    for (Query & query : mQueries)
+    {
+        if (query.resolver == &resolver)
+        {
+            Free(query);
+            resolver.Release();
+            break;
+        }
+    }
+}
+
+/**
+ *  Answer lookups of "localhost" and of names in the ".localhost" domain
+ *  with the loopback addresses, as RFC 6761 recommends, since the name
+ *  servers may not know them.
+ */
+bool NativeDNSResolverSockets::ResolveLocalhost(Query & query)
+{
+    static const char kLocalhost[] = "localhost";
+    const size_t localhostLen      = sizeof(kLocalhost) - 1;
+    const size_t hostNameLen       = strlen(query.hostName);
+    struct in6_addr loopbackAddr6  = IN6ADDR_LOOPBACK_INIT;
+    const char * suffix;
+
+    if (hostNameLen < localhostLen)
+        return false;
+
+    suffix = query.hostName + hostNameLen - localhostLen;
+    if (strcasecmp(suffix, kLocalhost) != 0 || (hostNameLen > localhostLen && suffix[-1] != '.'))
+        return false;
+
+#if INET_CONFIG_ENABLE_IPV4
+    if (query.pending & (1 << kQueryType_A))
+    {
+        struct in_addr loopbackAddr4;
+
+        loopbackAddr4.s_addr         = htonl(INADDR_LOOPBACK);
+        query.addrs[kQueryType_A][0] = IPAddress::FromIPv4(loopbackAddr4);
+        query.numAddrs[kQueryType_A] = 1;
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    if (query.pending & (1 << kQueryType_AAAA))
+    {
+        query.addrs[kQueryType_AAAA][0] = IPAddress::FromIPv6(loopbackAddr6);
+        query.numAddrs[kQueryType_AAAA] = 1;
+    }
+
+    query.pending = 0;
+
+    return true;
+}
+
+/**
+ *  Send the queries still waiting for an answer to the next name server, and
+ *  start the timer after which they are sent again.
+ */
+void NativeDNSResolverSockets::SendQueries(Query & query)
+{
+    const IPAddress & server = mServers[query.sends % mNumServers];
+
+    query.sends++;
+    query.failed = 0;
+
+    for (uint8_t type = 0; type < kQueryType_Count; type++)
+    {
+        if ((query.pending & (1 << type)) && SendQuery(query, type, server) != INET_NO_ERROR)
+        {
+            // E.g. the server is not reachable; retrying after the timeout moves on to the next one.
+            query.serverFailed = true;
+        }
+    }
+
+    mInet->SystemLayer()->StartTimer(mTimeoutMS, HandleTimeout, &query);
+}
+
+INET_ERROR NativeDNSResolverSockets::SendQuery(Query & query, uint8_t type, const IPAddress & server)
+{
+    INET_ERROR err         = INET_NO_ERROR;
+    PacketBuffer * msg     = PacketBuffer::New();
+    UDPEndPoint * endPoint = GetEndPoint(query, server.Type());
+    uint8_t * p;
+
+    VerifyOrExit(msg != NULL, err = INET_ERROR_NO_MEMORY);
+    VerifyOrExit(msg->AvailableDataLength() >= kMaxQueryLength, err = INET_ERROR_NO_MEMORY);
+    VerifyOrExit(endPoint != NULL, err = INET_ERROR_NO_ENDPOINTS);
+
+    p = msg->Start();
+
+    BigEndian::Write16(p, query.ids[type]);
+    BigEndian::Write16(p, kFlag_RecursionOK);
+    BigEndian::Write16(p, 1); // QDCOUNT
+    BigEndian::Write16(p, 0); // ANCOUNT
+    BigEndian::Write16(p, 0); // NSCOUNT
+    BigEndian::Write16(p, 0); // ARCOUNT
+
+    // The name was checked when the lookup started.
+    for (const char * label = query.hostName; *label != 0;)
+    {
+        const char * const dot  = strchr(label, '.');
+        const size_t labelLength = (dot != NULL) ? static_cast<size_t>(dot - label) : strlen(label);
+
+        *p++ = static_cast<uint8_t>(labelLength);
+        memcpy(p, label, labelLength);
+        p += labelLength;
+        label += labelLength + (dot != NULL);
+    }
+    *p++ = 0;
+
+    BigEndian::Write16(p, sRRTypes[type]);
+    BigEndian::Write16(p, kRRClass_IN);
+
+    msg->SetDataLength(static_cast<uint16_t>(p - msg->Start()));
+
+    err = endPoint->SendTo(server, mPort, msg);
+    msg = NULL;
+
+exit:
+    PacketBuffer::Free(msg);
+    return err;
+}
+
+/**
+ *  Return the endpoint of a lookup, opening it if needed, or NULL if it
+ *  could not be opened. An endpoint opened for servers of the other
+ *  address type is replaced.
+ */
+UDPEndPoint * NativeDNSResolverSockets::GetEndPoint(Query & query, IPAddressType addrType)
+{
+    INET_ERROR err = INET_NO_ERROR;
+
+    if (query.endPoint != NULL && query.endPointType != addrType)
+        CloseEndPoint(query);
+
+    VerifyOrExit(query.endPoint == NULL, );
+
+    err = mInet->NewUDPEndPoint(&query.endPoint);
+    SuccessOrExit(err);
+
+    // Port 0 lets the system pick an ephemeral port, which a spoofed answer has to guess along with the query ID.
+    err = query.endPoint->Bind(addrType, IPAddress::Any, 0);
+    SuccessOrExit(err);
+
+    err = query.endPoint->Listen();
+    SuccessOrExit(err);
+
+    query.endPoint->AppState          = &query;
+    query.endPoint->OnMessageReceived = HandleMessageReceived;
+    query.endPointType                = addrType;
+
+exit:
+    if (err != INET_NO_ERROR)
+    {
+        ChipLogError(Inet, "DNS client endpoint failed: %s", ErrorStr(err));
+        if (query.endPoint != NULL)
+        {
+            query.endPoint->Free();
+            query.endPoint = NULL;
+        }
+    }
+
+    return query.endPoint;
+}
+
+void NativeDNSResolverSockets::CloseEndPoint(Query & query)
+{
+    if (query.endPoint != NULL)
+    {
+        query.endPoint->Close();
+        query.endPoint->Free();
+        query.endPoint = NULL;
+    }
+}
+
+/**
+ *  Give each query type of a lookup an ID read from the random device.
+ */
+INET_ERROR NativeDNSResolverSockets::GetRandomIds(Query & query)
+{
+    ssize_t len;
+
+    do
+        len = read(mRandomFD, query.ids, sizeof(query.ids));
+    while (len < 0 && errno == EINTR);
+
+    if (len < 0)
+        return chip::System::MapErrorPOSIX(errno);
+
+    return (len == sizeof(query.ids)) ? INET_NO_ERROR : INET_ERROR_UNEXPECTED_EVENT;
+}
+
+void NativeDNSResolverSockets::HandleMessageReceived(IPEndPointBasis * endPoint, PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    Query & query = *static_cast<Query *>(endPoint->AppState);
+
+    // Only answers from the name servers are taken into account; messages over UDP fit in one buffer.
+    if (pktInfo != NULL && query.client->IsServer(pktInfo->SrcAddress, pktInfo->SrcPort) && msg->Next() == NULL)
+    {
+        query.client->HandleResponse(query, msg->Start(), msg->DataLength());
+    }
+
+    PacketBuffer::Free(msg);
+}
+
+void NativeDNSResolverSockets::HandleResponse(Query & query, const uint8_t * msg, uint16_t msgLen)
+{
+    char name[NL_DNS_HOSTNAME_MAX_LEN + 1];
+    uint8_t type    = 0;
+    uint16_t offset = kHeaderLength;
+    uint16_t id, flags;
+
+    VerifyOrExit(msgLen >= kHeaderLength, );
+
+    id    = BigEndian::Get16(&msg[0]);
+    flags = BigEndian::Get16(&msg[2]);
+
+    VerifyOrExit((flags & kFlag_Response) != 0 && BigEndian::Get16(&msg[4]) == 1, );
+
+    // Answers may still be queued once the lookup has completed.
+    VerifyOrExit(query.resolver != NULL, );
+
+    for (type = 0; type < kQueryType_Count; type++)
+    {
+        if ((query.pending & (1 << type)) && query.ids[type] == id)
+            break;
+    }
+
+    VerifyOrExit(type < kQueryType_Count, );
+
+    // The answer must be to the very question asked.
+    VerifyOrExit(ReadName(msg, msgLen, offset, name) && strcasecmp(name, query.hostName) == 0, );
+    VerifyOrExit(offset + 4 <= msgLen, );
+    VerifyOrExit(BigEndian::Get16(&msg[offset]) == sRRTypes[type] && BigEndian::Get16(&msg[offset + 2]) == kRRClass_IN, );
+    offset += 4;
+
+    switch (flags & kRCodeMask)
+    {
+    case kRCode_NoError:
+        // There is no fallback to TCP: a truncated answer gives the addresses it holds.
+        if (flags & kFlag_Truncated)
+            ChipLogDetail(Inet, "DNS answer for %s truncated", query.hostName);
+        ParseAnswers(query, type, msg, msgLen, offset, BigEndian::Get16(&msg[6]));
+        query.pending &= ~(1 << type);
+        break;
+
+    case kRCode_NXDomain:
+        // The name does not exist, whatever the address type.
+        query.nameNotFound = true;
+        query.pending      = 0;
+        break;
+
+    default:
+        // Once the server failed every query it was sent, move on to the next one right away.
+        query.serverFailed = true;
+        query.failed |= (1 << type);
+        if ((query.pending & ~query.failed) == 0)
+        {
+            mInet->SystemLayer()->CancelTimer(HandleTimeout, &query);
+            HandleTimeout(mInet->SystemLayer(), &query, CHIP_SYSTEM_NO_ERROR);
+        }
+        ExitNow();
+    }
+
+    if (query.pending == 0)
+        Complete(query);
+
+exit:
+    return;
+}
+
+/**
+ *  Collect the addresses of a query type from the answer section of a
+ *  response, following the aliases of the name asked.
+ */
+void NativeDNSResolverSockets::ParseAnswers(Query & query, uint8_t type, const uint8_t * msg, uint16_t msgLen, uint16_t offset,
+                                            uint16_t numAnswers)
+{
+    const uint16_t addrLength = (type == kQueryType_A) ? 4 : 16;
+    char target[NL_DNS_HOSTNAME_MAX_LEN + 1];
+    char owner[NL_DNS_HOSTNAME_MAX_LEN + 1];
+
+    strcpy(target, query.hostName);
+
+    for (uint16_t i = 0; i < numAnswers; i++)
+    {
+        uint16_t rrType, rrClass, rdLength;
+
+        VerifyOrExit(ReadName(msg, msgLen, offset, owner), );
+        VerifyOrExit(offset + 10 <= msgLen, );
+
+        rrType   = BigEndian::Get16(&msg[offset]);
+        rrClass  = BigEndian::Get16(&msg[offset + 2]);
+        rdLength = BigEndian::Get16(&msg[offset + 8]);
+        offset += 10;
+
+        VerifyOrExit(offset + rdLength <= msgLen, );
+
+        if (rrClass == kRRClass_IN && strcasecmp(owner, target) == 0)
+        {
+            if (rrType == kRRType_CNAME)
+            {
+                uint16_t nameOffset = offset;
+
+                // Servers list the aliases in order, before the addresses.
+                VerifyOrExit(ReadName(msg, msgLen, nameOffset, target), );
+            }
+            else if (rrType == sRRTypes[type] && rdLength == addrLength && query.numAddrs[type] < INET_CONFIG_MAX_DNS_ADDRS)
+            {
+                IPAddress & addr = query.addrs[type][query.numAddrs[type]++];
+
+#if INET_CONFIG_ENABLE_IPV4
+                if (type == kQueryType_A)
+                {
+                    struct in_addr addr4;
+
+                    memcpy(&addr4, &msg[offset], sizeof(addr4));
+                    addr = IPAddress::FromIPv4(addr4);
+                }
+                else
+                {
+                    struct in6_addr addr6;
+
+                    memcpy(&addr6, &msg[offset], sizeof(addr6));
+                    addr = IPAddress::FromIPv6(addr6);
+                }
+#else  // !INET_CONFIG_ENABLE_IPV4
+                struct in6_addr addr6;
+
+                memcpy(&addr6, &msg[offset], sizeof(addr6));
+                addr = IPAddress::FromIPv6(addr6);
+#endif // !INET_CONFIG_ENABLE_IPV4
+            }
+        }
+
+        offset += rdLength;
+    }
+
+exit:
+    return;
+}
+
+/**
+ *  Hand the addresses found to the lookup, in the order its address family
+ *  option asks for, and release its DNSResolver object.
+ */
+void NativeDNSResolverSockets::Complete(Query & query)
+{
+    DNSResolver & resolver = *query.resolver;
+    uint8_t primaryType    = kQueryType_AAAA;
+    uint8_t secondaryType  = kQueryType_Count;
+    INET_ERROR err         = INET_NO_ERROR;
+
+#if INET_CONFIG_ENABLE_IPV4
+    // Like ProcessGetAddrInfoResult(): IPv4 addresses come first unless IPv6 ones are asked for.
+    switch (resolver.DNSOptions & kDNSOption_AddrFamily_Mask)
+    {
+    case kDNSOption_AddrFamily_Any:
+    case kDNSOption_AddrFamily_IPv4Preferred:
+        primaryType   = kQueryType_A;
+        secondaryType = kQueryType_AAAA;
+        break;
+    case kDNSOption_AddrFamily_IPv4Only:
+        primaryType = kQueryType_A;
+        break;
+    case kDNSOption_AddrFamily_IPv6Preferred:
+        secondaryType = kQueryType_A;
+        break;
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    uint8_t numPrimaryAddrs         = query.numAddrs[primaryType];
+    const uint8_t numSecondaryAddrs = (secondaryType != kQueryType_Count) ? query.numAddrs[secondaryType] : 0;
+
+    // Make room for at least one secondary address, which the application would try if the primary ones fail.
+    if (numPrimaryAddrs + numSecondaryAddrs > resolver.MaxAddrs && resolver.MaxAddrs > 1 && numPrimaryAddrs > 0 &&
+        numSecondaryAddrs > 0 && (resolver.DNSOptions & kDNSOption_AddrFamily_Mask) != kDNSOption_AddrFamily_Any)
+    {
+        numPrimaryAddrs = ::chip::min(numPrimaryAddrs, (uint8_t)(resolver.MaxAddrs - 1));
+    }
+
+    for (uint8_t i = 0; i < numPrimaryAddrs && resolver.NumAddrs < resolver.MaxAddrs; i++)
+        resolver.AddrArray[resolver.NumAddrs++] = query.addrs[primaryType][i];
+
+    for (uint8_t i = 0; i < numSecondaryAddrs && resolver.NumAddrs < resolver.MaxAddrs; i++)
+        resolver.AddrArray[resolver.NumAddrs++] = query.addrs[secondaryType][i];
+
+    if (resolver.NumAddrs == 0)
+    {
+        // No answer at all, or failures only, may well be transient.
+        err = (query.nameNotFound || (query.pending == 0 && !query.serverFailed)) ? INET_ERROR_HOST_NOT_FOUND
+                                                                                    : INET_ERROR_DNS_TRY_AGAIN;
+    }
+
+    // The application may start another lookup from its callback.
+    Free(query);
+
+    if (resolver.OnComplete != NULL)
+        resolver.OnComplete(resolver.AppState, err, resolver.NumAddrs, resolver.AddrArray);
+
+    resolver.Release();
+}
+
+void NativeDNSResolverSockets::Free(Query & query)
+{
+    mInet->SystemLayer()->CancelTimer(HandleTimeout, &query);
+    CloseEndPoint(query);
+    query.resolver = NULL;
+}
+
+bool NativeDNSResolverSockets::IsServer(const IPAddress & addr, uint16_t port) const
+{
+    if (port != mPort)
+        return false;
+
+    for (uint8_t i = 0; i < mNumServers; i++)
+    {
+        if (mServers[i] == addr)
+            return true;
+    }
+
+    return false;
+}
+
+void NativeDNSResolverSockets::HandleTimeout(chip::System::Layer * aLayer, void * aAppState, chip::System::Error aError)
+{
+    Query & query                     = *static_cast<Query *>(aAppState);
+    NativeDNSResolverSockets & client = *query.client;
+
+    if (query.sends < client.mAttempts * client.mNumServers)
+        client.SendQueries(query);
+    else
+        client.Complete(query);
+}
+
+} // namespace Inet
+} // namespace chip
+
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
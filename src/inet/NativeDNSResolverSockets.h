@@ -0,0 +1,152 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines NativeDNSResolverSockets, the DNS client that
+ *      resolves host names from the event loop of InetLayer.
+ *
+ */
+#ifndef _NATIVE_DNS_SOCKETS_H_
+#define _NATIVE_DNS_SOCKETS_H_
+
+#include <inet/IPAddress.h>
+#include <inet/InetError.h>
+
+#if INET_CONFIG_ENABLE_DNS_RESOLVER
+#include <inet/DNSResolver.h>
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER
+
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
+#if !INET_CONFIG_ENABLE_UDP_ENDPOINT
+#error "INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS requires INET_CONFIG_ENABLE_UDP_ENDPOINT"
+#endif
+
+namespace chip {
+namespace Inet {
+
+class InetLayer;
+class IPEndPointBasis;
+class IPPacketInfo;
+class UDPEndPoint;
+
+/**
+ *  @class NativeDNSResolverSockets
+ *
+ *  @brief
+ *    This is an internal class to InetLayer that resolves host names by
+ *    sending DNS queries to the name servers over UDP endpoints, and
+ *    retransmitting them on System::Layer timers, so that lookups need
+ *    neither threads nor getaddrinfo(). There is no public interface
+ *    available for the application layer.
+ *
+ *  @details
+ *    A lookup sends an A and/or an AAAA query, depending on its address
+ *    family option, to the first name server. Queries that remain
+ *    unanswered when the timeout expires, or that the server failed to
+ *    answer, are sent again to the next server, until every server has
+ *    been asked the configured number of attempts.
+ *
+ *    As RFC 5452 recommends against spoofed answers, each lookup sends its
+ *    queries from its own endpoint, bound to an ephemeral port chosen by
+ *    the system, and gives them IDs read from the system random device.
+ *
+ *    The name servers and options are read from resolv.conf when
+ *    InetLayer is initialized; the loopback address is used if the file
+ *    names no server.
+ *
+ *    Everything happens on the thread running the event loop.
+ */
+class NativeDNSResolverSockets
+{
+    friend class InetLayer;
+    friend class DNSResolver;
+
+private:
+    enum
+    {
+        kQueryType_A    = 0,
+        kQueryType_AAAA = 1,
+        kQueryType_Count
+    };
+
+    struct Query
+    {
+        NativeDNSResolverSockets * client; ///< The client the query belongs to, for its timer and endpoint.
+        DNSResolver * resolver;            ///< Lookup being resolved, or NULL if the query is free.
+        UDPEndPoint * endPoint;            ///< Endpoint the queries are sent from; opened when first needed.
+        IPAddressType endPointType;        ///< Address type the endpoint is bound to.
+        uint16_t ids[kQueryType_Count];    ///< DNS message ID of each query type.
+        uint8_t pending;                   ///< Query types still waiting for an answer, as a bit mask.
+        uint8_t sends;                     ///< Number of times the pending queries have been sent.
+        uint8_t failed;                    ///< Query types the current server failed to answer, as a bit mask.
+        bool nameNotFound;                 ///< Whether a server answered that the name does not exist.
+        bool serverFailed;                 ///< Whether a server failed to answer, or a query could not be sent.
+        uint8_t numAddrs[kQueryType_Count];
+        IPAddress addrs[kQueryType_Count][INET_CONFIG_MAX_DNS_ADDRS];
+        char hostName[NL_DNS_HOSTNAME_MAX_LEN + 1];
+    };
+
+    INET_ERROR Init(InetLayer & inet);
+    INET_ERROR Shutdown(void);
+
+    INET_ERROR SetServers(const IPAddress * servers, uint8_t numServers, uint16_t port, uint32_t timeoutMS, uint8_t attempts);
+
+    INET_ERROR Resolve(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen, uint8_t options, uint8_t maxAddrs,
+                       IPAddress * addrArray, DNSResolver::OnResolveCompleteFunct onComplete, void * appState);
+    void Cancel(DNSResolver & resolver);
+
+    void ReadResolvConf(void);
+    bool ResolveLocalhost(Query & query);
+
+    void SendQueries(Query & query);
+    INET_ERROR SendQuery(Query & query, uint8_t type, const IPAddress & server);
+    UDPEndPoint * GetEndPoint(Query & query, IPAddressType addrType);
+    void CloseEndPoint(Query & query);
+    INET_ERROR GetRandomIds(Query & query);
+
+    void HandleResponse(Query & query, const uint8_t * msg, uint16_t msgLen);
+    void ParseAnswers(Query & query, uint8_t type, const uint8_t * msg, uint16_t msgLen, uint16_t offset, uint16_t numAnswers);
+    void Complete(Query & query);
+    void Free(Query & query);
+
+    bool IsServer(const IPAddress & addr, uint16_t port) const;
+
+    static void HandleMessageReceived(IPEndPointBasis * endPoint, chip::System::PacketBuffer * msg, const IPPacketInfo * pktInfo);
+    static void HandleTimeout(chip::System::Layer * aLayer, void * aAppState, chip::System::Error aError);
+
+    InetLayer * mInet;
+    int mRandomFD; ///< Descriptor of the random device the query IDs are read from.
+    IPAddress mServers[INET_CONFIG_NATIVE_DNS_MAX_SERVERS];
+    uint8_t mNumServers;
+    uint8_t mAttempts;
+    uint16_t mPort;
+    uint32_t mTimeoutMS;
+    Query mQueries[INET_CONFIG_NUM_DNS_RESOLVERS];
+};
+
+} // namespace Inet
+} // namespace chip
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#endif // !defined(_NATIVE_DNS_SOCKETS_H_)
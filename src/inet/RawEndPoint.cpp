@@ -72,8 +72,6 @@ namespace Inet {
 
 using chip::System::PacketBuffer;
 
-chip::System::ObjectPool<RawEndPoint, INET_CONFIG_NUM_RAW_ENDPOINTS> RawEndPoint::sPool;
-
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 /*
  * Note that for LwIP InterfaceId is already defined to be 'struct
@@ -354,6 +352,7 @@ INET_ERROR RawEndPoint::BindIPv6LinkLocal(InterfaceId intf, IPAddress addr)
 
 optfail:
     res = chip::System::MapErrorPOSIX(errno);
+    UnwatchSocket();
     ::close(mSocket);
     mSocket   = INET_INVALID_SOCKET_FD;
     mAddrType = kIPAddressType_Unknown;
@@ -387,10 +386,6 @@ INET_ERROR RawEndPoint::Listen(void)
 {
     INET_ERROR res = INET_NO_ERROR;
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    chip::System::Layer & lSystemLayer = SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
-
     if (mState == kState_Listening)
     {
         res = INET_NO_ERROR;
@@ -424,8 +419,8 @@ INET_ERROR RawEndPoint::Listen(void)
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
-    // Wake the thread calling select so that it starts selecting on the new socket.
-    lSystemLayer.WakeSelect();
+    // Wake the thread waiting for I/O so that it starts waiting on the new socket.
+    RefreshSocketWatch();
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -477,6 +472,8 @@ void RawEndPoint::Close(void)
         {
             chip::System::Layer & lSystemLayer = SystemLayer();
 
+            UnwatchSocket();
+
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
@@ -673,7 +670,8 @@ INET_ERROR RawEndPoint::SendMsg(const IPPacketInfo * pktInfo, chip::System::Pack
 
     // Send the message to the specified address/port.
     {
-        err_t lwipErr = ERR_VAL;
+        err_t lwipErr          = ERR_VAL;
+        const uint16_t lLength = msg->TotalLength();
 
 #if LWIP_VERSION_MAJOR > 1 || LWIP_VERSION_MINOR >= 5
         ip_addr_t ipAddr = addr.ToLwIPAddr();
@@ -698,6 +696,8 @@ INET_ERROR RawEndPoint::SendMsg(const IPPacketInfo * pktInfo, chip::System::Pack
 
         if (lwipErr != ERR_OK)
             res = chip::System::MapErrorLwIP(lwipErr);
+        else
+            CountSent(lLength);
     }
 
     // Unlock LwIP stack
@@ -861,6 +861,11 @@ exit:
 void RawEndPoint::Init(InetLayer * inetLayer, IPVersion ipVer, IPProtocol ipProto)
 {
     IPEndPointBasis::Init(inetLayer);
+    InitTrafficCounters(chip::System::Stats::kInetLayer_RawPacketsSent);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    InitSocketWatch(*this);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 
     IPVer   = ipVer;
     IPProto = ipProto;
@@ -1116,6 +1121,7 @@ SocketEvents RawEndPoint::PrepareIO(void)
 
 void RawEndPoint::HandlePendingIO(void)
 {
+    SYSTEM_LOOP_METRICS_SCOPE(kSource_IO, "RawEndPoint");
     if (mState == kState_Listening && OnMessageReceived != NULL && mPendingIO.IsReadable())
     {
         const uint16_t lPort = 0;
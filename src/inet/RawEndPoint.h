@@ -51,6 +51,7 @@ class IPPacketInfo;
 class DLL_EXPORT RawEndPoint : public IPEndPointBasis
 {
     friend class InetLayer;
+    friend class EndPointBasis;
 
 public:
     /**
@@ -88,8 +89,6 @@ private:
     RawEndPoint(const RawEndPoint &); // not defined
     ~RawEndPoint(void);               // not defined
 
-    static chip::System::ObjectPool<RawEndPoint, INET_CONFIG_NUM_RAW_ENDPOINTS> sPool;
-
     void Init(InetLayer * inetLayer, IPVersion ipVer, IPProtocol ipProto);
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
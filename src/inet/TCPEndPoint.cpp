@@ -54,6 +54,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -109,8 +110,6 @@ namespace Inet {
 
 using chip::System::PacketBuffer;
 
-chip::System::ObjectPool<TCPEndPoint, INET_CONFIG_NUM_TCP_ENDPOINTS> TCPEndPoint::sPool;
-
 INET_ERROR TCPEndPoint::Bind(IPAddressType addrType, IPAddress addr, uint16_t port, bool reuseAddr)
 {
     INET_ERROR res = INET_NO_ERROR;
@@ -254,10 +253,6 @@ INET_ERROR TCPEndPoint::Listen(uint16_t backlog)
 {
     INET_ERROR res = INET_NO_ERROR;
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    chip::System::Layer & lSystemLayer = SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
-
     if (State != kState_Bound)
         return INET_ERROR_INCORRECT_STATE;
 
@@ -278,8 +273,8 @@ INET_ERROR TCPEndPoint::Listen(uint16_t backlog)
     if (listen(mSocket, backlog) != 0)
         res = chip::System::MapErrorPOSIX(errno);
 
-    // Wake the thread calling select so that it recognizes the new socket.
-    lSystemLayer.WakeSelect();
+    // Wake the thread waiting for I/O so that it recognizes the new socket.
+    RefreshSocketWatch();
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -298,10 +293,6 @@ INET_ERROR TCPEndPoint::Connect(IPAddress addr, uint16_t port, InterfaceId intf)
 {
     INET_ERROR res = INET_NO_ERROR;
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    chip::System::Layer & lSystemLayer = SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
-
     if (State != kState_Ready && State != kState_Bound)
         return INET_ERROR_INCORRECT_STATE;
 
@@ -499,8 +490,8 @@ INET_ERROR TCPEndPoint::Connect(IPAddress addr, uint16_t port, InterfaceId intf)
     else
         State = kState_Connecting;
 
-    // Wake the thread calling select so that it recognizes the new socket.
-    lSystemLayer.WakeSelect();
+    // Wake the thread waiting for I/O so that it recognizes the new socket.
+    RefreshSocketWatch();
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -727,29 +718,35 @@ INET_ERROR TCPEndPoint::Send(PacketBuffer * data, bool push)
     if (push)
         res = DriveSending();
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    // Unsent data leaves the socket waiting to become writable.
+    if (mSocket != INET_INVALID_SOCKET_FD)
+        SystemLayer().RefreshWatch(mSocketWatch);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     return res;
 }
 
 void TCPEndPoint::DisableReceive()
 {
     ReceiveEnabled = false;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    SystemLayer().RefreshWatch(mSocketWatch);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 void TCPEndPoint::EnableReceive()
 {
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    chip::System::Layer & lSystemLayer = SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
-
     ReceiveEnabled = true;
 
     DriveReceiving();
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
-    // Wake the thread calling select so that it can include the socket
-    // in the select read fd_set.
-    lSystemLayer.WakeSelect();
+    // Wake the thread waiting for I/O so that it can include the socket
+    // in the set of sockets waited on for reading.
+    RefreshSocketWatch();
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
@@ -1169,8 +1166,13 @@ bool TCPEndPoint::IsConnected(int state)
 void TCPEndPoint::Init(InetLayer * inetLayer)
 {
     InitEndPointBasis(*inetLayer);
+    InitTrafficCounters(chip::System::Stats::kInetLayer_TCPPacketsSent);
     ReceiveEnabled = true;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    InitSocketWatch(*this);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     // Initialize to zero for using system defaults.
     mConnectTimeoutMsecs = 0;
 
@@ -1255,6 +1257,8 @@ INET_ERROR TCPEndPoint::DriveSending()
                     err = chip::System::MapErrorLwIP(lwipErr);
                     break;
                 }
+
+                CountSent(sendLen);
             } while (canSend);
 
             // Call LwIP to send the queued data.
@@ -1306,9 +1310,31 @@ INET_ERROR TCPEndPoint::DriveSending()
 
     while (mSendQueue != NULL)
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        struct iovec sendIOV[INET_CONFIG_TCP_SEND_IOV_MAX];
+        struct msghdr sendHeader;
+        size_t numIOV  = 0;
+        size_t sendLen = 0;
+
+        // Gather the head of the send queue, up to what OnDataSent can report at once.
+        for (PacketBuffer * buf = mSendQueue; buf != NULL && numIOV < INET_CONFIG_TCP_SEND_IOV_MAX && sendLen < UINT16_MAX;
+             buf = buf->Next())
+        {
+            size_t bufLen = buf->DataLength();
+
+            if (bufLen > UINT16_MAX - sendLen)
+                bufLen = UINT16_MAX - sendLen;
 
-        ssize_t lenSent = send(mSocket, mSendQueue->Start(), (size_t) bufLen, sendFlags);
+            sendIOV[numIOV].iov_base = buf->Start();
+            sendIOV[numIOV].iov_len  = bufLen;
+            numIOV++;
+            sendLen += bufLen;
+        }
+
+        memset(&sendHeader, 0, sizeof(sendHeader));
+        sendHeader.msg_iov    = sendIOV;
+        sendHeader.msg_iovlen = numIOV;
+
+        ssize_t lenSent = sendmsg(mSocket, &sendHeader, sendFlags);
 
         if (lenSent == -1)
         {
@@ -1319,11 +1345,21 @@ INET_ERROR TCPEndPoint::DriveSending()
 
         // Mark the connection as being active.
         MarkActive();
+        CountSent(static_cast<size_t>(lenSent));
 
-        if (lenSent < bufLen)
-            mSendQueue->ConsumeHead(lenSent);
-        else
-            mSendQueue = PacketBuffer::FreeHead(mSendQueue);
+        // Free the buffers that were sent entirely, and consume what was sent of the next one.
+        {
+            size_t lenLeft = static_cast<size_t>(lenSent);
+
+            while (mSendQueue != NULL && mSendQueue->DataLength() <= lenLeft)
+            {
+                lenLeft -= mSendQueue->DataLength();
+                mSendQueue = PacketBuffer::FreeHead(mSendQueue);
+            }
+
+            if (lenLeft > 0)
+                mSendQueue->ConsumeHead(static_cast<uint16_t>(lenLeft));
+        }
 
         if (OnDataSent != NULL)
             OnDataSent(this, (uint16_t) lenSent);
@@ -1361,7 +1397,8 @@ INET_ERROR TCPEndPoint::DriveSending()
         }
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
-        if (lenSent < bufLen)
+        // The socket buffer is full.
+        if (static_cast<size_t>(lenSent) < sendLen)
             break;
     }
 
@@ -1540,6 +1577,8 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
                     ChipLogError(Inet, "SO_LINGER: %d", errno);
             }
 
+            UnwatchSocket();
+
             if (close(mSocket) != 0 && err == INET_NO_ERROR)
                 err = chip::System::MapErrorPOSIX(errno);
             mSocket = INET_INVALID_SOCKET_FD;
@@ -1896,6 +1935,8 @@ void TCPEndPoint::HandleDataReceived(PacketBuffer * buf)
         // the queue, compact the data into the head buffer.
         if (buf != NULL)
         {
+            CountReceived(buf->TotalLength());
+
             if (mRcvQueue == NULL)
                 mRcvQueue = buf;
             else
@@ -2251,6 +2292,8 @@ INET_ERROR TCPEndPoint::GetSocket(IPAddressType addrType)
             }
         }
 #endif // defined(SO_NOSIGPIPE)
+
+        WatchSocket();
     }
     else if (mAddrType != addrType)
         return INET_ERROR_INCORRECT_STATE;
@@ -2280,6 +2323,8 @@ SocketEvents TCPEndPoint::PrepareIO()
 
 void TCPEndPoint::HandlePendingIO()
 {
+    SYSTEM_LOOP_METRICS_SCOPE(kSource_IO, "TCPEndPoint");
+
     // Prevent the end point from being freed while in the middle of a callback.
     Retain();
 
@@ -2356,8 +2401,55 @@ void TCPEndPoint::ReceiveData()
         return;
     }
 
+    // Buffers after rcvBuf, filled by the same call as far as the receive budget goes.
+    enum
+    {
+        kMaxExtraBufs = INET_CONFIG_TCP_RECV_BUDGET / CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX + 1
+    };
+    PacketBuffer * extraBufs[kMaxExtraBufs];
+    struct iovec rcvIOV[kMaxExtraBufs + 1];
+    size_t numExtraBufs = 0;
+    size_t rcvSpace     = rcvBuf->AvailableDataLength();
+
+    rcvIOV[0].iov_base = rcvBuf->Start() + rcvBuf->DataLength();
+    rcvIOV[0].iov_len  = rcvSpace;
+
+#if INET_CONFIG_TCP_RECV_BUDGET > 0
+    // Only allocate the extra buffers needed for the data already queued on the socket, up to the budget.
+    int pendingLen   = 0;
+    size_t rcvWanted = 0;
+
+    if (ioctl(mSocket, FIONREAD, &pendingLen) == 0 && pendingLen > 0)
+        rcvWanted = static_cast<size_t>(pendingLen);
+
+    if (rcvWanted > INET_CONFIG_TCP_RECV_BUDGET)
+        rcvWanted = INET_CONFIG_TCP_RECV_BUDGET;
+
+    while (rcvSpace < rcvWanted && numExtraBufs < kMaxExtraBufs)
+    {
+        PacketBuffer * extraBuf = PacketBuffer::New(0);
+
+        // Short of buffers, receive less rather than fail.
+        if (extraBuf == NULL)
+            break;
+
+        extraBufs[numExtraBufs]           = extraBuf;
+        rcvIOV[numExtraBufs + 1].iov_base = extraBuf->Start();
+        rcvIOV[numExtraBufs + 1].iov_len  = extraBuf->AvailableDataLength();
+        rcvSpace += extraBuf->AvailableDataLength();
+        numExtraBufs++;
+    }
+#endif // INET_CONFIG_TCP_RECV_BUDGET > 0
+
     // Attempt to receive data from the socket.
-    ssize_t rcvLen = recv(mSocket, rcvBuf->Start() + rcvBuf->DataLength(), rcvBuf->AvailableDataLength(), 0);
+    ssize_t rcvLen  = readv(mSocket, rcvIOV, static_cast<int>(numExtraBufs + 1));
+    size_t extraLen = 0;
+
+    if (rcvLen > static_cast<ssize_t>(rcvIOV[0].iov_len))
+    {
+        extraLen = static_cast<size_t>(rcvLen) - rcvIOV[0].iov_len;
+        rcvLen   = static_cast<ssize_t>(rcvIOV[0].iov_len);
+    }
 
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
     INET_ERROR err;
@@ -2366,6 +2458,9 @@ void TCPEndPoint::ReceiveData()
     err = CheckConnectionProgress(isProgressing);
     if (err != INET_NO_ERROR)
     {
+        for (size_t i = 0; i < numExtraBufs; i++)
+            PacketBuffer::Free(extraBufs[i]);
+
         DoClose(err, false);
 
         return;
@@ -2403,13 +2498,16 @@ void TCPEndPoint::ReceiveData()
             PacketBuffer::Free(rcvBuf);
         }
 
+        for (size_t i = 0; i < numExtraBufs; i++)
+            PacketBuffer::Free(extraBufs[i]);
+
         if (systemErrno == EAGAIN)
         {
-            // Note: in this case, we opt to not retry the recv call,
+            // Note: in this case, we opt to not retry the readv call,
             // and instead we expect that the read flags will get
             // reset correctly upon a subsequent return from the
             // select call.
-            ChipLogError(Inet, "recv: EAGAIN, will retry");
+            ChipLogError(Inet, "readv: EAGAIN, will retry");
 
             return;
         }
@@ -2428,6 +2526,9 @@ void TCPEndPoint::ReceiveData()
             if (isNewBuf)
                 PacketBuffer::Free(rcvBuf);
 
+            for (size_t i = 0; i < numExtraBufs; i++)
+                PacketBuffer::Free(extraBufs[i]);
+
             // If in the Connected state and the app has provided an OnPeerClose callback,
             // enter the ReceiveShutdown state.  Providing an OnPeerClose callback allows
             // the app to decide whether to keep the send side of the connection open after
@@ -2446,6 +2547,7 @@ void TCPEndPoint::ReceiveData()
         // Otherwise, add the new data onto the receive queue.
         else if (isNewBuf)
         {
+            CountReceived(static_cast<size_t>(rcvLen));
             rcvBuf->SetDataLength(rcvBuf->DataLength() + (uint16_t) rcvLen);
             if (mRcvQueue == NULL)
                 mRcvQueue = rcvBuf;
@@ -2454,7 +2556,32 @@ void TCPEndPoint::ReceiveData()
         }
 
         else
+        {
+            CountReceived(static_cast<size_t>(rcvLen));
             rcvBuf->SetDataLength(rcvBuf->DataLength() + (uint16_t) rcvLen, mRcvQueue);
+        }
+
+        // Chain whatever overflowed into the extra buffers, and free those left empty.
+        if (rcvLen > 0)
+        {
+            CountReceived(extraLen);
+
+            for (size_t i = 0; i < numExtraBufs; i++)
+            {
+                PacketBuffer * extraBuf = extraBufs[i];
+                const size_t len        = (extraLen < extraBuf->AvailableDataLength()) ? extraLen : extraBuf->AvailableDataLength();
+
+                if (len == 0)
+                {
+                    PacketBuffer::Free(extraBuf);
+                    continue;
+                }
+
+                extraBuf->SetDataLength(static_cast<uint16_t>(len));
+                mRcvQueue->AddToEnd(extraBuf);
+                extraLen -= len;
+            }
+        }
     }
 
     // Drive any received data into the app.
@@ -2524,6 +2651,7 @@ void TCPEndPoint::HandleIncomingConnection()
 #else  // !INET_CONFIG_ENABLE_IPV4
         conEP->mAddrType = kIPAddressType_IPv6;
 #endif // !INET_CONFIG_ENABLE_IPV4
+        conEP->WatchSocket();
         conEP->Retain();
 
         // Call the app's callback function.
@@ -49,6 +49,7 @@ class InetLayer;
 class DLL_EXPORT TCPEndPoint : public EndPointBasis
 {
     friend class InetLayer;
+    friend class EndPointBasis;
 
 public:
     /** Control switch indicating whether the application is receiving data. */
@@ -550,8 +551,6 @@ public:
 #endif // INET_CONFIG_ENABLE_TCP_SEND_IDLE_CALLBACKS
 
 private:
-    static chip::System::ObjectPool<TCPEndPoint, INET_CONFIG_NUM_TCP_ENDPOINTS> sPool;
-
     chip::System::PacketBuffer * mRcvQueue;
     chip::System::PacketBuffer * mSendQueue;
 #if INET_TCP_IDLE_CHECK_INTERVAL > 0
@@ -45,8 +45,6 @@ namespace Inet {
 
 using chip::System::PacketBuffer;
 
-chip::System::ObjectPool<TunEndPoint, INET_CONFIG_NUM_TUN_ENDPOINTS> TunEndPoint::sPool;
-
 using namespace chip::Encoding;
 
 /**
@@ -63,6 +61,11 @@ using namespace chip::Encoding;
 void TunEndPoint::Init(InetLayer * inetLayer)
 {
     InitEndPointBasis(*inetLayer);
+    InitTrafficCounters(chip::System::Stats::kInetLayer_TunPacketsSent);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    InitSocketWatch(*this);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 /**
@@ -427,14 +430,16 @@ InterfaceId TunEndPoint::GetTunnelInterfaceId(void)
 /* Function for sending the IPv6 packets over LwIP */
 INET_ERROR TunEndPoint::TunDevSendMessage(PacketBuffer * msg)
 {
-    INET_ERROR ret  = INET_NO_ERROR;
-    struct pbuf * p = NULL;
-    err_t err       = ERR_OK;
+    INET_ERROR ret   = INET_NO_ERROR;
+    struct pbuf * p  = NULL;
+    err_t err        = ERR_OK;
+    uint16_t lLength = 0;
 
     // no packet could be read, silently ignore this
     VerifyOrExit(msg != NULL, ret = INET_ERROR_BAD_ARGS);
 
-    p = (struct pbuf *) msg;
+    p       = (struct pbuf *) msg;
+    lLength = msg->TotalLength();
 
     // Call the input function for the netif object in LWIP.
     // This essentially creates a TCP_IP msg and puts into
@@ -447,6 +452,8 @@ INET_ERROR TunEndPoint::TunDevSendMessage(PacketBuffer * msg)
         ExitNow(ret = chip::System::MapErrorLwIP(err));
     }
 
+    CountSent(lLength);
+
 exit:
     return (ret);
 }
@@ -470,7 +477,10 @@ INET_ERROR TunEndPoint::TunDevSendMessage(PacketBuffer * msg)
     {
         ExitNow(ret = chip::System::MapErrorPOSIX(errno));
     }
-    else if (lenSent < msg->DataLength())
+
+    CountSent(static_cast<size_t>(lenSent));
+
+    if (lenSent < msg->DataLength())
     {
         ExitNow(ret = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED);
     }
@@ -520,6 +530,9 @@ exit:
 void TunEndPoint::HandleDataReceived(PacketBuffer * msg)
 {
     INET_ERROR err = INET_NO_ERROR;
+
+    CountReceived(msg->TotalLength());
+
     if (mState == kState_Open && OnPacketReceived != NULL)
     {
         err = CheckV6Sanity(msg);
@@ -670,6 +683,7 @@ INET_ERROR TunEndPoint::TunDevOpen(const char * intfName)
 
     // Keep copy of open device fd
     mSocket = fd;
+    WatchSocket();
 
     memset(&ifr, 0, sizeof(ifr));
 
@@ -723,6 +737,7 @@ void TunEndPoint::TunDevClose(void)
 {
     if (mSocket >= 0)
     {
+        UnwatchSocket();
         close(mSocket);
     }
     mSocket = INET_INVALID_SOCKET_FD;
@@ -757,6 +772,7 @@ INET_ERROR TunEndPoint::TunDevRead(PacketBuffer * msg)
     }
     else
     {
+        CountReceived(static_cast<size_t>(rcvLen));
         msg->SetDataLength((uint16_t) rcvLen);
     }
 
@@ -779,6 +795,8 @@ SocketEvents TunEndPoint::PrepareIO()
 /* Read from the Tun device in Linux and pass up to upper layer callback */
 void TunEndPoint::HandlePendingIO()
 {
+    SYSTEM_LOOP_METRICS_SCOPE(kSource_IO, "TunEndPoint");
+
     INET_ERROR err = INET_NO_ERROR;
 
     if (mState == kState_Open && OnPacketReceived != NULL && mPendingIO.IsReadable())
@@ -98,6 +98,7 @@ class IPPacketInfo;
 class DLL_EXPORT TunEndPoint : public EndPointBasis
 {
     friend class InetLayer;
+    friend class EndPointBasis;
 
 public:
     /**
@@ -185,8 +186,6 @@ private:
     TunEndPoint(const TunEndPoint &); // not defined
     ~TunEndPoint(void);               // not defined
 
-    static chip::System::ObjectPool<TunEndPoint, INET_CONFIG_NUM_TUN_ENDPOINTS> sPool;
-
     /** Close the tunnel. */
     void Close(void);
 
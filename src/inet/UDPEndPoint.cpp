@@ -52,6 +52,9 @@
 #include <net/if.h>
 #include <netinet/in.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif // defined(__linux__)
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #include "arpa-inet-compatibility.h"
@@ -65,13 +68,17 @@
 #define SOCK_FLAGS 0
 #endif
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+#define INET_USE_REUSEPORT_CBPF 1
+#else
+#define INET_USE_REUSEPORT_CBPF 0
+#endif
+
 namespace chip {
 namespace Inet {
 
 using chip::System::PacketBuffer;
 
-chip::System::ObjectPool<UDPEndPoint, INET_CONFIG_NUM_UDP_ENDPOINTS> UDPEndPoint::sPool;
-
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 /*
  * Note that for LwIP InterfaceId is already defined to be 'struct
@@ -302,10 +309,6 @@ INET_ERROR UDPEndPoint::Listen(void)
 {
     INET_ERROR res = INET_NO_ERROR;
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    chip::System::Layer & lSystemLayer = SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
-
     if (mState == kState_Listening)
     {
         res = INET_NO_ERROR;
@@ -339,8 +342,8 @@ INET_ERROR UDPEndPoint::Listen(void)
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
-    // Wake the thread calling select so that it starts selecting on the new socket.
-    lSystemLayer.WakeSelect();
+    // Wake the thread waiting for I/O so that it starts waiting on the new socket.
+    RefreshSocketWatch();
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -399,6 +402,8 @@ void UDPEndPoint::Close(void)
         {
             chip::System::Layer & lSystemLayer = SystemLayer();
 
+            UnwatchSocket();
+
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
@@ -409,6 +414,8 @@ void UDPEndPoint::Close(void)
         // Clear any results from select() that indicate pending I/O for the socket.
         mPendingIO.Clear();
 
+        ReleaseSendBatch();
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -603,6 +610,7 @@ INET_ERROR UDPEndPoint::SendMsg(const IPPacketInfo * pktInfo, PacketBuffer * msg
         const IPAddress & srcAddr  = pktInfo->SrcAddress;
         const uint16_t & destPort  = pktInfo->DestPort;
         const InterfaceId & intfId = pktInfo->Interface;
+        const uint16_t lLength     = msg->TotalLength();
 
 #if LWIP_VERSION_MAJOR > 1 || LWIP_VERSION_MINOR >= 5
 
@@ -671,6 +679,8 @@ INET_ERROR UDPEndPoint::SendMsg(const IPPacketInfo * pktInfo, PacketBuffer * msg
 
         if (lwipErr != ERR_OK)
             res = chip::System::MapErrorLwIP(lwipErr);
+        else
+            CountSent(lLength);
     }
 
     // Unlock LwIP stack
@@ -706,6 +716,74 @@ exit:
     return res;
 }
 
+/**
+ * @brief   Send a batch of UDP messages.
+ *
+ * @param[in]   entries     the messages to send, each with its source and
+ *                          destination information
+ * @param[in]   count       the number of entries in \c entries
+ * @param[in]   sendFlags   optional transmit option flags
+ *
+ * @retval  INET_NO_ERROR
+ *      success: every message is queued for transmit.
+ *
+ * @retval  other
+ *      the error of the first message that could not be sent, as
+ *      documented for \c SendMsg.
+ *
+ * @details
+ *      Sends each message as \c SendMsg would. Where the platform allows it,
+ *      up to INET_CONFIG_UDP_SEND_BATCH_SIZE messages are handed to the
+ *      network stack with a single system call. A message that fails does
+ *      not prevent the following ones from being sent.
+ *
+ *      All destinations must be of the same address type.
+ *
+ *      Unless <tt>(sendFlags & kSendFlag_RetainBuffer) != 0</tt>, calls
+ *      <tt>chip::System::PacketBuffer::Free</tt> on every buffer on behalf of
+ *      the caller, regardless of the return status.
+ */
+INET_ERROR UDPEndPoint::SendMsgBatch(const IPPacketBatchEntry * entries, size_t count, uint16_t sendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+
+    VerifyOrExit(count > 0, res = INET_NO_ERROR);
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+    // Make sure we have the appropriate type of socket based on the
+    // destination address.
+
+    res = GetSocket(entries[0].PktInfo->DestAddress.Type());
+    SuccessOrExit(res);
+
+    res = IPEndPointBasis::SendMsgBatch(entries, count, sendFlags);
+
+#else // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+    for (size_t i = 0; i < count; i++)
+    {
+        INET_ERROR err = SendMsg(entries[i].PktInfo, entries[i].Buffer, sendFlags);
+
+        if (res == INET_NO_ERROR)
+            res = err;
+    }
+
+    // SendMsg has taken care of the buffers.
+    return res;
+
+#endif // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+exit:
+    if ((sendFlags & kSendFlag_RetainBuffer) == 0)
+    {
+        for (size_t i = 0; i < count; i++)
+            PacketBuffer::Free(entries[i].Buffer);
+    }
+
+    return res;
+}
+
 /**
  * @brief   Bind the endpoint to a network interface.
  *
@@ -779,6 +857,11 @@ exit:
 void UDPEndPoint::Init(InetLayer * inetLayer)
 {
     IPEndPointBasis::Init(inetLayer);
+    InitTrafficCounters(chip::System::Stats::kInetLayer_UDPPacketsSent);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    InitSocketWatch(*this);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 /**
@@ -821,6 +904,78 @@ uint16_t UDPEndPoint::GetBoundPort(void)
 #endif // CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 }
 
+/**
+ * @brief   Spread the datagrams of a group of endpoints sharing a port over the group by their source address.
+ *
+ * @param[in]   numShards   The number of endpoints bound to the port, including this one.
+ *
+ * @retval  INET_NO_ERROR               success: datagrams are delivered to the endpoint ShardForPeer() selects.
+ * @retval  INET_ERROR_INCORRECT_STATE  the endpoint is not bound.
+ * @retval  INET_ERROR_BAD_ARGS         \c numShards is zero.
+ * @retval  INET_ERROR_NOT_IMPLEMENTED  the platform cannot steer datagrams between sockets sharing a port.
+ * @retval  other                       another system or platform error.
+ *
+ * @details
+ *  Every socket is bound with \c SO_REUSEPORT, so several endpoints, e.g. one per event loop thread, may bind the same
+ *  port. The kernel then picks the endpoint receiving a datagram with a hash of its own, which the application cannot
+ *  predict. This method replaces that hash with ShardForPeer(), so a peer the application assigned to the endpoint at index
+ *  \c i of the group also has its datagrams delivered there. Endpoints join the group in the order they are bound.
+ *
+ *  The selection assumes IPv4 headers without options and IPv6 headers without extension headers. Calling it on any member
+ *  applies to the whole group.
+ */
+INET_ERROR UDPEndPoint::SetReusePortShards(uint16_t numShards)
+{
+    INET_ERROR err = INET_NO_ERROR;
+
+    VerifyOrExit(mState == kState_Bound || mState == kState_Listening, err = INET_ERROR_INCORRECT_STATE);
+    VerifyOrExit(numShards > 0, err = INET_ERROR_BAD_ARGS);
+
+#if INET_USE_REUSEPORT_CBPF
+    {
+        // Loads relative to the network header; A = ntohl(last word of the source address) ^ source port, then A % numShards.
+        const uint32_t net        = static_cast<uint32_t>(SKF_NET_OFF);
+        struct sock_filter code[] = {
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, net + 0),
+            BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 4),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 6, 0, 4),
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, net + 20), // IPv6: source address bytes 12-15
+            BPF_STMT(BPF_MISC | BPF_TAX, 0),
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, net + 40), // IPv6: UDP source port
+            BPF_STMT(BPF_JMP | BPF_JA, 3),
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, net + 12), // IPv4: source address
+            BPF_STMT(BPF_MISC | BPF_TAX, 0),
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, net + 20), // IPv4: UDP source port
+            BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+            BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, numShards),
+            BPF_STMT(BPF_RET | BPF_A, 0),
+        };
+        struct sock_fprog prog = { static_cast<unsigned short>(sizeof(code) / sizeof(code[0])), code };
+
+        if (setsockopt(mSocket, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) != 0)
+            err = chip::System::MapErrorPOSIX(errno);
+    }
+#else  // !INET_USE_REUSEPORT_CBPF
+    err = INET_ERROR_NOT_IMPLEMENTED;
+#endif // INET_USE_REUSEPORT_CBPF
+
+exit:
+    return err;
+}
+
+/**
+ * @brief   Select which of \c numShards endpoints sharing a port receives the datagrams from a peer.
+ *
+ * @details
+ *  This is the selection installed by SetReusePortShards(); it depends only on the peer's address and port.
+ */
+uint16_t UDPEndPoint::ShardForPeer(const IPAddress & addr, uint16_t port, uint16_t numShards)
+{
+    const uint32_t hash = ntohl(addr.Addr[3]) ^ port;
+
+    return static_cast<uint16_t>((numShards > 0) ? (hash % numShards) : 0);
+}
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 
 void UDPEndPoint::HandleDataReceived(PacketBuffer * msg)
@@ -972,6 +1127,7 @@ SocketEvents UDPEndPoint::PrepareIO(void)
 
 void UDPEndPoint::HandlePendingIO(void)
 {
+    SYSTEM_LOOP_METRICS_SCOPE(kSource_IO, "UDPEndPoint");
     if (mState == kState_Listening && OnMessageReceived != NULL && mPendingIO.IsReadable())
     {
         const uint16_t lPort = mBoundPort;
@@ -51,6 +51,7 @@ class IPPacketInfo;
 class DLL_EXPORT UDPEndPoint : public IPEndPointBasis
 {
     friend class InetLayer;
+    friend class EndPointBasis;
 
 public:
     INET_ERROR Bind(IPAddressType addrType, IPAddress addr, uint16_t port, InterfaceId intfId = INET_NULL_INTERFACEID);
@@ -61,16 +62,18 @@ public:
     INET_ERROR SendTo(IPAddress addr, uint16_t port, chip::System::PacketBuffer * msg, uint16_t sendFlags = 0);
     INET_ERROR SendTo(IPAddress addr, uint16_t port, InterfaceId intfId, chip::System::PacketBuffer * msg, uint16_t sendFlags = 0);
     INET_ERROR SendMsg(const IPPacketInfo * pktInfo, chip::System::PacketBuffer * msg, uint16_t sendFlags = 0);
+    INET_ERROR SendMsgBatch(const IPPacketBatchEntry * entries, size_t count, uint16_t sendFlags = 0);
+    INET_ERROR SetReusePortShards(uint16_t numShards);
     void Close(void);
     void Free(void);
 
+    static uint16_t ShardForPeer(const IPAddress & addr, uint16_t port, uint16_t numShards);
+
 private:
     UDPEndPoint(void);                // not defined
     UDPEndPoint(const UDPEndPoint &); // not defined
     ~UDPEndPoint(void);               // not defined
 
-    static chip::System::ObjectPool<UDPEndPoint, INET_CONFIG_NUM_UDP_ENDPOINTS> sPool;
-
     void Init(InetLayer * inetLayer);
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -509,7 +509,17 @@ void ServiceEvents(struct ::timeval & aSleepTime)
             printed = true;
         }
     }
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    if (gSystemLayer.State() == System::kLayerState_Initialized)
+        gSystemLayer.PrepareEvents(aSleepTime);
+
+    int eventCount = gSystemLayer.WaitForEvents(aSleepTime);
+    if (eventCount < 0)
+    {
+        printf("epoll_wait failed: %s\n", ErrorStr(System::MapErrorPOSIX(errno)));
+        return;
+    }
+#elif CHIP_SYSTEM_CONFIG_USE_SOCKETS
     fd_set readFDs, writeFDs, exceptFDs;
     int numFDs = 0;
 
@@ -541,7 +551,11 @@ void ServiceEvents(struct ::timeval & aSleepTime)
         static uint32_t sRemainingSystemLayerEventDelay = 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+        gSystemLayer.HandleEvents(eventCount);
+
+#elif CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
         gSystemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
 
@@ -579,11 +593,11 @@ void ServiceEvents(struct ::timeval & aSleepTime)
 
     if (gInet.State == InetLayer::kState_Initialized)
     {
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_EPOLL
 
         gInet.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
 
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_EPOLL
     }
 }
 
@@ -235,6 +235,7 @@ static void TestInetInterface(nlTestSuite * inSuite, void * inContext)
     InterfaceAddressIterator addrIterator;
     char intName[20];
     InterfaceId intId;
+    InterfaceId namedId;
     IPAddress addr;
     IPPrefix addrWithPrefix;
     INET_ERROR err;
@@ -262,6 +263,8 @@ static void TestInetInterface(nlTestSuite * inSuite, void * inContext)
         memset(intName, 42, sizeof(intName));
         err = intIterator.GetInterfaceName(intName, sizeof(intName));
         NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+        err = InterfaceNameToId(intName, namedId);
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR && namedId == intId);
         printf("     interface id: 0x%" PRIxPTR ", interface name: %s, interface state: %s, %s multicast, %s broadcast addr\n",
                (uintptr_t)(intId), intName, intIterator.IsUp() ? "UP" : "DOWN", intIterator.SupportsMulticast() ? "supports" : "no",
                intIterator.HasBroadcastAddress() ? "has" : "no");
@@ -33,6 +33,8 @@ int TestInetAddress(void);
 int TestInetBuffer(void);
 int TestInetErrorStr(void);
 int TestInetTimer(void);
+int TestInterfaceTable(void);
+int TestTCPEndPoint(void);
 
 #ifdef __cplusplus
 }
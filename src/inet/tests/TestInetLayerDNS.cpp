@@ -36,6 +36,7 @@
 
 #include <CHIPVersion.h>
 
+#include <core/CHIPEncoding.h>
 #include <inet/InetLayer.h>
 #include <support/CodeUtils.h>
 #include <support/TestUtils.h>
@@ -505,6 +506,242 @@ static void TestDNSResolution_Simultaneous(nlTestSuite * testSuite, void * inCon
     NL_TEST_ASSERT(testSuite, sNumResInProgress == 0);
 }
 
+/**
+ * Test that lookups of the same name share a request, and that the result is kept.
+ */
+static void TestDNSResolution_Cache(nlTestSuite * testSuite, void * inContext)
+{
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    const DNSResolutionTestCase testCase{ "localhost", kDNSOption_Default, 1, INET_NO_ERROR, false, false };
+    DNSResolutionTestContext tests[] = { { testSuite, testCase }, { testSuite, testCase } };
+    DNSResolutionTestContext cachedTest{ testSuite, testCase };
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    const System::Stats::counter_t * counters = System::Stats::GetCounters();
+    const System::Stats::counter_t hits       = counters[System::Stats::kInetLayer_DNSCacheHits];
+    const System::Stats::counter_t misses     = counters[System::Stats::kInetLayer_DNSCacheMisses];
+    const System::Stats::counter_t coalesced  = counters[System::Stats::kInetLayer_DNSCacheCoalesced];
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    gInet.FlushDNSCache();
+
+    // Start two lookups of the same name simultaneously.
+    for (DNSResolutionTestContext & testContext : tests)
+    {
+        StartTestCase(testContext);
+    }
+
+    ServiceNetworkUntilDone(DEFAULT_TEST_DURATION_MILLISECS);
+    NL_TEST_ASSERT(testSuite, gDone == true);
+    NL_TEST_ASSERT(testSuite, tests[0].callbackCalled && tests[1].callbackCalled);
+
+    // A lookup of the same name is answered from the cache, before ResolveHostAddress() returns.
+    StartTestCase(cachedTest);
+    NL_TEST_ASSERT(testSuite, cachedTest.callbackCalled);
+    NL_TEST_ASSERT(testSuite, cachedTest.resultsBuf[0] == tests[0].resultsBuf[0]);
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    // Only the first lookup reached the resolver.
+    NL_TEST_ASSERT(testSuite, counters[System::Stats::kInetLayer_DNSCacheMisses] - misses == 1);
+    NL_TEST_ASSERT(testSuite,
+                   counters[System::Stats::kInetLayer_DNSCacheHits] - hits +
+                           counters[System::Stats::kInetLayer_DNSCacheCoalesced] - coalesced ==
+                       2);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    NL_TEST_ASSERT(testSuite, sNumResInProgress == 0);
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
+constexpr uint32_t kStandInTimeoutMS = 200;
+static uint16_t sDroppedQueryIds[8];
+static size_t sNumDroppedQueries = 0;
+static uint16_t sFirstQueryPort   = 0;
+static bool sQueryPortChanged     = false;
+
+/**
+ * Append a resource record, owned by the name at @a ownerOffset of the message, to a DNS response.
+ */
+static uint8_t * PutRecord(uint8_t * p, uint16_t ownerOffset, uint16_t type, const uint8_t * rdata, uint16_t rdLength)
+{
+    Encoding::BigEndian::Write16(p, static_cast<uint16_t>(0xC000 | ownerOffset));
+    Encoding::BigEndian::Write16(p, type);
+    Encoding::BigEndian::Write16(p, 1); // class IN
+    Encoding::BigEndian::Write32(p, 60);
+    Encoding::BigEndian::Write16(p, rdLength);
+    memcpy(p, rdata, rdLength);
+    return p + rdLength;
+}
+
+/**
+ * A stand-in name server, answering for the "test" domain:
+ *  - a.test has an IPv4 and an IPv6 address;
+ *  - alias.test is an alias of a.test;
+ *  - retry.test is a.test, but the first query of each ID is dropped;
+ *  - missing.test does not exist;
+ *  - servfail.test makes the server fail;
+ *  - any other name exists, without addresses.
+ */
+static void HandleStandInQuery(IPEndPointBasis * endPoint, System::PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    static const uint8_t kAddr4[]     = { 192, 0, 2, 1 };
+    static const uint8_t kAddr6[]     = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+    static const uint8_t kTarget[]    = { 1, 'a', 4, 't', 'e', 's', 't', 0 };
+    const uint8_t * query             = msg->Start();
+    const uint16_t queryLen           = msg->DataLength();
+    System::PacketBuffer * response   = NULL;
+    uint16_t questionEnd              = 12;
+    uint16_t rcode                    = 0;
+    uint16_t numAnswers               = 0;
+    uint16_t ownerOffset              = 12;
+    char name[64]                     = "";
+    uint16_t id, type;
+    uint8_t * p;
+
+    // Queries have a single, uncompressed question.
+    while (questionEnd < queryLen && query[questionEnd] != 0)
+    {
+        const uint8_t labelLength = query[questionEnd];
+
+        VerifyOrExit(questionEnd + 1 + labelLength < queryLen && strlen(name) + labelLength + 1 < sizeof(name), );
+        if (name[0] != 0)
+            strcat(name, ".");
+        strncat(name, reinterpret_cast<const char *>(&query[questionEnd + 1]), labelLength);
+        questionEnd += 1 + labelLength;
+    }
+    questionEnd += 1 + 4;
+    VerifyOrExit(questionEnd <= queryLen, );
+
+    id   = Encoding::BigEndian::Get16(&query[0]);
+    type = Encoding::BigEndian::Get16(&query[questionEnd - 4]);
+
+    if (sFirstQueryPort == 0)
+        sFirstQueryPort = pktInfo->SrcPort;
+    else if (pktInfo->SrcPort != sFirstQueryPort)
+        sQueryPortChanged = true;
+
+    if (strcmp(name, "retry.test") == 0)
+    {
+        size_t i;
+
+        for (i = 0; i < sNumDroppedQueries && sDroppedQueryIds[i] != id; i++)
+            ;
+        if (i == sNumDroppedQueries && sNumDroppedQueries < ArraySize(sDroppedQueryIds))
+        {
+            sDroppedQueryIds[sNumDroppedQueries++] = id;
+            ExitNow();
+        }
+    }
+
+    response = System::PacketBuffer::New();
+    VerifyOrExit(response != NULL, );
+
+    p = response->Start();
+    memcpy(p, query, questionEnd);
+    p += questionEnd;
+
+    if (strcmp(name, "alias.test") == 0)
+    {
+        ownerOffset = static_cast<uint16_t>(p - response->Start() + 12);
+        p           = PutRecord(p, 12, 5, kTarget, sizeof(kTarget));
+        numAnswers++;
+    }
+
+    if (strcmp(name, "a.test") == 0 || strcmp(name, "alias.test") == 0 || strcmp(name, "retry.test") == 0)
+    {
+        if (type == 1)
+            p = PutRecord(p, ownerOffset, type, kAddr4, sizeof(kAddr4));
+        else
+            p = PutRecord(p, ownerOffset, type, kAddr6, sizeof(kAddr6));
+        numAnswers++;
+    }
+    else if (strcmp(name, "missing.test") == 0)
+    {
+        rcode = 3;
+    }
+    else if (strcmp(name, "servfail.test") == 0)
+    {
+        rcode = 2;
+    }
+
+    response->SetDataLength(static_cast<uint16_t>(p - response->Start()));
+
+    p = response->Start() + 2;
+    Encoding::BigEndian::Write16(p, static_cast<uint16_t>(0x8180 | rcode));
+    Encoding::BigEndian::Write16(p, 1);
+    Encoding::BigEndian::Write16(p, numAnswers);
+    Encoding::BigEndian::Write16(p, 0);
+    Encoding::BigEndian::Write16(p, 0);
+
+    static_cast<UDPEndPoint *>(endPoint)->SendTo(pktInfo->SrcAddress, pktInfo->SrcPort, response);
+
+exit:
+    System::PacketBuffer::Free(msg);
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+
+/**
+ * Test the native DNS client against a stand-in name server on the loopback interface.
+ */
+static void TestDNSResolution_NativeClient(nlTestSuite * testSuite, void * inContext)
+{
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+    constexpr bool kIPv4 = INET_CONFIG_ENABLE_IPV4;
+    UDPEndPoint * server = NULL;
+    IPAddress serverAddr;
+    INET_ERROR err;
+
+#if INET_CONFIG_ENABLE_IPV4
+    IPAddress::FromString("127.0.0.1", serverAddr);
+#else  // !INET_CONFIG_ENABLE_IPV4
+    IPAddress::FromString("::1", serverAddr);
+#endif // !INET_CONFIG_ENABLE_IPV4
+
+    err = gInet.NewUDPEndPoint(&server);
+    NL_TEST_ASSERT(testSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = server->Bind(serverAddr.Type(), serverAddr, 0);
+    NL_TEST_ASSERT(testSuite, err == INET_NO_ERROR);
+    SuccessOrExit(err);
+
+    err = server->Listen();
+    NL_TEST_ASSERT(testSuite, err == INET_NO_ERROR);
+    SuccessOrExit(err);
+
+    server->OnMessageReceived = HandleStandInQuery;
+
+    err = gInet.SetDNSServers(&serverAddr, 1, server->GetBoundPort(), kStandInTimeoutMS, 2);
+    NL_TEST_ASSERT(testSuite, err == INET_NO_ERROR);
+    SuccessOrExit(err);
+
+    // clang-format off
+    RunTestCase(testSuite, DNSResolutionTestCase{ "a.test",        kDNSOption_Default,             kMaxResults, INET_NO_ERROR,             kIPv4, true  });
+    RunTestCase(testSuite, DNSResolutionTestCase{ "alias.test",    kDNSOption_AddrFamily_IPv6Only, kMaxResults, INET_NO_ERROR,             false, true  });
+    RunTestCase(testSuite, DNSResolutionTestCase{ "retry.test",    kDNSOption_Default,             kMaxResults, INET_NO_ERROR,             kIPv4, true  });
+    RunTestCase(testSuite, DNSResolutionTestCase{ "missing.test",  kDNSOption_Default,             kMaxResults, INET_ERROR_HOST_NOT_FOUND, false, false });
+    RunTestCase(testSuite, DNSResolutionTestCase{ "nodata.test",   kDNSOption_Default,             kMaxResults, INET_ERROR_HOST_NOT_FOUND, false, false });
+    RunTestCase(testSuite, DNSResolutionTestCase{ "servfail.test", kDNSOption_Default,             kMaxResults, INET_ERROR_DNS_TRY_AGAIN,  false, false });
+    RunTestCase(testSuite, DNSResolutionTestCase{ "localhost",     kDNSOption_Default,             kMaxResults, INET_NO_ERROR,             kIPv4, true  });
+    // clang-format on
+
+    // The retried lookup had its queries dropped once.
+    NL_TEST_ASSERT(testSuite, sNumDroppedQueries > 0);
+
+    // Each lookup sent its queries from a port of its own.
+    NL_TEST_ASSERT(testSuite, sQueryPortChanged);
+
+exit:
+    if (server != NULL)
+    {
+        server->Close();
+        server->Free();
+    }
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_NATIVE_DNS_SOCKETS
+}
+
 static void RunTestCase(nlTestSuite * testSuite, const DNSResolutionTestCase & testCase)
 {
     DNSResolutionTestContext testContext{ testSuite, testCase };
@@ -691,6 +928,8 @@ int TestInetLayerDNS(void)
         NL_TEST_DEF("TestDNSResolution:NoHostRecord",      TestDNSResolution_NoHostRecord),
         NL_TEST_DEF("TestDNSResolution:Cancel",            TestDNSResolution_Cancel),
         NL_TEST_DEF("TestDNSResolution:Simultaneous",      TestDNSResolution_Simultaneous),
+        NL_TEST_DEF("TestDNSResolution:Cache",             TestDNSResolution_Cache),
+        NL_TEST_DEF("TestDNSResolution:NativeClient",      TestDNSResolution_NativeClient),
         NL_TEST_SENTINEL() };
 
     nlTestSuite DNSTestSuite =
@@ -0,0 +1,280 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for InterfaceTable, the snapshot
+ *      of the network interfaces that the interface iterators share.
+ *
+ */
+
+#include "TestInetLayer.h"
+
+#include <inet/InetInterface.h>
+#include <inet/InterfaceTable.h>
+#include <support/CodeUtils.h>
+
+#include <nlunit-test.h>
+
+#if INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace chip {
+namespace Inet {
+
+class InterfaceTableTest
+{
+public:
+    static void CheckUnmonitored(nlTestSuite * inSuite, void * inContext);
+    static void CheckNoChange(nlTestSuite * inSuite, void * inContext);
+    static void CheckNetlinkChange(nlTestSuite * inSuite, void * inContext);
+    static void CheckInvalidate(nlTestSuite * inSuite, void * inContext);
+
+private:
+    static size_t CountInterfaces(void);
+    static bool NotifyChange(void);
+};
+
+/**
+ *  Return how many interfaces a new iterator goes through.
+ */
+size_t InterfaceTableTest::CountInterfaces(void)
+{
+    size_t count = 0;
+
+    for (InterfaceIterator it; it.HasCurrent(); it.Next())
+        count++;
+
+    return count;
+}
+
+/**
+ *  Send a notification of a new address to the monitor socket, as the kernel would. Netlink lets any socket send to another
+ *  one of its protocol, which unlike changing an actual address does not need privileges.
+ */
+bool InterfaceTableTest::NotifyChange(void)
+{
+    struct sockaddr_nl monitorAddr;
+    socklen_t monitorAddrLen = sizeof(monitorAddr);
+    struct nlmsghdr header;
+    bool sent = false;
+    int s     = -1;
+
+    VerifyOrExit(getsockname(InterfaceTable::GetMonitorSocket(), reinterpret_cast<struct sockaddr *>(&monitorAddr),
+                             &monitorAddrLen) == 0, );
+
+    s = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    VerifyOrExit(s >= 0, );
+
+    memset(&header, 0, sizeof(header));
+    header.nlmsg_len  = sizeof(header);
+    header.nlmsg_type = RTM_NEWADDR;
+
+    monitorAddr.nl_groups = 0;
+    sent = (sendto(s, &header, sizeof(header), 0, reinterpret_cast<struct sockaddr *>(&monitorAddr), sizeof(monitorAddr)) ==
+            static_cast<ssize_t>(sizeof(header)));
+
+exit:
+    if (s >= 0)
+        close(s);
+
+    return sent;
+}
+
+/**
+ *  Test that without monitoring, every iterator reads the system interfaces afresh.
+ */
+void InterfaceTableTest::CheckUnmonitored(nlTestSuite * inSuite, void * inContext)
+{
+    const InterfaceTable * table1 = InterfaceTable::Acquire();
+    const InterfaceTable * table2 = InterfaceTable::Acquire();
+
+    NL_TEST_ASSERT(inSuite, InterfaceTable::GetMonitorSocket() < 0);
+    NL_TEST_ASSERT(inSuite, table1 != NULL && table2 != NULL);
+    NL_TEST_ASSERT(inSuite, table1 != table2);
+
+    if (table1 != NULL)
+        InterfaceTable::Release(table1);
+    if (table2 != NULL)
+        InterfaceTable::Release(table2);
+}
+
+/**
+ *  Test that while monitoring, iterators share a snapshot until a change is reported.
+ */
+void InterfaceTableTest::CheckNoChange(nlTestSuite * inSuite, void * inContext)
+{
+    const InterfaceTable * table1;
+    const InterfaceTable * table2;
+
+    InterfaceTable::StartMonitoring();
+    VerifyOrExit(InterfaceTable::GetMonitorSocket() >= 0, printf("Netlink not available, skipping\n"));
+
+    table1 = InterfaceTable::Acquire();
+    InterfaceTable::HandleChanges();
+    table2 = InterfaceTable::Acquire();
+
+    NL_TEST_ASSERT(inSuite, table1 != NULL);
+    NL_TEST_ASSERT(inSuite, table1 == table2);
+
+    if (table1 != NULL)
+        InterfaceTable::Release(table1);
+    if (table2 != NULL)
+        InterfaceTable::Release(table2);
+
+exit:
+    InterfaceTable::StopMonitoring();
+}
+
+/**
+ *  Test that once a change is reported on the netlink socket, new iterators read a new snapshot, while those started before
+ *  keep reading theirs.
+ */
+void InterfaceTableTest::CheckNetlinkChange(nlTestSuite * inSuite, void * inContext)
+{
+    const InterfaceTable * oldTable;
+    const InterfaceTable * newTable;
+    size_t oldCount = 0;
+    size_t numInterfaces;
+
+    InterfaceTable::StartMonitoring();
+    VerifyOrExit(InterfaceTable::GetMonitorSocket() >= 0, printf("Netlink not available, skipping\n"));
+
+    {
+        InterfaceIterator oldIterator;
+
+        oldTable = InterfaceTable::Acquire();
+        NL_TEST_ASSERT(inSuite, oldTable != NULL);
+        VerifyOrExit(oldTable != NULL, );
+
+        numInterfaces = oldTable->mNumInterfaces;
+
+        // Iterators only take the snapshot once they start.
+        NL_TEST_ASSERT(inSuite, oldIterator.HasCurrent());
+
+        NL_TEST_ASSERT(inSuite, NotifyChange());
+        InterfaceTable::HandleChanges();
+
+        newTable = InterfaceTable::Acquire();
+        NL_TEST_ASSERT(inSuite, newTable != NULL);
+        NL_TEST_ASSERT(inSuite, newTable != oldTable);
+
+        // The iterators holding the old snapshot keep it alive.
+        NL_TEST_ASSERT(inSuite, oldTable->mRefCount == 2);
+        NL_TEST_ASSERT(inSuite, oldTable->mNumInterfaces == numInterfaces);
+
+        for (; oldIterator.HasCurrent(); oldIterator.Next())
+            oldCount++;
+        NL_TEST_ASSERT(inSuite, oldCount == numInterfaces);
+
+        // Iterators started since read the new snapshot.
+        NL_TEST_ASSERT(inSuite, CountInterfaces() == newTable->mNumInterfaces);
+        NL_TEST_ASSERT(inSuite, newTable->mRefCount == 2);
+
+        InterfaceTable::Release(oldTable);
+        if (newTable != NULL)
+            InterfaceTable::Release(newTable);
+    }
+
+exit:
+    InterfaceTable::StopMonitoring();
+}
+
+/**
+ *  Test that dropping the current snapshot, as stopping monitoring does, leaves it to the iterators still reading it.
+ */
+void InterfaceTableTest::CheckInvalidate(nlTestSuite * inSuite, void * inContext)
+{
+    const InterfaceTable * oldTable;
+    const InterfaceTable * newTable;
+
+    InterfaceTable::StartMonitoring();
+    oldTable = InterfaceTable::Acquire();
+    NL_TEST_ASSERT(inSuite, oldTable != NULL);
+
+    InterfaceTable::StopMonitoring();
+    InterfaceTable::StartMonitoring();
+
+    newTable = InterfaceTable::Acquire();
+    NL_TEST_ASSERT(inSuite, newTable != NULL);
+    NL_TEST_ASSERT(inSuite, newTable != oldTable);
+
+    if (oldTable != NULL)
+    {
+        NL_TEST_ASSERT(inSuite, oldTable->mRefCount == 1);
+        NL_TEST_ASSERT(inSuite, CountInterfaces() == newTable->mNumInterfaces);
+        InterfaceTable::Release(oldTable);
+    }
+
+    if (newTable != NULL)
+        InterfaceTable::Release(newTable);
+
+    InterfaceTable::StopMonitoring();
+}
+
+} // namespace Inet
+} // namespace chip
+
+using chip::Inet::InterfaceTableTest;
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("InterfaceTable::Unmonitored",   InterfaceTableTest::CheckUnmonitored),
+    NL_TEST_DEF("InterfaceTable::NoChange",      InterfaceTableTest::CheckNoChange),
+    NL_TEST_DEF("InterfaceTable::NetlinkChange", InterfaceTableTest::CheckNetlinkChange),
+    NL_TEST_DEF("InterfaceTable::Invalidate",    InterfaceTableTest::CheckInvalidate),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestInterfaceTable(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "inet-interface-table",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+    // clang-format on
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+#else // !INET_CONFIG_ENABLE_INTERFACE_TABLE
+
+int TestInterfaceTable(void)
+{
+    return 0;
+}
+
+#endif // !INET_CONFIG_ENABLE_INTERFACE_TABLE
@@ -0,0 +1,417 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the sockets implementation
+ *      of TCPEndPoint, against a plain socket on the loopback
+ *      interface.
+ *
+ */
+
+#include "TestInetLayer.h"
+
+#include <inet/InetLayer.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <system/SystemLayer.h>
+
+#include <nlunit-test.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_TCP_ENDPOINT && INET_CONFIG_ENABLE_IPV4
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace chip::Inet;
+using chip::System::PacketBuffer;
+
+namespace {
+
+const int kSmallSocketBufferSize = 2048;
+const size_t kNumSendBuffers     = 10;
+const uint16_t kSendBufferLength = 1201; // not a multiple of what the socket accepts, so writes end mid-buffer
+const size_t kSendLength         = kNumSendBuffers * kSendBufferLength;
+const size_t kReceiveLength      = 6000; // several buffers, and less than the receive budget
+
+chip::System::Layer sSystemLayer;
+InetLayer sInet;
+
+bool sConnected;
+size_t sBytesSent;
+size_t sBytesReceived;
+size_t sNumReceptions;
+size_t sFirstReceptionBuffers;
+bool sReceivedInOrder;
+
+uint8_t StreamByte(size_t offset)
+{
+    return static_cast<uint8_t>(offset % 251);
+}
+
+void ServiceEvents(uint32_t aMilliseconds)
+{
+    struct timeval sleepTime;
+
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = static_cast<suseconds_t>(aMilliseconds * 1000);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    sSystemLayer.PrepareEvents(sleepTime);
+
+    const int eventCount = sSystemLayer.WaitForEvents(sleepTime);
+    if (eventCount < 0)
+    {
+        printf("epoll_wait failed: %s\n", chip::ErrorStr(chip::System::MapErrorPOSIX(errno)));
+        return;
+    }
+
+    sSystemLayer.HandleEvents(eventCount);
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+    fd_set readFDs, writeFDs, exceptFDs;
+    int numFDs = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    sSystemLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+    sInet.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+
+    const int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+    if (selectRes < 0)
+    {
+        printf("select failed: %s\n", chip::ErrorStr(chip::System::MapErrorPOSIX(errno)));
+        return;
+    }
+
+    sSystemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+    sInet.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+
+void HandleConnectComplete(TCPEndPoint * endPoint, INET_ERROR err)
+{
+    sConnected = (err == INET_NO_ERROR);
+}
+
+void HandleDataSent(TCPEndPoint * endPoint, uint16_t len)
+{
+    sBytesSent += len;
+}
+
+void HandleDataReceived(TCPEndPoint * endPoint, PacketBuffer * data)
+{
+    size_t numBuffers = 0;
+    size_t length     = 0;
+
+    for (PacketBuffer * buf = data; buf != NULL; buf = buf->Next())
+    {
+        for (uint16_t i = 0; i < buf->DataLength(); i++)
+            sReceivedInOrder = sReceivedInOrder && (buf->Start()[i] == StreamByte(sBytesReceived + length + i));
+
+        length += buf->DataLength();
+        numBuffers++;
+    }
+
+    if (sNumReceptions++ == 0)
+        sFirstReceptionBuffers = numBuffers;
+
+    sBytesReceived += length;
+    endPoint->AckReceive(static_cast<uint16_t>(length));
+    PacketBuffer::Free(data);
+}
+
+/**
+ *  Return the descriptor of the socket bound to the local IPv4 port @a port, other than @a exceptFD, or -1.
+ */
+int FindLocalSocket(uint16_t port, int exceptFD)
+{
+    for (int fd = 0; fd < FD_SETSIZE; fd++)
+    {
+        struct sockaddr_in sockAddr;
+        socklen_t sockAddrLen = sizeof(sockAddr);
+
+        if (fd != exceptFD && getsockname(fd, reinterpret_cast<struct sockaddr *>(&sockAddr), &sockAddrLen) == 0 &&
+            sockAddr.sin_family == AF_INET && ntohs(sockAddr.sin_port) == port)
+            return fd;
+    }
+
+    return -1;
+}
+
+/**
+ *  Connect a new endpoint to a plain socket on the loopback interface, which only reads and writes when told, and has a small
+ *  receive buffer. Return the endpoint, or NULL on failure, and the descriptor of the peer socket in @a peerFD.
+ */
+TCPEndPoint * Connect(nlTestSuite * inSuite, int & peerFD)
+{
+    TCPEndPoint * endPoint = NULL;
+    int listenFD           = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in sockAddr;
+    socklen_t sockAddrLen = sizeof(sockAddr);
+    IPAddress loopback;
+    INET_ERROR err;
+
+    peerFD     = -1;
+    sConnected = false;
+
+    NL_TEST_ASSERT(inSuite, listenFD >= 0);
+    VerifyOrExit(listenFD >= 0, );
+
+    // The accepted socket inherits the receive buffer size.
+    setsockopt(listenFD, SOL_SOCKET, SO_RCVBUF, &kSmallSocketBufferSize, sizeof(kSmallSocketBufferSize));
+
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sin_family      = AF_INET;
+    sockAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    NL_TEST_ASSERT(inSuite, bind(listenFD, reinterpret_cast<struct sockaddr *>(&sockAddr), sizeof(sockAddr)) == 0);
+    NL_TEST_ASSERT(inSuite, listen(listenFD, 1) == 0);
+    NL_TEST_ASSERT(inSuite, getsockname(listenFD, reinterpret_cast<struct sockaddr *>(&sockAddr), &sockAddrLen) == 0);
+
+    err = sInet.NewTCPEndPoint(&endPoint);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, endPoint = NULL);
+
+    endPoint->OnConnectComplete = HandleConnectComplete;
+    endPoint->OnDataSent        = HandleDataSent;
+    endPoint->OnDataReceived    = HandleDataReceived;
+
+    IPAddress::FromString("127.0.0.1", loopback);
+    err = endPoint->Connect(loopback, ntohs(sockAddr.sin_port));
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (int i = 0; i < 1000 && !sConnected; i++)
+        ServiceEvents(1);
+
+    NL_TEST_ASSERT(inSuite, sConnected);
+    VerifyOrExit(sConnected, );
+
+    peerFD = accept(listenFD, NULL, NULL);
+    NL_TEST_ASSERT(inSuite, peerFD >= 0);
+
+exit:
+    if (listenFD >= 0)
+        close(listenFD);
+
+    if (endPoint != NULL && peerFD < 0)
+    {
+        endPoint->Free();
+        endPoint = NULL;
+    }
+
+    return endPoint;
+}
+
+void Disconnect(TCPEndPoint * endPoint, int peerFD)
+{
+    if (endPoint != NULL)
+    {
+        endPoint->Close();
+        endPoint->Free();
+    }
+
+    if (peerFD >= 0)
+        close(peerFD);
+}
+
+} // namespace
+
+/**
+ *  Test that a queue of several buffers is gathered into one write, and that partial writes resume where they stopped.
+ */
+static void CheckSendQueue(nlTestSuite * inSuite, void * inContext)
+{
+    int peerFD;
+    TCPEndPoint * endPoint = Connect(inSuite, peerFD);
+    size_t received        = 0;
+    bool inOrder           = true;
+    struct sockaddr_in sockAddr;
+    socklen_t sockAddrLen = sizeof(sockAddr);
+    int endPointFD;
+
+    VerifyOrExit(endPoint != NULL, );
+
+    sBytesSent = 0;
+
+    // Shrink the send buffer of the endpoint's socket too, so that the whole queue cannot be written at once.
+    NL_TEST_ASSERT(inSuite, getpeername(peerFD, reinterpret_cast<struct sockaddr *>(&sockAddr), &sockAddrLen) == 0);
+    endPointFD = FindLocalSocket(ntohs(sockAddr.sin_port), peerFD);
+    NL_TEST_ASSERT(inSuite, endPointFD >= 0);
+    setsockopt(endPointFD, SOL_SOCKET, SO_SNDBUF, &kSmallSocketBufferSize, sizeof(kSmallSocketBufferSize));
+
+    // Queue all the buffers, and only push with the last one.
+    for (size_t i = 0; i < kNumSendBuffers; i++)
+    {
+        PacketBuffer * buf = PacketBuffer::New();
+
+        NL_TEST_ASSERT(inSuite, buf != NULL && buf->AvailableDataLength() >= kSendBufferLength);
+        VerifyOrExit(buf != NULL && buf->AvailableDataLength() >= kSendBufferLength, PacketBuffer::Free(buf));
+
+        for (uint16_t j = 0; j < kSendBufferLength; j++)
+            buf->Start()[j] = StreamByte(i * kSendBufferLength + j);
+        buf->SetDataLength(kSendBufferLength);
+
+        NL_TEST_ASSERT(inSuite, endPoint->Send(buf, i == kNumSendBuffers - 1) == INET_NO_ERROR);
+    }
+
+    // Part of the queue was written, and the rest is left for when the socket becomes writable again.
+    NL_TEST_ASSERT(inSuite, sBytesSent > 0 && sBytesSent < kSendLength);
+    NL_TEST_ASSERT(inSuite, sBytesSent + endPoint->PendingSendLength() == kSendLength);
+
+    for (int i = 0; i < 5000 && received < kSendLength; i++)
+    {
+        uint8_t data[512];
+        const ssize_t len = recv(peerFD, data, sizeof(data), MSG_DONTWAIT);
+
+        for (ssize_t j = 0; j < len; j++)
+            inOrder = inOrder && (data[j] == StreamByte(received + static_cast<size_t>(j)));
+        if (len > 0)
+            received += static_cast<size_t>(len);
+
+        ServiceEvents(1);
+    }
+
+    NL_TEST_ASSERT(inSuite, received == kSendLength);
+    NL_TEST_ASSERT(inSuite, inOrder);
+    NL_TEST_ASSERT(inSuite, sBytesSent == kSendLength);
+    NL_TEST_ASSERT(inSuite, endPoint->PendingSendLength() == 0);
+
+exit:
+    Disconnect(endPoint, peerFD);
+}
+
+/**
+ *  Test that data waiting on the socket is read into as many buffers as the receive budget allows.
+ */
+static void CheckReceiveBudget(nlTestSuite * inSuite, void * inContext)
+{
+    int peerFD;
+    TCPEndPoint * endPoint = Connect(inSuite, peerFD);
+    uint8_t data[kReceiveLength];
+
+    VerifyOrExit(endPoint != NULL, );
+
+    sBytesReceived         = 0;
+    sNumReceptions         = 0;
+    sFirstReceptionBuffers = 0;
+    sReceivedInOrder       = true;
+
+    for (size_t i = 0; i < kReceiveLength; i++)
+        data[i] = StreamByte(i);
+
+    NL_TEST_ASSERT(inSuite, send(peerFD, data, sizeof(data), 0) == static_cast<ssize_t>(sizeof(data)));
+
+    // Let the data reach the endpoint's socket before it becomes readable to the event loop.
+    usleep(20000);
+
+    for (int i = 0; i < 1000 && sBytesReceived < kReceiveLength; i++)
+        ServiceEvents(1);
+
+    NL_TEST_ASSERT(inSuite, sBytesReceived == kReceiveLength);
+    NL_TEST_ASSERT(inSuite, sReceivedInOrder);
+
+    if (INET_CONFIG_TCP_RECV_BUDGET >= kReceiveLength)
+    {
+        // A single read took all of it, into a chain of buffers.
+        NL_TEST_ASSERT(inSuite, sNumReceptions == 1);
+        NL_TEST_ASSERT(inSuite, sFirstReceptionBuffers > 1);
+    }
+    else if (INET_CONFIG_TCP_RECV_BUDGET == 0)
+    {
+        // Without a budget, a read fills at most one buffer.
+        NL_TEST_ASSERT(inSuite, sNumReceptions > 1);
+        NL_TEST_ASSERT(inSuite, sFirstReceptionBuffers == 1);
+    }
+
+exit:
+    Disconnect(endPoint, peerFD);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("TCPEndPoint::SendQueue",     CheckSendQueue),
+    NL_TEST_DEF("TCPEndPoint::ReceiveBudget", CheckReceiveBudget),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * inContext)
+{
+    if (sSystemLayer.Init(NULL) != CHIP_SYSTEM_NO_ERROR)
+        return FAILURE;
+
+    if (sInet.Init(sSystemLayer, NULL) != INET_NO_ERROR)
+    {
+        sSystemLayer.Shutdown();
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * inContext)
+{
+    sInet.Shutdown();
+    sSystemLayer.Shutdown();
+
+    return SUCCESS;
+}
+
+int TestTCPEndPoint(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "inet-tcp-endpoint",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+#else // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_TCP_ENDPOINT && INET_CONFIG_ENABLE_IPV4)
+
+int TestTCPEndPoint(void)
+{
+    return 0;
+}
+
+#endif // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_TCP_ENDPOINT && INET_CONFIG_ENABLE_IPV4)
@@ -2300,6 +2300,40 @@
 #define CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS      5000
 #endif // CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS
 
+/**
+ * @def CHIP_CONFIG_CRYPTO_WORKER_POOL
+ *
+ * @brief Provide Transport::CryptoWorkerPool, with which SecureSessionMgr
+ * encrypts and decrypts messages on worker threads instead of the thread
+ * running the event loop. Requires POSIX threads and sockets.
+ */
+#ifndef CHIP_CONFIG_CRYPTO_WORKER_POOL
+#define CHIP_CONFIG_CRYPTO_WORKER_POOL                       (CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS)
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+/**
+ * @def CHIP_CONFIG_CRYPTO_WORKER_MAX_THREADS
+ *
+ * @brief The maximum number of threads of a Transport::CryptoWorkerPool.
+ */
+#ifndef CHIP_CONFIG_CRYPTO_WORKER_MAX_THREADS
+#define CHIP_CONFIG_CRYPTO_WORKER_MAX_THREADS                8
+#endif // CHIP_CONFIG_CRYPTO_WORKER_MAX_THREADS
+
+/**
+ * @def CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE
+ *
+ * @brief The number of messages a Transport::CryptoWorkerPool can encrypt
+ * or decrypt at once. Messages beyond it are refused until some complete.
+ */
+#ifndef CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE
+#define CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE                 32
+#endif // CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL && !(CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS)
+#error "CHIP_CONFIG_CRYPTO_WORKER_POOL requires CHIP_SYSTEM_CONFIG_POSIX_LOCKING and CHIP_SYSTEM_CONFIG_USE_SOCKETS"
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL && !(CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS)
+
 /**
  * @def CHIP_NON_PRODUCTION_MARKER
  *
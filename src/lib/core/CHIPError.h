@@ -1696,6 +1696,14 @@ typedef CHIP_CONFIG_ERROR_TYPE CHIP_ERROR;
  */
 #define CHIP_ERROR_INTERNAL                                     _CHIP_ERROR(183)
 
+/**
+ * @def CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED
+ *
+ * @brief
+ *   A message with an already received message counter was dropped
+ */
+#define CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED                   _CHIP_ERROR(184)
+
 /**
  *  @}
  */
@@ -225,7 +225,8 @@ static int32_t sContext[] =
     CHIP_ERROR_UNSUPPORTED_THREAD_NETWORK_CREATE,
     CHIP_ERROR_INCONSISTENT_CONDITIONALITY,
     CHIP_ERROR_LOCAL_DATA_INCONSISTENT,
-    CHIP_EVENT_ID_FOUND
+    CHIP_EVENT_ID_FOUND,
+    CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED
 };
 // clang-format on
 
@@ -0,0 +1,179 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a bounded, lock-free queue that any number of
+ *      threads may push items into and a single thread pops them from.
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ *  @class MPSCQueue
+ *
+ *  @brief
+ *    A bounded multi-producer, single-consumer FIFO queue.
+ *
+ *    Push() may be called concurrently from any thread and never blocks: it fails when the queue is full. Pop(), IsEmpty() and
+ *    ForEachPending() must only be called from one thread at a time, usually the thread running the event loop.
+ *
+ *    Each slot carries a sequence number telling whether it is free for the producer claiming the next position, or holds an
+ *    item ready for the consumer. Producers claim positions with a compare-and-swap, so a producer never waits for another;
+ *    the consumer however only sees an item once the items pushed before it are complete.
+ *
+ *  @tparam T          The type of the items, copied in and out of the queue.
+ *  @tparam kCapacity  The maximum number of items in the queue.
+ */
+template <typename T, size_t kCapacity>
+class MPSCQueue
+{
+public:
+    MPSCQueue(void);
+
+    bool Push(const T & aItem);
+    bool Pop(T & aItem);
+    bool IsEmpty(void) const;
+
+    template <typename Function>
+    void ForEachPending(Function aFunction);
+
+private:
+    struct Slot
+    {
+        size_t mSequence;
+        T mItem;
+    };
+
+    Slot mSlots[kCapacity];
+    size_t mPushPosition; ///< next position to be claimed by a producer
+    size_t mPopPosition;  ///< next position to be read by the consumer; only accessed by the consumer
+
+    // Not defined
+    MPSCQueue(const MPSCQueue &);
+    MPSCQueue & operator=(const MPSCQueue &);
+};
+
+template <typename T, size_t kCapacity>
+MPSCQueue<T, kCapacity>::MPSCQueue(void) : mPushPosition(0), mPopPosition(0)
+{
+    for (size_t i = 0; i < kCapacity; i++)
+        mSlots[i].mSequence = i;
+}
+
+/**
+ *  Append an item to the queue. May be called from any thread.
+ *
+ *  @param[in]  aItem   The item to copy into the queue.
+ *
+ *  @return \c true if the item was queued, \c false if the queue is full.
+ */
+template <typename T, size_t kCapacity>
+bool MPSCQueue<T, kCapacity>::Push(const T & aItem)
+{
+    size_t lPosition = __atomic_load_n(&mPushPosition, __ATOMIC_RELAXED);
+
+    while (true)
+    {
+        Slot & lSlot            = mSlots[lPosition % kCapacity];
+        const size_t lSequence  = __atomic_load_n(&lSlot.mSequence, __ATOMIC_ACQUIRE);
+        const intptr_t lPending = static_cast<intptr_t>(lSequence - lPosition);
+
+        if (lPending == 0)
+        {
+            // The slot is free; claim the position, or retry with the position another producer moved it to.
+            if (__atomic_compare_exchange_n(&mPushPosition, &lPosition, lPosition + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                lSlot.mItem = aItem;
+                __atomic_store_n(&lSlot.mSequence, lPosition + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+        }
+        else if (lPending < 0)
+        {
+            // The slot still holds the item pushed one lap ago.
+            return false;
+        }
+        else
+        {
+            lPosition = __atomic_load_n(&mPushPosition, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ *  Remove the oldest item from the queue. Must only be called from the consumer thread.
+ *
+ *  @param[out] aItem   The item removed from the queue.
+ *
+ *  @return \c true if an item was removed, \c false if the queue is empty or the oldest item is still being pushed.
+ */
+template <typename T, size_t kCapacity>
+bool MPSCQueue<T, kCapacity>::Pop(T & aItem)
+{
+    Slot & lSlot = mSlots[mPopPosition % kCapacity];
+
+    if (__atomic_load_n(&lSlot.mSequence, __ATOMIC_ACQUIRE) != mPopPosition + 1)
+        return false;
+
+    aItem = lSlot.mItem;
+
+    // Free the slot for the producer that will claim it on the next lap.
+    __atomic_store_n(&lSlot.mSequence, mPopPosition + kCapacity, __ATOMIC_RELEASE);
+    mPopPosition++;
+
+    return true;
+}
+
+/**
+ *  Check whether Pop() would fail. Must only be called from the consumer thread.
+ */
+template <typename T, size_t kCapacity>
+bool MPSCQueue<T, kCapacity>::IsEmpty(void) const
+{
+    return __atomic_load_n(&mSlots[mPopPosition % kCapacity].mSequence, __ATOMIC_ACQUIRE) != mPopPosition + 1;
+}
+
+/**
+ *  Call @p aFunction with a reference to each item that Pop() would return, in FIFO order, so that the consumer may update
+ *  the items in place. Items whose push is still in progress are not visited.
+ */
+template <typename T, size_t kCapacity>
+template <typename Function>
+void MPSCQueue<T, kCapacity>::ForEachPending(Function aFunction)
+{
+    // A slot holding a complete item is not written again by the producers until the consumer pops it.
+    for (size_t lPosition = mPopPosition; lPosition < mPopPosition + kCapacity; lPosition++)
+    {
+        Slot & lSlot = mSlots[lPosition % kCapacity];
+
+        if (__atomic_load_n(&lSlot.mSequence, __ATOMIC_ACQUIRE) != lPosition + 1)
+            break;
+
+        aFunction(lSlot.mItem);
+    }
+}
+
+} // namespace chip
+
+#endif // MPSC_QUEUE_H
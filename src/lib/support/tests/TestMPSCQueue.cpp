@@ -0,0 +1,227 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <nlunit-test.h>
+
+#include <support/MPSCQueue.h>
+
+#include <pthread.h>
+#include <string.h>
+
+namespace {
+
+const size_t kNumProducers        = 4;
+const uint32_t kItemsPerProducer  = 10000;
+const size_t kThreadQueueCapacity = 16;
+
+typedef chip::MPSCQueue<uint32_t, kThreadQueueCapacity> ThreadQueue;
+
+struct ProducerContext
+{
+    ThreadQueue * mQueue;
+    uint32_t mProducer;
+};
+
+void * ProducerMain(void * aContext)
+{
+    ProducerContext * lContext = static_cast<ProducerContext *>(aContext);
+
+    for (uint32_t i = 0; i < kItemsPerProducer; i++)
+    {
+        const uint32_t lItem = (lContext->mProducer << 24) | i;
+
+        while (!lContext->mQueue->Push(lItem))
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+} // namespace
+
+static void CheckFifo(nlTestSuite * inSuite, void * inContext)
+{
+    chip::MPSCQueue<int, 4> queue;
+    int item;
+
+    NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+    NL_TEST_ASSERT(inSuite, !queue.Pop(item));
+
+    // Go around the ring several times to exercise the wrap-around.
+    for (int lap = 0; lap < 3; lap++)
+    {
+        NL_TEST_ASSERT(inSuite, queue.Push(lap * 10 + 1));
+        NL_TEST_ASSERT(inSuite, queue.Push(lap * 10 + 2));
+        NL_TEST_ASSERT(inSuite, queue.Push(lap * 10 + 3));
+        NL_TEST_ASSERT(inSuite, !queue.IsEmpty());
+
+        NL_TEST_ASSERT(inSuite, queue.Pop(item) && item == lap * 10 + 1);
+        NL_TEST_ASSERT(inSuite, queue.Pop(item) && item == lap * 10 + 2);
+        NL_TEST_ASSERT(inSuite, queue.Pop(item) && item == lap * 10 + 3);
+        NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+    }
+}
+
+static void CheckFull(nlTestSuite * inSuite, void * inContext)
+{
+    chip::MPSCQueue<int, 4> queue;
+    int item;
+
+    for (int i = 0; i < 4; i++)
+        NL_TEST_ASSERT(inSuite, queue.Push(i));
+
+    NL_TEST_ASSERT(inSuite, !queue.Push(4));
+
+    // Popping one item makes room for exactly one more.
+    NL_TEST_ASSERT(inSuite, queue.Pop(item) && item == 0);
+    NL_TEST_ASSERT(inSuite, queue.Push(4));
+    NL_TEST_ASSERT(inSuite, !queue.Push(5));
+
+    for (int i = 1; i <= 4; i++)
+        NL_TEST_ASSERT(inSuite, queue.Pop(item) && item == i);
+
+    NL_TEST_ASSERT(inSuite, !queue.Pop(item));
+}
+
+static void CheckForEachPending(nlTestSuite * inSuite, void * inContext)
+{
+    chip::MPSCQueue<int, 4> queue;
+    int sum = 0;
+    int item;
+
+    // Start past the first lap, so that the pending items wrap around.
+    for (int i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, queue.Push(i));
+        NL_TEST_ASSERT(inSuite, queue.Pop(item));
+    }
+
+    for (int i = 1; i <= 4; i++)
+        NL_TEST_ASSERT(inSuite, queue.Push(i));
+
+    queue.ForEachPending([&sum](int & pending) {
+        sum += pending;
+        pending *= 10;
+    });
+    NL_TEST_ASSERT(inSuite, sum == 10);
+
+    // The items are updated in place, and none is removed.
+    for (int i = 1; i <= 4; i++)
+        NL_TEST_ASSERT(inSuite, queue.Pop(item) && item == i * 10);
+
+    NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+}
+
+static void CheckConcurrentProducers(nlTestSuite * inSuite, void * inContext)
+{
+    ThreadQueue queue;
+    ProducerContext contexts[kNumProducers];
+    pthread_t threads[kNumProducers];
+    uint32_t next[kNumProducers];
+    uint32_t received = 0;
+
+    memset(next, 0, sizeof(next));
+
+    for (size_t i = 0; i < kNumProducers; i++)
+    {
+        contexts[i].mQueue    = &queue;
+        contexts[i].mProducer = static_cast<uint32_t>(i);
+        NL_TEST_ASSERT(inSuite, pthread_create(&threads[i], NULL, ProducerMain, &contexts[i]) == 0);
+    }
+
+    // Every item must arrive exactly once, and the items of each producer in the order it pushed them.
+    while (received < kNumProducers * kItemsPerProducer)
+    {
+        uint32_t item;
+
+        if (!queue.Pop(item))
+        {
+            sched_yield();
+            continue;
+        }
+
+        const uint32_t lProducer = item >> 24;
+
+        NL_TEST_ASSERT(inSuite, lProducer < kNumProducers);
+        if (lProducer >= kNumProducers)
+            break;
+
+        NL_TEST_ASSERT(inSuite, (item & 0xFFFFFF) == next[lProducer]);
+        next[lProducer] = (item & 0xFFFFFF) + 1;
+        received++;
+    }
+
+    for (size_t i = 0; i < kNumProducers; i++)
+    {
+        pthread_join(threads[i], NULL);
+        NL_TEST_ASSERT(inSuite, next[i] == kItemsPerProducer);
+    }
+
+    NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("FIFO order",           CheckFifo),
+    NL_TEST_DEF("Full queue",           CheckFull),
+    NL_TEST_DEF("Pending items",        CheckForEachPending),
+    NL_TEST_DEF("Concurrent producers", CheckConcurrentProducers),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * inContext)
+{
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * inContext)
+{
+    return (SUCCESS);
+}
+
+int main(int argc, char * argv[])
+{
+    // clang-format off
+    nlTestSuite theSuite = {
+        "mpsc-queue",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
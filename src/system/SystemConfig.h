@@ -336,6 +336,31 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+ *
+ *  @brief
+ *      The number of free packet buffers of each size class that a thread may keep in a private cache when packet buffers are
+ *      allocated from the pool of the BSD sockets configuration, so that allocating and freeing them does not take the pool
+ *      lock. Zero disables the caches.
+ *
+ *      A cache exchanges buffers with the pool in batches of half its size. Buffers held by a cache count as in use and cannot
+ *      be allocated by other threads, so the pool should be large compared to the number of threads times this size. By
+ *      default, caches are enabled with POSIX locking and a pool of at least 64 buffers.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC >= 64
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE 8
+#else
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE 0
+#endif
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE */
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE &&                                                                           \
+    !(CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC)
+#error "CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE requires pool-allocated packet buffers and POSIX locking."
+#endif
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
  *
@@ -378,6 +403,62 @@
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX */
 #endif /* !CHIP_SYSTEM_CONFIG_USE_LWIP */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+ *
+ *  @brief
+ *      The number of small packet buffers, of #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY octets, in the pool of the BSD
+ *      sockets configuration, in addition to the #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC buffers of full size.
+ *
+ *      PacketBuffer::NewWithAvailableSize() takes a buffer from the smallest size class that fits the request and has a free
+ *      buffer, so that short messages such as acknowledgements and status reports do not tie up a buffer of full size. Zero
+ *      disables the class.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+ *
+ *  @brief
+ *      The capacity, including the reserved header space, of a small packet buffer.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY 256
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+ *
+ *  @brief
+ *      The number of medium packet buffers, of #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY octets, in the pool of the BSD
+ *      sockets configuration. Zero disables the class.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *
+ *  @brief
+ *      The capacity, including the reserved header space, of a medium packet buffer.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY 768
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY */
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC || CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+#if CHIP_SYSTEM_CONFIG_USE_LWIP || CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#error "Packet buffer size classes require pool-allocated packet buffers."
+#endif
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY >= CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY ||                           \
+    CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY >= CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
+#error "Packet buffer size classes must be ordered: SMALL_CAPACITY < MEDIUM_CAPACITY < CAPACITY_MAX."
+#endif
+#endif
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 
 /**
@@ -499,6 +580,19 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_WORK_QUEUE_SIZE
+ *
+ *  @brief
+ *      The maximum number of work items scheduled with Layer::ScheduleWork() and not yet run.
+ *
+ *  With sockets, scheduled work is queued without taking a lock or a timer; Layer::ScheduleWork() fails with
+ *  #CHIP_SYSTEM_ERROR_NO_MEMORY once the queue is full. Other configurations take a timer for each work item.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_WORK_QUEUE_SIZE
+#define CHIP_SYSTEM_CONFIG_WORK_QUEUE_SIZE 32
+#endif /* CHIP_SYSTEM_CONFIG_WORK_QUEUE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -510,6 +604,54 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS 0
 #endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS
+ *
+ *  @brief
+ *      The width, 8, 16 or 32 bits, of the signed counts of resources in use and of their high watermarks kept by
+ *      System::Stats. Counts above the maximum of the type saturate.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS
+#define CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS 32
+#endif // CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS
+ *
+ *  @brief
+ *      The width, 32 or 64 bits, of the monotonic throughput counters kept by System::Stats, e.g. the number of bytes sent.
+ *      The counters are updated atomically; platforms without 64-bit atomic operations should use 32-bit counters, which
+ *      wrap around.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS
+#define CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS 64
+#endif // CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the CHIP System Layer measures how long the event loop waits and how long each
+ *      timer, scheduled work item, endpoint I/O handler and device event handler runs. See System::LoopMetrics.
+ *
+ *      The metrics are kept once per process without synchronization: only enable them in a process whose System::Layer
+ *      objects are all serviced by a single event loop thread.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
+#define CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS 0
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES
+ *
+ *  @brief
+ *      The number of distinct callbacks, endpoint types and event types the event loop metrics keep a duration histogram
+ *      for. Further sources are accounted together as a single overflow source.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES
+#define CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES 32
+#endif // CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_TEST
  *
@@ -609,4 +751,59 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_VALID_REAL_TIME_THRESHOLD 946684800
 #endif // CHIP_SYSTEM_CONFIG_VALID_REAL_TIME_THRESHOLD
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_EPOLL
+ *
+ *  @brief
+ *      Use epoll(7) rather than select(2) to wait for socket readiness.
+ *
+ *  When enabled, endpoints register their sockets with the System Layer once and are only re-evaluated when their state
+ *  changes, so the per-iteration cost of the event loop is proportional to the number of active sockets rather than to the
+ *  highest file descriptor. Event loops use Layer::PrepareEvents(), Layer::WaitForEvents() and Layer::HandleEvents() in place
+ *  of the PrepareSelect() / HandleSelectResult() pairs of the System and Inet layers.
+ *
+ *  Only available on Linux with sockets.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_EPOLL
+#define CHIP_SYSTEM_CONFIG_USE_EPOLL 0
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+#error "FORBIDDEN: CHIP_SYSTEM_CONFIG_USE_EPOLL without CHIP_SYSTEM_CONFIG_USE_SOCKETS on Linux"
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      The maximum number of socket readiness events retrieved by a single call to Layer::WaitForEvents(). Further ready
+ *      sockets are reported by the next call.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif // CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_EVENTFD
+ *
+ *  @brief
+ *      Use an eventfd(2) rather than a pipe to wake the thread running the event loop.
+ *
+ *  An eventfd takes a single file descriptor and is cleared with a single read, however many times it was signalled. In both
+ *  cases, Layer::WakeSelect() only signals the event loop thread when it is not already about to wake up.
+ *
+ *  Enabled by default on Linux with sockets.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_EVENTFD
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__)
+#define CHIP_SYSTEM_CONFIG_USE_EVENTFD 1
+#else // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+#define CHIP_SYSTEM_CONFIG_USE_EVENTFD 0
+#endif // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+#endif // CHIP_SYSTEM_CONFIG_USE_EVENTFD
+
+#if CHIP_SYSTEM_CONFIG_USE_EVENTFD && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+#error "FORBIDDEN: CHIP_SYSTEM_CONFIG_USE_EVENTFD without CHIP_SYSTEM_CONFIG_USE_SOCKETS on Linux"
+#endif // CHIP_SYSTEM_CONFIG_USE_EVENTFD && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+
 #endif // defined(SYSTEMCONFIG_H)
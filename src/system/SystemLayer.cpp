@@ -30,6 +30,7 @@
 
 // Include local headers
 #include <system/SystemClock.h>
+#include <system/SystemLoopMetrics.h>
 #include <system/SystemTimer.h>
 
 // Include additional CHIP headers
@@ -39,6 +40,7 @@
 
 // Include system and language headers
 #include <stddef.h>
+#include <string.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #include <errno.h>
@@ -46,6 +48,14 @@
 #include <unistd.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+#if CHIP_SYSTEM_CONFIG_USE_EVENTFD
+#include <sys/eventfd.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EVENTFD
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #if !CHIP_SYSTEM_CONFIG_PLATFORM_PROVIDES_EVENT_FUNCTIONS
 #include <lwip/err.h>
@@ -97,22 +107,36 @@ Layer::Layer() : mLayerState(kLayerState_NotInitialized), mContext(NULL), mPlatf
     this->mTimerComplete     = false;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+    memset(this->mTimerTable, 0, sizeof(this->mTimerTable));
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     this->mWakePipeIn  = 0;
     this->mWakePipeOut = 0;
+    this->mWakePending = 0;
+
+    this->mTimerHeapSize = 0;
+    this->mTimerSequence = 0;
 
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    this->mEpollFD     = -1;
+    this->mRefreshList = NULL;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 Error Layer::Init(void * aContext)
 {
     Error lReturn;
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    int lOSReturn;
+#if !CHIP_SYSTEM_CONFIG_USE_EVENTFD
     int lPipeFDs[2];
-    int lOSReturn, lFlags;
+    int lFlags;
+#endif // !CHIP_SYSTEM_CONFIG_USE_EVENTFD
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     RegisterLayerErrorFormatter();
@@ -134,6 +158,14 @@ Error Layer::Init(void * aContext)
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_EVENTFD
+    // Create an eventfd to allow an arbitrary thread to wake the thread in the select loop.
+    lOSReturn = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    VerifyOrExit(lOSReturn >= 0, lReturn = chip::System::MapErrorPOSIX(errno));
+
+    this->mWakePipeIn  = lOSReturn;
+    this->mWakePipeOut = lOSReturn;
+#else  // !CHIP_SYSTEM_CONFIG_USE_EVENTFD
     // Create a Unix pipe to allow an arbitrary thread to wake the thread in the select loop.
     lOSReturn = ::pipe(lPipeFDs);
     VerifyOrExit(lOSReturn == 0, lReturn = chip::System::MapErrorPOSIX(errno));
@@ -149,8 +181,29 @@ Error Layer::Init(void * aContext)
     lFlags    = ::fcntl(this->mWakePipeOut, F_GETFL, 0);
     lOSReturn = ::fcntl(this->mWakePipeOut, F_SETFL, lFlags | O_NONBLOCK);
     VerifyOrExit(lOSReturn == 0, lReturn = chip::System::MapErrorPOSIX(errno));
+#endif // !CHIP_SYSTEM_CONFIG_USE_EVENTFD
+
+    this->mWakePending = 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    this->mEpollFD = ::epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrExit(this->mEpollFD >= 0, lReturn = chip::System::MapErrorPOSIX(errno));
+
+    // The wake pipe is the only registration without a watch; it is identified by a NULL data pointer.
+    {
+        struct epoll_event lEvent;
+
+        lEvent.events   = EPOLLIN;
+        lEvent.data.ptr = NULL;
+
+        lOSReturn = ::epoll_ctl(this->mEpollFD, EPOLL_CTL_ADD, this->mWakePipeIn, &lEvent);
+        VerifyOrExit(lOSReturn == 0, lReturn = chip::System::MapErrorPOSIX(errno));
+    }
+
+    this->mRefreshList = NULL;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     this->mLayerState = kLayerState_Initialized;
     this->mContext    = aContext;
 
@@ -172,17 +225,37 @@ Error Layer::Shutdown()
     SuccessOrExit(lReturn);
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    // Discard the work that has not run, as the timers are cancelled below.
+    {
+        ScheduledWork lWork;
+
+        while (this->mScheduledWork.Pop(lWork))
+            ;
+    }
+
     if (this->mWakePipeOut != -1)
     {
+        if (this->mWakePipeIn != this->mWakePipeOut)
+            ::close(this->mWakePipeIn);
         ::close(this->mWakePipeOut);
         this->mWakePipeOut = -1;
         this->mWakePipeIn  = -1;
     }
 #endif
 
-    for (size_t i = 0; i < Timer::sPool.Size(); ++i)
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    if (this->mEpollFD != -1)
+    {
+        ::close(this->mEpollFD);
+        this->mEpollFD = -1;
+    }
+
+    this->mRefreshList = NULL;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+    for (size_t i = 0; i < mTimerPool.Size(); ++i)
     {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
+        Timer * lTimer = mTimerPool.Get(*this, i);
 
         if (lTimer != NULL)
         {
@@ -220,6 +293,20 @@ void Layer::SetPlatformData(void * aPlatformData)
     this->mPlatformData = aPlatformData;
 }
 
+/**
+ * This fills in the statistics of the resources allocated from the pools of this layer, i.e. its timers.
+ *
+ * Each layer has its own pools, so with several layers the statistics of each are reported separately.
+ *
+ * @param[out]  aSnapshot  The snapshot to update.
+ *
+ */
+void Layer::UpdateSnapshot(Stats::Snapshot & aSnapshot)
+{
+    mTimerPool.GetStatistics(aSnapshot.mResourcesInUse[Stats::kSystemLayer_NumTimers],
+                             aSnapshot.mHighWatermarks[Stats::kSystemLayer_NumTimers]);
+}
+
 Error Layer::NewTimer(Timer *& aTimerPtr)
 {
     Timer * lTimer = NULL;
@@ -227,7 +314,7 @@ Error Layer::NewTimer(Timer *& aTimerPtr)
     if (this->State() != kLayerState_Initialized)
         return CHIP_SYSTEM_ERROR_UNEXPECTED_STATE;
 
-    lTimer    = Timer::sPool.TryCreate(*this);
+    lTimer    = mTimerPool.TryCreate(*this);
     aTimerPtr = lTimer;
 
     if (lTimer == NULL)
@@ -274,6 +361,7 @@ void Layer::StartTimer(uint32_t aMilliseconds, chip::Callback::Callback<> * cb)
     ca->mInfoScalar = Timer::GetCurrentEpoch() + aMilliseconds;
 
     mTimerCallbacks.InsertBy(ca, TimerCompare, nullptr);
+    SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_TimerStarts);
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     if (mTimerCallbacks.First() == ca)
@@ -328,7 +416,8 @@ exit:
 
 /**
  * @brief
- *   This method cancels a one-shot timer, started earlier through @p StartTimer().
+ *   This method cancels a one-shot timer, started earlier through @p StartTimer(), as well as any work scheduled through
+ *   @p ScheduleWork() with the same arguments that has not run yet.
  *
  *   @note
  *       The cancellation could fail silently in two different ways. If the timer specified by the combination of the callback
@@ -341,19 +430,23 @@ exit:
  */
 void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void * aAppState)
 {
+    Timer * lTimer;
+
     if (this->State() != kLayerState_Initialized)
         return;
 
-    for (size_t i = 0; i < Timer::sPool.Size(); ++i)
-    {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
+    lTimer = Timer::Find(*this, aOnComplete, aAppState);
+    if (lTimer != NULL)
+        lTimer->Cancel();
 
-        if (lTimer != NULL && lTimer->OnComplete == aOnComplete && lTimer->AppState == aAppState)
-        {
-            lTimer->Cancel();
-            break;
-        }
-    }
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    // Work scheduled with the same function and state is cancelled too, as it was when it ran from a timer. The entries cannot
+    // be removed from the middle of the queue, so they are cleared in place and skipped by HandleTimers().
+    this->mScheduledWork.ForEachPending([aOnComplete, aAppState](ScheduledWork & aWork) {
+        if (aWork.mComplete == aOnComplete && aWork.mAppState == aAppState)
+            aWork.mComplete = NULL;
+    });
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
 /**
@@ -383,14 +476,33 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void * aAppState)
  * @retval CHIP_SYSTEM_ERROR_UNEXPECTED_STATE If the SystemLayer has
  *                      not been initialized.
  *
- * @retval CHIP_SYSTEM_ERROR_NO_MEMORY If the SystemLayer cannot
- *                      allocate a new timer.
+ * @retval CHIP_SYSTEM_ERROR_NO_MEMORY If the scheduled work queue is
+ *                      full (sockets) or the SystemLayer cannot allocate
+ *                      a new timer (LwIP).
  *
  * @retval CHIP_SYSTEM_NO_ERROR On success.
  */
 Error Layer::ScheduleWork(TimerCompleteFunct aComplete, void * aAppState)
 {
     Error lReturn;
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    ScheduledWork lWork;
+
+    VerifyOrExit(this->State() == kLayerState_Initialized, lReturn = CHIP_SYSTEM_ERROR_UNEXPECTED_STATE);
+
+    // The work is queued without a lock or a timer; the event loop runs it on its next pass.
+    lWork.mComplete = aComplete;
+    lWork.mAppState = aAppState;
+
+    if (!this->mScheduledWork.Push(lWork))
+    {
+        ChipLogError(chipSystemLayer, "Scheduled work queue FULL");
+        ExitNow(lReturn = CHIP_SYSTEM_ERROR_NO_MEMORY);
+    }
+
+    lReturn = CHIP_SYSTEM_NO_ERROR;
+    this->WakeSelect();
+#else  // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
     Timer * lTimer;
 
     lReturn = this->NewTimer(lTimer);
@@ -401,6 +513,7 @@ Error Layer::ScheduleWork(TimerCompleteFunct aComplete, void * aAppState)
     {
         lTimer->Release();
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 exit:
     return lReturn;
@@ -593,6 +706,8 @@ void Layer::DispatchTimerCallbacks(const uint64_t kCurrentEpoch)
     {
         // one-shot
         chip::Callback::Callback<> * cb = chip::Callback::Callback<>::FromCancelable(ready.mNext);
+        SYSTEM_LOOP_METRICS_SCOPE(kSource_Timer, cb->mCall);
+        SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_TimerFires);
         cb->Cancel();
         cb->mCall(cb->mContext);
     }
@@ -601,43 +716,28 @@ void Layer::DispatchTimerCallbacks(const uint64_t kCurrentEpoch)
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 /**
- *  Prepare the sets of file descriptors for @p select() to work with.
+ *  Reduce the sleep time of the I/O thread to the expiration of the earliest pending timer.
  *
- *  @param[out] aSetSize        The range of file descriptors in the file descriptor set.
- *  @param[in]  aReadSet        A pointer to the set of readable file descriptors.
- *  @param[in]  aWriteSet       A pointer to the set of writable file descriptors.
- *  @param[in]  aExceptionSet   A pointer to the set of file descriptors with errors.
- *  @param[in]  aSleepTime      A reference to the maximum sleep time.
+ *  @param[in,out]  aSleepTime  The maximum sleep time, reduced on return.
  */
-void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet,
-                          struct timeval & aSleepTime)
+void Layer::GetSleepTime(struct timeval & aSleepTime)
 {
-    if (this->State() != kLayerState_Initialized)
-        return;
-
-    if (this->mWakePipeIn + 1 > aSetSize)
-        aSetSize = this->mWakePipeIn + 1;
-
-    FD_SET(this->mWakePipeIn, aReadSet);
-
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
     Timer::Epoch lAwakenEpoch = kCurrentEpoch + static_cast<Timer::Epoch>(aSleepTime.tv_sec) * 1000 + aSleepTime.tv_usec / 1000;
 
-    for (size_t i = 0; i < Timer::sPool.Size(); i++)
+    if (!this->mScheduledWork.IsEmpty())
     {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
+        lAwakenEpoch = kCurrentEpoch;
+    }
+    else if (this->mTimerHeapSize > 0)
+    {
+        // The earliest timer is at the top of the heap.
+        const Timer::Epoch kTimerEpoch = this->mTimerHeap[0]->mAwakenEpoch;
 
-        if (lTimer != NULL)
-        {
-            if (!Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch))
-            {
-                lAwakenEpoch = kCurrentEpoch;
-                break;
-            }
-
-            if (Timer::IsEarlierEpoch(lTimer->mAwakenEpoch, lAwakenEpoch))
-                lAwakenEpoch = lTimer->mAwakenEpoch;
-        }
+        if (!Timer::IsEarlierEpoch(kCurrentEpoch, kTimerEpoch))
+            lAwakenEpoch = kCurrentEpoch;
+        else if (Timer::IsEarlierEpoch(kTimerEpoch, lAwakenEpoch))
+            lAwakenEpoch = kTimerEpoch;
     }
 
     // check for an earlier callback timer, too
@@ -655,6 +755,97 @@ void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet,
     aSleepTime.tv_usec            = (kSleepTime % 1000) * 1000;
 }
 
+/**
+ *  Clear the contents of the wake pipe after the I/O thread was woken through it.
+ *
+ *  This must be called before the I/O thread looks for the work it was woken for: once the pending flag is cleared, the next
+ *  WakeSelect() signals the wake pipe again.
+ */
+void Layer::DrainWakePipe(void)
+{
+#if CHIP_SYSTEM_CONFIG_USE_EVENTFD
+    uint64_t lCount;
+    const ssize_t kIOResult = ::read(this->mWakePipeIn, &lCount, sizeof(lCount));
+    static_cast<void>(kIOResult);
+#else  // !CHIP_SYSTEM_CONFIG_USE_EVENTFD
+    while (true)
+    {
+        uint8_t lBytes[128];
+        int lTmp = ::read(this->mWakePipeIn, static_cast<void *>(lBytes), sizeof(lBytes));
+        if (lTmp < static_cast<int>(sizeof(lBytes)))
+            break;
+    }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EVENTFD
+
+    // The full barrier keeps the queue and timer checks that follow from being satisfied before the flag is seen cleared;
+    // otherwise a thread could push work, still see the flag set and skip the wake-up, while this thread misses the work.
+    __atomic_store_n(&this->mWakePending, 0, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ *  Run the timers and timer callbacks that have expired.
+ */
+void Layer::HandleTimers(void)
+{
+    const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
+    const uint32_t kLastSequence     = this->mTimerSequence;
+    ScheduledWork lWork;
+
+    // Run the scheduled work in batches of at most one queue's worth, so that work rescheduling itself cannot starve the I/O.
+    for (size_t i = 0; i < CHIP_SYSTEM_CONFIG_WORK_QUEUE_SIZE && this->mScheduledWork.Pop(lWork); i++)
+    {
+        // Cancelled by CancelTimer().
+        if (lWork.mComplete == NULL)
+            continue;
+
+        SYSTEM_LOOP_METRICS_SCOPE(kSource_Work, lWork.mComplete);
+        lWork.mComplete(this, lWork.mAppState, CHIP_SYSTEM_NO_ERROR);
+    }
+
+    // Fire the expired timers in expiration order. Timers started by their callbacks are left for the next pass, even when
+    // already expired, so that a callback re-arming itself with no delay cannot starve the I/O.
+    while (this->mTimerHeapSize > 0)
+    {
+        Timer * lTimer = this->mTimerHeap[0];
+
+        if (Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch) ||
+            static_cast<int32_t>(lTimer->mSequence - kLastSequence) >= 0)
+            break;
+
+        SYSTEM_LOOP_METRICS_TIMER_LAG(static_cast<uint64_t>(kCurrentEpoch - lTimer->mAwakenEpoch) * 1000);
+        SYSTEM_LOOP_METRICS_SCOPE(kSource_Timer, lTimer->OnComplete);
+        lTimer->HandleComplete();
+    }
+
+    DispatchTimerCallbacks(kCurrentEpoch);
+}
+
+#if !CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+/**
+ *  Prepare the sets of file descriptors for @p select() to work with.
+ *
+ *  @param[out] aSetSize        The range of file descriptors in the file descriptor set.
+ *  @param[in]  aReadSet        A pointer to the set of readable file descriptors.
+ *  @param[in]  aWriteSet       A pointer to the set of writable file descriptors.
+ *  @param[in]  aExceptionSet   A pointer to the set of file descriptors with errors.
+ *  @param[in]  aSleepTime      A reference to the maximum sleep time.
+ */
+void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet,
+                          struct timeval & aSleepTime)
+{
+    if (this->State() != kLayerState_Initialized)
+        return;
+
+    if (this->mWakePipeIn + 1 > aSetSize)
+        aSetSize = this->mWakePipeIn + 1;
+
+    FD_SET(this->mWakePipeIn, aReadSet);
+
+    GetSleepTime(aSleepTime);
+}
+
 /**
  * Handle I/O from a select call. This method registers the pending I/O event in each active endpoint and then invokes the
  * respective I/O handling functions for those endpoints.
@@ -687,50 +878,32 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
     lThreadSelf = pthread_self();
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
-    if (aSetSize > 0)
+    // If we woke because of someone writing to the wake pipe, clear the contents of the pipe before returning.
+    if (aSetSize > 0 && FD_ISSET(this->mWakePipeIn, aReadSet))
     {
-        // If we woke because of someone writing to the wake pipe, clear the contents of the pipe before returning.
-        if (FD_ISSET(this->mWakePipeIn, aReadSet))
-        {
-            while (true)
-            {
-                uint8_t lBytes[128];
-                int lTmp = ::read(this->mWakePipeIn, static_cast<void *>(lBytes), sizeof(lBytes));
-                if (lTmp < static_cast<int>(sizeof(lBytes)))
-                    break;
-            }
-        }
+        DrainWakePipe();
     }
 
-    const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
-
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = lThreadSelf;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
-    for (size_t i = 0; i < Timer::sPool.Size(); i++)
-    {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
-
-        if (lTimer != NULL && !Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch))
-        {
-            lTimer->HandleComplete();
-        }
-    }
-
-    DispatchTimerCallbacks(kCurrentEpoch);
+    HandleTimers();
 
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 }
 
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 /**
  * Wake up the I/O thread that monitors the file descriptors using select() by writing a single byte to the wake pipe.
  *
  *  @note
  *      If @p WakeSelect() is being called from within @p HandleSelectResult(), then writing to the wake pipe can be skipped,
- * since the I/O thread is already awake.
+ * since the I/O thread is already awake. Likewise, the write is skipped while an earlier one has not been drained yet, so that a
+ * burst of wake requests from other threads costs a single system call.
  *
  *      Furthermore, we don't care if this write fails as the only reasonably likely failure is that the pipe is full, in which
  *      case the select calling thread is going to wake up anyway.
@@ -747,14 +920,287 @@ void Layer::WakeSelect()
     }
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
+    // The I/O thread clears the pending flag, then looks for work, each side of a full barrier. The sequentially consistent
+    // exchange orders the caller's work before the flag is read, so either the I/O thread sees that work, or this call sees
+    // the flag cleared and signals the wake pipe.
+    if (__atomic_exchange_n(&this->mWakePending, 1, __ATOMIC_SEQ_CST) != 0)
+        return;
+
+#if CHIP_SYSTEM_CONFIG_USE_EVENTFD
+    // Signal the eventfd to wake up the select call.
+    const uint64_t kCount   = 1;
+    const ssize_t kIOResult = ::write(this->mWakePipeOut, &kCount, sizeof(kCount));
+#else  // !CHIP_SYSTEM_CONFIG_USE_EVENTFD
     // Write a single byte to the wake pipe to wake up the select call.
     const uint8_t kByte     = 0;
     const ssize_t kIOResult = ::write(this->mWakePipeOut, &kByte, 1);
+#endif // !CHIP_SYSTEM_CONFIG_USE_EVENTFD
     static_cast<void>(kIOResult);
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+/**
+ *  Initialize a socket watch that is not yet associated with a socket.
+ *
+ *  @param[in]  aPrepare    The function reporting the events the owner waits for.
+ *  @param[in]  aHandler    The function handling pending events.
+ *  @param[in]  aOwner      The object owning the socket, available to both functions through GetOwner().
+ */
+void SocketWatch::Init(PrepareFunct aPrepare, HandlerFunct aHandler, void * aOwner)
+{
+    mPrepare          = aPrepare;
+    mHandler          = aHandler;
+    mOwner            = aOwner;
+    mNextRefresh      = NULL;
+    mFD               = -1;
+    mRegisteredEvents = 0;
+    mPendingEvents    = 0;
+    mRefreshQueued    = false;
+}
+
+static uint32_t EpollEventsFromWatchEvents(uint8_t aEvents)
+{
+    uint32_t lEvents = 0;
+
+    if (aEvents & SocketWatch::kRead)
+        lEvents |= EPOLLIN;
+    if (aEvents & SocketWatch::kWrite)
+        lEvents |= EPOLLOUT;
+
+    return lEvents;
+}
+
+static uint8_t WatchEventsFromEpollEvents(uint32_t aEvents, uint8_t aRegisteredEvents)
+{
+    uint8_t lEvents = 0;
+
+    if (aEvents & EPOLLIN)
+        lEvents |= SocketWatch::kRead;
+    if (aEvents & EPOLLOUT)
+        lEvents |= SocketWatch::kWrite;
+
+    // Like select(), report error and hang-up conditions as readiness for whatever the owner waits for, so that the
+    // subsequent I/O call picks up the condition.
+    if (aEvents & (EPOLLERR | EPOLLHUP))
+        lEvents |= aRegisteredEvents;
+    if (aEvents & EPOLLERR)
+        lEvents |= SocketWatch::kError;
+
+    return lEvents;
+}
+
+/**
+ *  Start watching a socket. The events to wait for are obtained from the prepare function of @a aWatch on the next call to
+ *  PrepareEvents().
+ *
+ *  @param[in]  aWatch  The watch to associate with the socket.
+ *  @param[in]  aFD     The socket descriptor.
+ *
+ *  @retval CHIP_SYSTEM_NO_ERROR                On success.
+ *  @retval CHIP_SYSTEM_ERROR_UNEXPECTED_STATE  If the layer is not initialized.
+ */
+Error Layer::StartWatch(SocketWatch & aWatch, int aFD)
+{
+    if (this->State() != kLayerState_Initialized)
+        return CHIP_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    StopWatch(aWatch);
+
+    aWatch.mFD = aFD;
+    RefreshWatch(aWatch);
+
+    return CHIP_SYSTEM_NO_ERROR;
+}
+
+/**
+ *  Stop watching the socket of @a aWatch. Must be called before the socket is closed. Events already retrieved for the socket
+ *  but not yet dispatched are discarded.
+ */
+void Layer::StopWatch(SocketWatch & aWatch)
+{
+    if (!aWatch.IsWatching())
+        return;
+
+    if (aWatch.mRegisteredEvents != 0)
+        ::epoll_ctl(this->mEpollFD, EPOLL_CTL_DEL, aWatch.mFD, NULL);
+
+    if (aWatch.mRefreshQueued)
+    {
+        SocketWatch ** lLink = &this->mRefreshList;
+
+        while (*lLink != &aWatch)
+            lLink = &(*lLink)->mNextRefresh;
+
+        *lLink                = aWatch.mNextRefresh;
+        aWatch.mNextRefresh   = NULL;
+        aWatch.mRefreshQueued = false;
+    }
+
+    aWatch.mFD               = -1;
+    aWatch.mRegisteredEvents = 0;
+    aWatch.mPendingEvents    = 0;
+}
+
+/**
+ *  Request that the events the owner of @a aWatch waits for be re-evaluated before the I/O thread waits again, and wake the
+ *  I/O thread if it is currently waiting.
+ */
+void Layer::RefreshWatch(SocketWatch & aWatch)
+{
+    if (this->State() != kLayerState_Initialized || !aWatch.IsWatching())
+        return;
+
+    QueueRefresh(aWatch);
+    WakeSelect();
+}
+
+void Layer::QueueRefresh(SocketWatch & aWatch)
+{
+    if (aWatch.mRefreshQueued)
+        return;
+
+    aWatch.mRefreshQueued = true;
+    aWatch.mNextRefresh   = this->mRefreshList;
+    this->mRefreshList    = &aWatch;
+}
+
+/**
+ *  Update the epoll registrations of all watches that requested a refresh and compute the time the I/O thread may sleep.
+ *
+ *  Watches waiting for no event are removed from the epoll set, so that error and hang-up conditions, which epoll always
+ *  reports, do not wake the I/O thread for sockets nobody is interested in.
+ *
+ *  @param[in,out]  aSleepTime  The maximum sleep time, reduced to the expiration of the earliest timer on return.
+ */
+void Layer::PrepareEvents(struct timeval & aSleepTime)
+{
+    SocketWatch * lWatch;
+
+    if (this->State() != kLayerState_Initialized)
+        return;
+
+    lWatch             = this->mRefreshList;
+    this->mRefreshList = NULL;
+
+    while (lWatch != NULL)
+    {
+        SocketWatch & lCurrent = *lWatch;
+        bool lRecheck          = false;
+        uint8_t lEvents;
+
+        lWatch                  = lCurrent.mNextRefresh;
+        lCurrent.mNextRefresh   = NULL;
+        lCurrent.mRefreshQueued = false;
+
+        lEvents = lCurrent.mPrepare(lCurrent, lRecheck) & (SocketWatch::kRead | SocketWatch::kWrite);
+
+        if (lEvents != lCurrent.mRegisteredEvents)
+        {
+            struct epoll_event lEvent;
+            int lOperation;
+
+            lEvent.events   = EpollEventsFromWatchEvents(lEvents);
+            lEvent.data.ptr = &lCurrent;
+
+            if (lCurrent.mRegisteredEvents == 0)
+                lOperation = EPOLL_CTL_ADD;
+            else if (lEvents == 0)
+                lOperation = EPOLL_CTL_DEL;
+            else
+                lOperation = EPOLL_CTL_MOD;
+
+            if (::epoll_ctl(this->mEpollFD, lOperation, lCurrent.mFD, &lEvent) == 0)
+                lCurrent.mRegisteredEvents = lEvents;
+            else
+                ChipLogError(chipSystemLayer, "epoll_ctl(%d) failed for fd %d: %d", lOperation, lCurrent.mFD, errno);
+        }
+
+        if (lRecheck)
+            QueueRefresh(lCurrent);
+    }
+
+    GetSleepTime(aSleepTime);
+}
+
+/**
+ *  Wait for socket readiness, a wake-up request or the expiration of the sleep time, whichever comes first.
+ *
+ *  The retrieved events are kept by the layer until the next call to HandleEvents(). This method may be called without holding
+ *  the stack lock, but only from the thread that calls PrepareEvents() and HandleEvents().
+ *
+ *  @param[in]  aSleepTime  The maximum sleep time, as computed by PrepareEvents().
+ *
+ *  @return The number of retrieved events, or -1 with errno set on failure.
+ */
+int Layer::WaitForEvents(const struct timeval & aSleepTime)
+{
+    const int kTimeoutMS = static_cast<int>(aSleepTime.tv_sec * 1000 + (aSleepTime.tv_usec + 999) / 1000);
+
+    return ::epoll_wait(this->mEpollFD, this->mEvents, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, kTimeoutMS);
+}
+
+/**
+ *  Dispatch the events retrieved by WaitForEvents() to the handlers of their watches and run expired timers.
+ *
+ *  @note
+ *      As with HandleSelectResult(), the pending events of all watches are recorded *before* any handler or timer runs.
+ *      Stopping a watch discards its pending events, so that a socket closed and re-opened from within a callback never
+ *      receives events that belong to its previous incarnation.
+ *
+ *  @param[in]  aEventCount     The return value of WaitForEvents().
+ */
+void Layer::HandleEvents(int aEventCount)
+{
+    if (this->State() != kLayerState_Initialized)
+        return;
+
+    if (aEventCount < 0)
+        return;
+
+    for (int i = 0; i < aEventCount; i++)
+    {
+        SocketWatch * lWatch = static_cast<SocketWatch *>(this->mEvents[i].data.ptr);
+
+        if (lWatch == NULL)
+            DrainWakePipe();
+        else
+            lWatch->mPendingEvents = WatchEventsFromEpollEvents(this->mEvents[i].events, lWatch->mRegisteredEvents);
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    this->mHandleSelectThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    HandleTimers();
+
+    for (int i = 0; i < aEventCount; i++)
+    {
+        SocketWatch * lWatch = static_cast<SocketWatch *>(this->mEvents[i].data.ptr);
+        uint8_t lEvents;
+
+        if (lWatch == NULL || lWatch->mPendingEvents == 0)
+            continue;
+
+        lEvents                = lWatch->mPendingEvents;
+        lWatch->mPendingEvents = 0;
+
+        lWatch->mHandler(*lWatch, lEvents);
+
+        // Handling I/O typically changes what the owner waits for, e.g. once a send queue drains.
+        if (lWatch->IsWatching())
+            QueueRefresh(*lWatch);
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    this->mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 LwIPEventHandlerDelegate Layer::sSystemEventHandlerDelegate;
 
@@ -32,15 +32,22 @@
 #include <core/CHIPCallback.h>
 
 #include <support/DLLUtil.h>
+#include <support/MPSCQueue.h>
 #include <system/SystemError.h>
 #include <system/SystemEvent.h>
 #include <system/SystemObject.h>
+#include <system/SystemStats.h>
+#include <system/SystemTimer.h>
 
 // Include dependent headers
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #include <sys/select.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 #include <pthread.h>
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -110,6 +117,57 @@ private:
 };
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  @class SocketWatch
+ *
+ *  @brief
+ *      Registration of a socket with the epoll backend of a Layer object.
+ *
+ *      The owner of the socket supplies two functions: a prepare function that reports the I/O events the owner currently
+ *      waits for, and a handler function that is called with the events that became pending. The prepare function is only
+ *      consulted when the owner calls Layer::RefreshWatch() and after each dispatch to the handler, unless it asks to be
+ *      consulted again on the next iteration of the event loop.
+ */
+class DLL_EXPORT SocketWatch
+{
+public:
+    enum
+    {
+        kRead  = 0x01, /**< The socket is readable. */
+        kWrite = 0x02, /**< The socket is writable. */
+        kError = 0x04, /**< The socket has an error condition. */
+    };
+
+    /**
+     *  Report the events the owner of @a aWatch waits for. Set @a aRecheck to true if the answer may change without the
+     *  owner calling Layer::RefreshWatch(), e.g. because it depends on a callback that is assigned directly by the application.
+     */
+    typedef uint8_t (*PrepareFunct)(SocketWatch & aWatch, bool & aRecheck);
+
+    /** Handle the I/O events @a aEvents that are pending on the socket of @a aWatch. */
+    typedef void (*HandlerFunct)(SocketWatch & aWatch, uint8_t aEvents);
+
+    void Init(PrepareFunct aPrepare, HandlerFunct aHandler, void * aOwner);
+
+    int GetFD(void) const { return mFD; }
+    void * GetOwner(void) const { return mOwner; }
+    bool IsWatching(void) const { return mFD >= 0; }
+
+private:
+    friend class Layer;
+
+    PrepareFunct mPrepare;
+    HandlerFunct mHandler;
+    void * mOwner;
+    SocketWatch * mNextRefresh;
+    int mFD;
+    uint8_t mRegisteredEvents;
+    uint8_t mPendingEvents;
+    bool mRefreshQueued;
+};
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 /**
  *  @class Layer
  *
@@ -117,7 +175,7 @@ private:
  *      This provides access to timers according to the configured event handling model.
  *
  *      For \c CHIP_SYSTEM_CONFIG_USE_SOCKETS, event readiness notification is handled via traditional poll/select implementation on
- *      the platform adaptation.
+ *      the platform adaptation, or via epoll when \c CHIP_SYSTEM_CONFIG_USE_EPOLL is enabled.
  *
  *      For \c CHIP_SYSTEM_CONFIG_USE_LWIP, event readiness notification is handle via events / messages and platform- and
  *      system-specific hooks for the event/message system.
@@ -135,6 +193,8 @@ public:
 
     LayerState State(void) const;
 
+    void UpdateSnapshot(Stats::Snapshot & aSnapshot);
+
     Error NewTimer(Timer *& aTimerPtr);
 
     void StartTimer(uint32_t aMilliseconds, chip::Callback::Callback<> * cb);
@@ -147,11 +207,23 @@ public:
     Error ScheduleWork(TimerCompleteFunct aComplete, void * aAppState);
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if !CHIP_SYSTEM_CONFIG_USE_EPOLL
     void PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet, struct timeval & aSleepTime);
     void HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet);
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     void WakeSelect(void);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    Error StartWatch(SocketWatch & aWatch, int aFD);
+    void StopWatch(SocketWatch & aWatch);
+    void RefreshWatch(SocketWatch & aWatch);
+
+    void PrepareEvents(struct timeval & aSleepTime);
+    int WaitForEvents(const struct timeval & aSleepTime);
+    void HandleEvents(int aEventCount);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     typedef Error (*EventHandler)(Object & aTarget, EventType aEventType, uintptr_t aArgument);
     Error AddEventHandlerDelegate(LwIPEventHandlerDelegate & aDelegate);
@@ -179,6 +251,12 @@ private:
     void * mPlatformData;
     chip::Callback::CallbackDeque mTimerCallbacks;
 
+    // Timers of this layer only, so that independent layers running on different threads share no state.
+    ObjectPool<Timer, CHIP_SYSTEM_CONFIG_NUM_TIMERS> mTimerPool;
+
+    // Armed timers, hashed by completion function and application state so that CancelTimer() does not scan the pool.
+    Timer * mTimerTable[CHIP_SYSTEM_CONFIG_NUM_TIMERS];
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     static LwIPEventHandlerDelegate sSystemEventHandlerDelegate;
 
@@ -188,14 +266,41 @@ private:
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    // Both ends of the wake pipe, or the same eventfd for both with CHIP_SYSTEM_CONFIG_USE_EVENTFD.
     int mWakePipeIn;
     int mWakePipeOut;
+    uint32_t mWakePending; // Non-zero while the wake pipe has been signalled and not yet drained.
 
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     pthread_t mHandleSelectThread;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Armed timers as a binary min-heap ordered by expiration.
+    Timer * mTimerHeap[CHIP_SYSTEM_CONFIG_NUM_TIMERS];
+    size_t mTimerHeapSize;
+    uint32_t mTimerSequence;
+
+    // Work scheduled with ScheduleWork(), which may be called from any thread, in FIFO order.
+    struct ScheduledWork
+    {
+        TimerCompleteFunct mComplete;
+        void * mAppState;
+    };
+    MPSCQueue<ScheduledWork, CHIP_SYSTEM_CONFIG_WORK_QUEUE_SIZE> mScheduledWork;
+
+    void GetSleepTime(struct timeval & aSleepTime);
+    void DrainWakePipe(void);
+    void HandleTimers(void);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    int mEpollFD;
+    SocketWatch * mRefreshList;
+    struct epoll_event mEvents[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+
+    void QueueRefresh(SocketWatch & aWatch);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     static Error HandleSystemLayerEvent(Object & aTarget, EventType aEventType, uintptr_t aArgument);
 
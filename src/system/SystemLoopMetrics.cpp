@@ -0,0 +1,366 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file implements the CHIP API to measure where the event loop spends its time.
+ *
+ *  All recording is expected to happen on the thread running the one event loop of the process, so none of it is
+ *  synchronized. The query functions must therefore be called on that thread too, or with the stack lock held, for their
+ *  results to be consistent.
+ */
+
+// Include common private header
+#include "SystemLayerPrivate.h"
+
+// Include module header
+#include <system/SystemLoopMetrics.h>
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace chip {
+namespace System {
+namespace LoopMetrics {
+
+namespace {
+
+const size_t kNumSources = CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES;
+const size_t kIndexSize  = 2 * kNumSources; ///< keeps the open-addressed index at most half full
+
+Source sSources[kNumSources];
+size_t sNumSources;
+uint16_t sIndex[kIndexSize]; ///< 1 + the position in sSources of the source hashing to the slot, or 0 if the slot is free
+Source sOverflow = { kSource_Overflow, 0, { 0, 0, 0, { 0 } } };
+
+Histogram sWaitTime;
+Histogram sBusyTime;
+Histogram sTimerLag;
+uint64_t sWaitStartUS;
+uint64_t sWakeUS; ///< when the loop last stopped waiting, or 0 before it first waited
+
+size_t IndexSlot(SourceKind aKind, uintptr_t aKey)
+{
+    uint64_t lHash = (static_cast<uint64_t>(aKey) ^ aKind) * 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<size_t>(lHash >> 32) % kIndexSize;
+}
+
+Source * LookUp(SourceKind aKind, uintptr_t aKey, bool aCreate)
+{
+    size_t lSlot = IndexSlot(aKind, aKey);
+
+    while (sIndex[lSlot] != 0)
+    {
+        Source & lSource = sSources[sIndex[lSlot] - 1];
+
+        if (lSource.mKind == aKind && lSource.mKey == aKey)
+            return &lSource;
+
+        lSlot = (lSlot + 1) % kIndexSize;
+    }
+
+    if (!aCreate)
+        return NULL;
+
+    if (sNumSources == kNumSources)
+        return &sOverflow;
+
+    Source & lSource = sSources[sNumSources++];
+
+    lSource.mKind = static_cast<uint8_t>(aKind);
+    lSource.mKey  = aKey;
+    lSource.mDurationUS.Clear();
+    sIndex[lSlot] = static_cast<uint16_t>(sNumSources);
+
+    return &lSource;
+}
+
+/**
+ *  Formats into a fixed buffer with snprintf() semantics: output beyond the buffer is dropped, but still counted.
+ */
+class JSONWriter
+{
+public:
+    JSONWriter(char * aBuffer, size_t aBufferSize) : mBuffer(aBuffer), mBufferSize(aBufferSize), mLength(0)
+    {
+        if (mBufferSize > 0)
+            mBuffer[0] = '\0';
+    }
+
+    void Append(const char * aFormat, ...) __attribute__((format(printf, 2, 3)))
+    {
+        const size_t lOffset = (mLength < mBufferSize) ? mLength : mBufferSize;
+        va_list lArgs;
+        int lResult;
+
+        va_start(lArgs, aFormat);
+        lResult = vsnprintf(mBuffer + lOffset, mBufferSize - lOffset, aFormat, lArgs);
+        va_end(lArgs);
+
+        if (lResult > 0)
+            mLength += static_cast<size_t>(lResult);
+    }
+
+    void AppendHistogram(const Histogram & aHistogram)
+    {
+        size_t lNumBuckets = Histogram::kNumBuckets;
+
+        // Trailing empty buckets are implied.
+        while (lNumBuckets > 0 && aHistogram.mBuckets[lNumBuckets - 1] == 0)
+            lNumBuckets--;
+
+        Append("{\"count\":%" PRIu32 ",\"totalUs\":%" PRIu64 ",\"maxUs\":%" PRIu32 ",\"buckets\":[", aHistogram.mCount,
+               aHistogram.mTotalUS, aHistogram.mMaxUS);
+
+        for (size_t i = 0; i < lNumBuckets; i++)
+            Append("%s%" PRIu32, (i == 0) ? "" : ",", aHistogram.mBuckets[i]);
+
+        Append("]}");
+    }
+
+    void AppendSource(const Source & aSource)
+    {
+        static const char * const kKindNames[] = { "timer", "work", "io", "event", "overflow" };
+
+        Append("{\"kind\":\"%s\",", kKindNames[aSource.mKind]);
+
+        switch (aSource.mKind)
+        {
+        case kSource_Timer:
+        case kSource_Work:
+            Append("\"key\":\"0x%" PRIxPTR "\",", aSource.mKey);
+            break;
+
+        case kSource_IO:
+            Append("\"key\":\"%s\",", reinterpret_cast<const char *>(aSource.mKey));
+            break;
+
+        case kSource_Event:
+            Append("\"key\":%" PRIuPTR ",", aSource.mKey);
+            break;
+
+        default:
+            break;
+        }
+
+        Append("\"durations\":");
+        AppendHistogram(aSource.mDurationUS);
+        Append("}");
+    }
+
+    size_t Length(void) const { return mLength; }
+
+private:
+    char * mBuffer;
+    size_t mBufferSize;
+    size_t mLength;
+};
+
+} // namespace
+
+/**
+ *  Add a duration to the histogram.
+ */
+void Histogram::Record(uint64_t aDurationUS)
+{
+    mCount++;
+    mTotalUS += aDurationUS;
+    if (aDurationUS > mMaxUS)
+        mMaxUS = (aDurationUS > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(aDurationUS);
+    mBuckets[BucketFor(aDurationUS)]++;
+}
+
+/**
+ *  Forget all recorded durations.
+ */
+void Histogram::Clear(void)
+{
+    memset(this, 0, sizeof(*this));
+}
+
+/**
+ *  Return the bucket counting @a aDurationUS, i.e. the number of significant bits of the duration, capped to the last bucket.
+ */
+size_t Histogram::BucketFor(uint64_t aDurationUS)
+{
+    size_t lBucket = 0;
+
+    while (aDurationUS != 0 && lBucket < kNumBuckets - 1)
+    {
+        aDurationUS >>= 1;
+        lBucket++;
+    }
+
+    return lBucket;
+}
+
+/**
+ *  Record that the source @a aKey of kind @a aKind ran for @a aDurationUS microseconds.
+ *
+ *  Sources are added to the table the first time they are seen; once it is full, new sources are recorded in the overflow
+ *  source, whose size hints at raising CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES.
+ */
+void Record(SourceKind aKind, uintptr_t aKey, uint64_t aDurationUS)
+{
+    LookUp(aKind, aKey, true)->mDurationUS.Record(aDurationUS);
+}
+
+/**
+ *  Record that a timer fired @a aLagUS microseconds after it expired.
+ */
+void RecordTimerLag(uint64_t aLagUS)
+{
+    sTimerLag.Record(aLagUS);
+}
+
+/**
+ *  Note that the event loop is about to wait for I/O or timers. The time since it last stopped waiting is recorded as busy.
+ */
+void WaitBegin(void)
+{
+    sWaitStartUS = Platform::Layer::GetClock_MonotonicHiRes();
+
+    if (sWakeUS != 0)
+        sBusyTime.Record(sWaitStartUS - sWakeUS);
+}
+
+/**
+ *  Note that the event loop stopped waiting. The time since the matching WaitBegin() is recorded as waiting.
+ */
+void WaitEnd(void)
+{
+    sWakeUS = Platform::Layer::GetClock_MonotonicHiRes();
+    sWaitTime.Record(sWakeUS - sWaitStartUS);
+}
+
+/**
+ *  Return the sources recorded so far, in the order they were first seen.
+ *
+ *  @param[out] aNumSources     The number of sources returned.
+ */
+const Source * GetSources(size_t & aNumSources)
+{
+    aNumSources = sNumSources;
+    return sSources;
+}
+
+/**
+ *  Return the durations recorded for a source, or NULL if none were recorded for it.
+ */
+const Source * FindSource(SourceKind aKind, uintptr_t aKey)
+{
+    if (aKind == kSource_Overflow)
+        return &sOverflow;
+
+    return LookUp(aKind, aKey, false);
+}
+
+/**
+ *  Return how long the event loop waited each time for I/O or timers.
+ */
+const Histogram & GetWaitTime(void)
+{
+    return sWaitTime;
+}
+
+/**
+ *  Return how long the event loop was busy between two waits.
+ */
+const Histogram & GetBusyTime(void)
+{
+    return sBusyTime;
+}
+
+/**
+ *  Return how long after their expiration timers fired.
+ */
+const Histogram & GetTimerLag(void)
+{
+    return sTimerLag;
+}
+
+/**
+ *  Forget all sources and recorded durations.
+ */
+void Reset(void)
+{
+    sNumSources = 0;
+    memset(sIndex, 0, sizeof(sIndex));
+
+    sOverflow.mKind = kSource_Overflow;
+    sOverflow.mKey  = 0;
+    sOverflow.mDurationUS.Clear();
+
+    sWaitTime.Clear();
+    sBusyTime.Clear();
+    sTimerLag.Clear();
+    sWakeUS = 0;
+}
+
+/**
+ *  Write all metrics as a JSON object into a buffer.
+ *
+ *  The object has the members "waitTime", "busyTime" and "timerLag", each a histogram, and "sources", an array of objects
+ *  with the members "kind", "key" and "durations". A histogram is an object with the members "count", "totalUs", "maxUs"
+ *  and "buckets", the array of the counts of Histogram::mBuckets without its trailing zeros.
+ *
+ *  @param[out] aBuffer         The buffer to write to. The output is always NUL-terminated, unless @a aBufferSize is zero.
+ *  @param[in]  aBufferSize     The size of @a aBuffer.
+ *
+ *  @return The length of the complete JSON text. If it is not below @a aBufferSize, the output was truncated.
+ */
+size_t WriteJSON(char * aBuffer, size_t aBufferSize)
+{
+    JSONWriter lWriter(aBuffer, aBufferSize);
+
+    lWriter.Append("{\"waitTime\":");
+    lWriter.AppendHistogram(sWaitTime);
+    lWriter.Append(",\"busyTime\":");
+    lWriter.AppendHistogram(sBusyTime);
+    lWriter.Append(",\"timerLag\":");
+    lWriter.AppendHistogram(sTimerLag);
+    lWriter.Append(",\"sources\":[");
+
+    for (size_t i = 0; i < sNumSources; i++)
+    {
+        if (i > 0)
+            lWriter.Append(",");
+        lWriter.AppendSource(sSources[i]);
+    }
+
+    if (sOverflow.mDurationUS.mCount > 0)
+    {
+        if (sNumSources > 0)
+            lWriter.Append(",");
+        lWriter.AppendSource(sOverflow);
+    }
+
+    lWriter.Append("]}");
+
+    return lWriter.Length();
+}
+
+} // namespace LoopMetrics
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
@@ -0,0 +1,155 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file declares the CHIP API to measure where the event loop spends its time: how long it waits for I/O, how long it
+ *  is busy, how late timers fire, and how long each callback it dispatches runs.
+ *
+ *  The metrics are process-wide and unsynchronized, so they are only valid in a process running a single event loop. With
+ *  several System::Layer objects serviced by different threads, the threads would record into the same tables concurrently
+ *  and the wait and busy times of one loop would be attributed to the other.
+ */
+
+#ifndef SYSTEMLOOPMETRICS_H
+#define SYSTEMLOOPMETRICS_H
+
+// Include configuration headers
+#include <system/SystemConfig.h>
+
+// Include dependent headers
+#include <support/DLLUtil.h>
+#include <system/SystemClock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
+
+namespace chip {
+namespace System {
+namespace LoopMetrics {
+
+/**
+ *  The kinds of code the event loop dispatches to, each of which identifies its sources with a different key.
+ */
+enum SourceKind
+{
+    kSource_Timer    = 0, /**< Timer callback; keyed by the callback function. */
+    kSource_Work     = 1, /**< Scheduled work or device layer work function; keyed by the function. */
+    kSource_IO       = 2, /**< Endpoint I/O handler; keyed by a static label naming the endpoint type. */
+    kSource_Event    = 3, /**< Device event handlers; keyed by the event type. */
+    kSource_Overflow = 4, /**< Any source that did not fit into the table of sources. */
+};
+
+/**
+ *  A histogram of durations, with logarithmic buckets.
+ *
+ *  Bucket 0 counts durations below one microsecond, and bucket @a i > 0 counts durations of at least 2^(i-1) and below 2^i
+ *  microseconds. The last bucket also counts all longer durations.
+ */
+class DLL_EXPORT Histogram
+{
+public:
+    enum
+    {
+        kNumBuckets = 24
+    };
+
+    uint32_t mCount;                ///< number of recorded durations
+    uint32_t mMaxUS;                ///< longest recorded duration, in microseconds
+    uint64_t mTotalUS;              ///< sum of the recorded durations, in microseconds
+    uint32_t mBuckets[kNumBuckets]; ///< number of recorded durations per bucket
+
+    void Record(uint64_t aDurationUS);
+    void Clear(void);
+
+    static size_t BucketFor(uint64_t aDurationUS);
+};
+
+/**
+ *  The durations recorded for one source.
+ */
+struct Source
+{
+    uint8_t mKind;         ///< a SourceKind
+    uintptr_t mKey;        ///< identifies the source among those of its kind
+    Histogram mDurationUS; ///< how long the source ran each time it was dispatched
+};
+
+void Record(SourceKind aKind, uintptr_t aKey, uint64_t aDurationUS);
+void RecordTimerLag(uint64_t aLagUS);
+void WaitBegin(void);
+void WaitEnd(void);
+
+const Source * GetSources(size_t & aNumSources);
+const Source * FindSource(SourceKind aKind, uintptr_t aKey);
+const Histogram & GetWaitTime(void);
+const Histogram & GetBusyTime(void);
+const Histogram & GetTimerLag(void);
+void Reset(void);
+
+size_t WriteJSON(char * aBuffer, size_t aBufferSize);
+
+/**
+ *  Records the time from its construction to its destruction as one dispatch of a source.
+ */
+class Scope
+{
+public:
+    Scope(SourceKind aKind, uintptr_t aKey) : mKind(aKind), mKey(aKey), mStartUS(Platform::Layer::GetClock_MonotonicHiRes()) {}
+    ~Scope(void) { Record(mKind, mKey, Platform::Layer::GetClock_MonotonicHiRes() - mStartUS); }
+
+private:
+    SourceKind mKind;
+    uintptr_t mKey;
+    uint64_t mStartUS;
+
+    Scope(const Scope &);
+    Scope & operator=(const Scope &);
+};
+
+} // namespace LoopMetrics
+} // namespace System
+} // namespace chip
+
+/**
+ *  Measure the rest of the enclosing block as one dispatch of the source @a key of kind @a kind, e.g. kSource_Timer.
+ *  At most one use per block.
+ */
+#define SYSTEM_LOOP_METRICS_SCOPE(kind, key)                                                                                       \
+    chip::System::LoopMetrics::Scope lLoopMetricsScope(chip::System::LoopMetrics::kind, (uintptr_t)(key))
+
+#define SYSTEM_LOOP_METRICS_TIMER_LAG(lagUS) chip::System::LoopMetrics::RecordTimerLag(lagUS)
+
+#define SYSTEM_LOOP_METRICS_WAIT_BEGIN() chip::System::LoopMetrics::WaitBegin()
+
+#define SYSTEM_LOOP_METRICS_WAIT_END() chip::System::LoopMetrics::WaitEnd()
+
+#else // CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
+
+#define SYSTEM_LOOP_METRICS_SCOPE(kind, key)
+
+#define SYSTEM_LOOP_METRICS_TIMER_LAG(lagUS)
+
+#define SYSTEM_LOOP_METRICS_WAIT_BEGIN()
+
+#define SYSTEM_LOOP_METRICS_WAIT_END()
+
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS
+
+#endif // defined(SYSTEMLOOPMETRICS_H)
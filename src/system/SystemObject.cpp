@@ -51,8 +51,13 @@ DLL_EXPORT void Object::Release(void)
 
     if (oldCount == 1)
     {
+        ObjectPoolBase * lPool = this->mPool;
+
         this->mSystemLayer = NULL;
         __sync_synchronize();
+
+        if (lPool != NULL)
+            lPool->Recycle(*this);
     }
     else if (oldCount == 0)
     {
@@ -77,6 +82,25 @@ DLL_EXPORT bool Object::TryCreate(Layer & aLayer, size_t aOctets)
     return lReturn;
 }
 
+/**
+ *  @brief
+ *      Pushes a dead object onto the free list of the pool, from which it is reused before any never used object.
+ */
+void ObjectPoolBase::Recycle(Object & aObject)
+{
+    uint32_t lHead;
+
+    do
+    {
+        lHead             = this->mFreeHead;
+        aObject.mNextFree = static_cast<uint16_t>(lHead & kIndexMask);
+    } while (!__sync_bool_compare_and_swap(&this->mFreeHead, lHead, NextFreeHead(lHead, aObject.mPoolIndex + 1U)));
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    __sync_fetch_and_sub(&this->mNumInUse, 1);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 void Object::DeferredRelease(Object::ReleaseDeferralErrorTactic aTactic)
 {
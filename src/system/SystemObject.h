@@ -22,6 +22,7 @@
  *      templates:
  *
  *        - class chip::System::Object
+ *        - class chip::System::ObjectPoolBase
  *        - template<typename ALIGN, size_t SIZE> union chip::System::ObjectArena
  *        - template<class T, unsigned int N> class chip::System::ObjectPool
  */
@@ -35,6 +36,7 @@
 // Include dependent headers
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <support/DLLUtil.h>
@@ -51,6 +53,7 @@ namespace System {
 
 // Forward class and class template declarations
 class Layer;
+class ObjectPoolBase;
 template <class T, unsigned int N>
 class ObjectPool;
 
@@ -72,6 +75,7 @@ class ObjectPool;
  */
 class DLL_EXPORT Object
 {
+    friend class ObjectPoolBase;
     template <class T, unsigned int N>
     friend class ObjectPool;
 
@@ -104,6 +108,9 @@ private:
 
     Layer * volatile mSystemLayer; /**< Pointer to the layer object that owns this object. */
     unsigned int mRefCount;        /**< Count of remaining calls to Release before object is dead. */
+    ObjectPoolBase * mPool;        /**< Pool the object is recycled into when it is dead. */
+    uint16_t mPoolIndex;           /**< Index of the object in its pool. */
+    uint16_t mNextFree;            /**< While recycled, one more than the index of the next recycled object, or zero. */
 
     /** If not already retained, attempt initial retention of this object for \c aLayer and zero up to \c aOctets. */
     bool TryCreate(Layer & aLayer, size_t aOctets);
@@ -151,6 +158,51 @@ inline Object::Object(void) {}
 /** Deleted. */
 inline Object::~Object(void) {}
 
+/**
+ *  @brief
+ *      The allocation state of an ObjectPool<T, N> that does not depend on \c T or \c N.
+ *
+ *  @note
+ *      Objects are handed out in index order until every object of the pool was used once. After that, dead objects are taken
+ *      from a lock-free LIFO list that Object::Release() pushes onto, so that allocation does not scan the pool. The head of
+ *      the list packs the index of the first object with a tag that changes on every update, to detect concurrent pops and
+ *      pushes of the same object. An all-zero state is an empty pool, so pools need no constructor.
+ */
+class DLL_EXPORT ObjectPoolBase
+{
+    friend class Object;
+    template <class T, unsigned int N>
+    friend class ObjectPool;
+
+    enum
+    {
+        kIndexBits = 16,
+        kIndexMask = (1U << kIndexBits) - 1,
+        kMaxSize   = kIndexMask,
+    };
+
+    volatile uint32_t mFreeHead;   /**< Tag in the upper half, one more than the first recycled index in the lower half. */
+    volatile unsigned int mNumNew; /**< Number of objects, from index zero, handed out at least once. */
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    volatile unsigned int mNumInUse;
+    volatile unsigned int mHighWatermark;
+#endif
+
+    static uint32_t NextFreeHead(uint32_t aHead, unsigned int aNextFree);
+
+    void Recycle(Object & aObject);
+};
+
+/**
+ *  @brief
+ *      Returns the free list head replacing \c aHead, with the tag advanced and \c aNextFree as the first recycled object.
+ */
+inline uint32_t ObjectPoolBase::NextFreeHead(uint32_t aHead, unsigned int aNextFree)
+{
+    return ((aHead & ~static_cast<uint32_t>(kIndexMask)) + (1U << kIndexBits)) | aNextFree;
+}
+
 /**
  *  @brief
  *      A union template used for representing a well-aligned block of memory.
@@ -176,6 +228,8 @@ template <class T, unsigned int N>
 class ObjectPool
 {
 public:
+    ObjectPool(void);
+
     static size_t Size(void);
 
     T * Get(const Layer & aLayer, size_t aIndex);
@@ -186,14 +240,25 @@ private:
     friend class TestObject;
 
     ObjectArena<void *, N * sizeof(T)> mArena;
+    ObjectPoolBase mBase;
+
+    T * At(unsigned int aIndex);
 
 #if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
-    void GetNumObjectsInUse(unsigned int aStartIndex, unsigned int & aNumInUse);
     void UpdateHighWatermark(const unsigned int & aCandidate);
-    volatile unsigned int mHighWatermark;
 #endif
 };
 
+/**
+ *  @brief
+ *      Constructs an empty pool, so that a pool may be a member of a layer object rather than a static object.
+ */
+template <class T, unsigned int N>
+inline ObjectPool<T, N>::ObjectPool(void)
+{
+    memset(&mBase, 0, sizeof(mBase));
+}
+
 /**
  *  @brief
  *      Returns the number of objects that can be simultaneously retained from a pool.
@@ -207,57 +272,83 @@ inline size_t ObjectPool<T, N>::Size(void)
 /**
  *  @brief
  *      Returns a pointer the object at \c aIndex or \c NULL if the object is not retained by \c aLayer.
+ *
+ *  @note
+ *      Objects never handed out by the pool are not examined, so they need not be initialized.
  */
 template <class T, unsigned int N>
 inline T * ObjectPool<T, N>::Get(const Layer & aLayer, size_t aIndex)
 {
     T * lReturn = NULL;
 
-    if (aIndex < N)
-        lReturn = &reinterpret_cast<T *>(mArena.uMemory)[aIndex];
+    if (aIndex < mBase.mNumNew)
+        lReturn = At(static_cast<unsigned int>(aIndex));
 
     (void) static_cast<Object *>(lReturn); /* In C++-11, this would be a static_assert that T inherits Object. */
 
     return (lReturn != NULL) && lReturn->IsRetained(aLayer) ? lReturn : NULL;
 }
 
+template <class T, unsigned int N>
+inline T * ObjectPool<T, N>::At(unsigned int aIndex)
+{
+    return &reinterpret_cast<T *>(mArena.uMemory)[aIndex];
+}
+
 /**
  *  @brief
- *      Tries to initially retain the first object in the pool that is not retained by any layer.
+ *      Tries to initially retain an object in the pool that is not retained by any layer.
+ *
+ *  @note
+ *      Runs in constant time: the most recently released object is reused if there is one, the next never used object otherwise.
  */
 template <class T, unsigned int N>
 inline T * ObjectPool<T, N>::TryCreate(Layer & aLayer)
 {
+    static_assert(N <= ObjectPoolBase::kMaxSize, "ObjectPool is too large to index");
+
     T * lReturn = NULL;
     unsigned int lIndex;
-#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
-    unsigned int lNumInUse = 0;
-#endif
 
-    for (lIndex = 0; lIndex < N; ++lIndex)
+    while (true)
     {
-        T & lObject = reinterpret_cast<T *>(mArena.uMemory)[lIndex];
+        const uint32_t kHead = mBase.mFreeHead;
 
-        if (lObject.TryCreate(aLayer, sizeof(T)))
+        lIndex = kHead & ObjectPoolBase::kIndexMask;
+        if (lIndex == 0)
+            break;
+        lIndex--;
+
+        // The tag makes the exchange fail if the object was taken, and possibly recycled again, since the head was read.
+        if (__sync_bool_compare_and_swap(&mBase.mFreeHead, kHead, ObjectPoolBase::NextFreeHead(kHead, At(lIndex)->mNextFree)))
         {
-            lReturn = &lObject;
+            lReturn = At(lIndex);
             break;
         }
     }
 
-#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
-    if (lReturn != NULL)
+    while (lReturn == NULL && (lIndex = mBase.mNumNew) < N)
     {
-        lIndex++;
-        lNumInUse = lIndex;
-        GetNumObjectsInUse(lIndex, lNumInUse);
+        if (__sync_bool_compare_and_swap(&mBase.mNumNew, lIndex, lIndex + 1))
+            lReturn = At(lIndex);
     }
-    else
+
+    if (lReturn != NULL)
     {
-        lNumInUse = N;
+        if (lReturn->TryCreate(aLayer, sizeof(T)))
+        {
+            lReturn->mPool      = &mBase;
+            lReturn->mPoolIndex = static_cast<uint16_t>(lIndex);
+        }
+        else
+        {
+            lReturn = NULL;
+        }
     }
 
-    UpdateHighWatermark(lNumInUse);
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    if (lReturn != NULL)
+        UpdateHighWatermark(__sync_add_and_fetch(&mBase.mNumInUse, 1));
 #endif
 
     return lReturn;
@@ -269,43 +360,12 @@ inline void ObjectPool<T, N>::UpdateHighWatermark(const unsigned int & aCandidat
 {
     unsigned int lTmp;
 
-    while (aCandidate > (lTmp = mHighWatermark))
+    while (aCandidate > (lTmp = mBase.mHighWatermark))
     {
         SYSTEM_OBJECT_HWM_TEST_HOOK();
-        (void) __sync_bool_compare_and_swap(&mHighWatermark, lTmp, aCandidate);
+        (void) __sync_bool_compare_and_swap(&mBase.mHighWatermark, lTmp, aCandidate);
     }
 }
-
-/**
- * Return the number of objects in use starting at a given index
- *
- * @param[in] aStartIndex      The index to start counting from; pass 0 to count over
- *                             the whole pool.
- * @param[in/out] aNumInUse    The number of objects in use. If aStartIndex is not 0,
- *                             the function adds to the counter without resetting it first.
- */
-template <class T, unsigned int N>
-inline void ObjectPool<T, N>::GetNumObjectsInUse(unsigned int aStartIndex, unsigned int & aNumInUse)
-{
-    unsigned int count = 0;
-
-    for (unsigned int lIndex = aStartIndex; lIndex < N; ++lIndex)
-    {
-        T & lObject = reinterpret_cast<T *>(mArena.uMemory)[lIndex];
-
-        if (lObject.mSystemLayer != NULL)
-        {
-            count++;
-        }
-    }
-
-    if (aStartIndex == 0)
-    {
-        aNumInUse = 0;
-    }
-
-    aNumInUse += count;
-}
 #endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
 template <class T, unsigned int N>
@@ -315,8 +375,8 @@ inline void ObjectPool<T, N>::GetStatistics(chip::System::Stats::count_t & aNumI
     unsigned int lNumInUse;
     unsigned int lHighWatermark;
 
-    GetNumObjectsInUse(0, lNumInUse);
-    lHighWatermark = mHighWatermark;
+    lNumInUse      = mBase.mNumInUse;
+    lHighWatermark = mBase.mHighWatermark;
 
     if (lNumInUse > CHIP_SYS_STATS_COUNT_MAX)
     {
@@ -52,6 +52,10 @@
 #include <lwip/pbuf.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
 namespace chip {
 namespace System {
 
@@ -61,9 +65,89 @@ namespace System {
 #if !CHIP_SYSTEM_CONFIG_USE_LWIP
 #if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE + CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY];
+} SmallBufferPoolElement;
+
+static SmallBufferPoolElement sSmallBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC];
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE + CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY];
+} MediumBufferPoolElement;
+
+static MediumBufferPoolElement sMediumBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC];
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+
 static BufferPoolElement sBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC];
 
-PacketBuffer * PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
+/**
+ *  The buffers of one capacity. Size classes are ordered by increasing capacity; the last one holds the buffers of full size.
+ */
+struct BufferSizeClass
+{
+    uint8_t * mPool;
+    size_t mElementSize;
+    size_t mNumElements;
+    uint16_t mCapacity;
+    int mStatsEntry;
+};
+
+// clang-format off
+static const BufferSizeClass sSizeClasses[] =
+{
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    { sSmallBufferPool[0].Block,  sizeof(SmallBufferPoolElement),  CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC,
+      CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY,  chip::System::Stats::kSystemLayer_NumSmallPacketBufs },
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    { sMediumBufferPool[0].Block, sizeof(MediumBufferPoolElement), CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC,
+      CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY, chip::System::Stats::kSystemLayer_NumMediumPacketBufs },
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    { sBufferPool[0].Block,       sizeof(BufferPoolElement),       CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC,
+      CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX,    chip::System::Stats::kSystemLayer_NumPacketBufs },
+};
+// clang-format on
+
+static const unsigned int kNumSizeClasses = sizeof(sSizeClasses) / sizeof(sSizeClasses[0]);
+
+// clang-format off
+PacketBuffer * PacketBuffer::sFreeList[kNumSizeClasses] =
+{
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    PacketBuffer::BuildFreeList(0),
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    PacketBuffer::BuildFreeList((CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC != 0) ? 1 : 0),
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    PacketBuffer::BuildFreeList(kNumSizeClasses - 1),
+};
+// clang-format on
+
+/**
+ *  Return the size class of a buffer allocated from the pool.
+ */
+static unsigned int SizeClassOf(const PacketBuffer * aPacket)
+{
+    const uint8_t * const kPacket = reinterpret_cast<const uint8_t *>(aPacket);
+    unsigned int lSizeClass;
+
+    for (lSizeClass = 0; lSizeClass < kNumSizeClasses - 1; lSizeClass++)
+    {
+        const BufferSizeClass & lClass = sSizeClasses[lSizeClass];
+
+        if (kPacket >= lClass.mPool && kPacket < lClass.mPool + lClass.mElementSize * lClass.mNumElements)
+            break;
+    }
+
+    return lSizeClass;
+}
 
 #if !CHIP_SYSTEM_CONFIG_NO_LOCKING
 static Mutex sBufferPoolMutex;
@@ -96,6 +180,217 @@ static Mutex sBufferPoolMutex;
     } while (0)
 #endif // !defined(UNLOCK_BUF_POOL)
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+/**
+ *  Free buffers held by one thread, which it allocates and frees without taking the pool lock.
+ *
+ *  An empty cache takes a batch of buffers from the pool, and a full cache returns a batch to the pool, so that the lock is
+ *  taken at most once per batch. A cache is returned to the pool when its thread exits.
+ */
+struct PacketBuffer::ThreadCache
+{
+    enum
+    {
+        kCapacity  = CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE,
+        kBatchSize = (kCapacity + 1) / 2,
+    };
+
+    PacketBuffer * mHead[kNumSizeClasses];
+    unsigned int mCount[kNumSizeClasses];
+    uint32_t mNumHits; ///< Allocations served by the cache since the last exchange with the pool.
+
+    static pthread_key_t sKey;
+    static pthread_once_t sKeyOnce;
+    static bool sKeyCreated;
+    static uint64_t sNumHits;
+    static uint64_t sNumMisses;
+
+    static void CreateKey(void);
+    static void Destroy(void * aCache);
+    static ThreadCache * Get(void);
+
+    static PacketBuffer * Allocate(unsigned int aSizeClass);
+    static void Recycle(PacketBuffer * aPacket, unsigned int aSizeClass);
+
+    void TakeFromPool(unsigned int aSizeClass, unsigned int aCount);
+    void ReturnToPool(unsigned int aSizeClass, unsigned int aCount);
+};
+
+pthread_key_t PacketBuffer::ThreadCache::sKey;
+pthread_once_t PacketBuffer::ThreadCache::sKeyOnce = PTHREAD_ONCE_INIT;
+bool PacketBuffer::ThreadCache::sKeyCreated        = false;
+uint64_t PacketBuffer::ThreadCache::sNumHits       = 0;
+uint64_t PacketBuffer::ThreadCache::sNumMisses     = 0;
+
+void PacketBuffer::ThreadCache::CreateKey(void)
+{
+    sKeyCreated = (pthread_key_create(&sKey, Destroy) == 0);
+}
+
+void PacketBuffer::ThreadCache::Destroy(void * aCache)
+{
+    ThreadCache * lCache = static_cast<ThreadCache *>(aCache);
+
+    LOCK_BUF_POOL();
+    for (unsigned int lSizeClass = 0; lSizeClass < kNumSizeClasses; lSizeClass++)
+        lCache->ReturnToPool(lSizeClass, lCache->mCount[lSizeClass]);
+    UNLOCK_BUF_POOL();
+
+    free(lCache);
+}
+
+/**
+ *  Return the cache of the calling thread, creating it if needed, or NULL if it cannot be created.
+ */
+PacketBuffer::ThreadCache * PacketBuffer::ThreadCache::Get(void)
+{
+    ThreadCache * lCache;
+
+    pthread_once(&sKeyOnce, CreateKey);
+    VerifyOrExit(sKeyCreated, lCache = NULL);
+
+    lCache = static_cast<ThreadCache *>(pthread_getspecific(sKey));
+    if (lCache == NULL)
+    {
+        lCache = static_cast<ThreadCache *>(calloc(1, sizeof(ThreadCache)));
+        VerifyOrExit(lCache != NULL, );
+
+        if (pthread_setspecific(sKey, lCache) != 0)
+        {
+            free(lCache);
+            lCache = NULL;
+        }
+    }
+
+exit:
+    return lCache;
+}
+
+/**
+ *  Move up to \c aCount buffers of a size class from the pool into the cache. The pool lock must be held.
+ */
+void PacketBuffer::ThreadCache::TakeFromPool(unsigned int aSizeClass, unsigned int aCount)
+{
+    PacketBuffer * lPacket;
+
+    sNumHits += mNumHits;
+    sNumMisses++;
+    mNumHits = 0;
+
+    while (aCount-- > 0 && (lPacket = TakeFromFreeList(aSizeClass)) != NULL)
+    {
+        lPacket->next     = mHead[aSizeClass];
+        mHead[aSizeClass] = lPacket;
+        mCount[aSizeClass]++;
+    }
+}
+
+/**
+ *  Move \c aCount buffers of a size class from the cache back into the pool. The pool lock must be held.
+ */
+void PacketBuffer::ThreadCache::ReturnToPool(unsigned int aSizeClass, unsigned int aCount)
+{
+    sNumHits += mNumHits;
+    mNumHits = 0;
+
+    while (aCount-- > 0 && mHead[aSizeClass] != NULL)
+    {
+        PacketBuffer * lPacket = mHead[aSizeClass];
+
+        mHead[aSizeClass] = static_cast<PacketBuffer *>(lPacket->next);
+        mCount[aSizeClass]--;
+
+        ReturnToFreeList(lPacket, aSizeClass);
+    }
+}
+
+/**
+ *  Allocate a buffer of a size class from the cache of the calling thread, refilling it from the pool if it is empty.
+ */
+PacketBuffer * PacketBuffer::ThreadCache::Allocate(unsigned int aSizeClass)
+{
+    ThreadCache * lCache = Get();
+    PacketBuffer * lPacket;
+
+    if (lCache == NULL)
+    {
+        LOCK_BUF_POOL();
+        lPacket = TakeFromFreeList(aSizeClass);
+        UNLOCK_BUF_POOL();
+
+        return lPacket;
+    }
+
+    if (lCache->mHead[aSizeClass] == NULL)
+    {
+        LOCK_BUF_POOL();
+        lCache->TakeFromPool(aSizeClass, kBatchSize);
+        UNLOCK_BUF_POOL();
+
+        if (lCache->mHead[aSizeClass] == NULL)
+            return NULL;
+    }
+    else
+    {
+        lCache->mNumHits++;
+    }
+
+    lPacket                   = lCache->mHead[aSizeClass];
+    lCache->mHead[aSizeClass] = static_cast<PacketBuffer *>(lPacket->next);
+    lCache->mCount[aSizeClass]--;
+
+    return lPacket;
+}
+
+/**
+ *  Put a freed buffer into the cache of the calling thread, returning a batch to the pool if the cache is full.
+ */
+void PacketBuffer::ThreadCache::Recycle(PacketBuffer * aPacket, unsigned int aSizeClass)
+{
+    ThreadCache * lCache = Get();
+
+    if (lCache == NULL)
+    {
+        LOCK_BUF_POOL();
+        ReturnToFreeList(aPacket, aSizeClass);
+        UNLOCK_BUF_POOL();
+
+        return;
+    }
+
+    aPacket->next             = lCache->mHead[aSizeClass];
+    lCache->mHead[aSizeClass] = aPacket;
+    lCache->mCount[aSizeClass]++;
+
+    if (lCache->mCount[aSizeClass] > kCapacity)
+    {
+        LOCK_BUF_POOL();
+        lCache->ReturnToPool(aSizeClass, kBatchSize);
+        UNLOCK_BUF_POOL();
+    }
+}
+
+/**
+ * Return the number of allocations served by, and the number of refills of, the per-thread caches of free buffers.
+ *
+ *  Allocations served by a cache are accounted for when the cache next exchanges buffers with the pool, so the number of hits
+ *  lags behind. A high proportion of misses suggests that the pool, #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC, is too small
+ *  for the caches to stay filled.
+ *
+ *  @param[out] aNumHits    Number of allocations served without taking the pool lock.
+ *  @param[out] aNumMisses  Number of times an empty cache had to take buffers from the pool.
+ */
+void PacketBuffer::GetThreadCacheStatistics(uint64_t & aNumHits, uint64_t & aNumMisses)
+{
+    LOCK_BUF_POOL();
+    aNumHits   = ThreadCache::sNumHits;
+    aNumMisses = ThreadCache::sNumMisses;
+    UNLOCK_BUF_POOL();
+}
+
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 
 /**
@@ -108,6 +403,22 @@ uint8_t * PacketBuffer::Start() const
     return static_cast<uint8_t *>(this->payload);
 }
 
+/**
+ *  Get pointer to the start of the memory holding the data of the buffer, right after the header of the buffer that holds it.
+ *
+ *  This is the header of the buffer itself, unless the buffer is a clone.
+ */
+uint8_t * PacketBuffer::BlockStart() const
+{
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    const pbuf * const lBlock = this;
+#else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
+    const pbuf * const lBlock = (this->owner != NULL) ? this->owner : this;
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+
+    return const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(lBlock)) + CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE;
+}
+
 /**
  *  Set the start data in buffer, adjusting length and total length accordingly.
  *
@@ -116,19 +427,34 @@ uint8_t * PacketBuffer::Start() const
  *
  *  @note This call should not be used on any buffer that is not the head of a buffer chain, as it only alters the current buffer.
  *
+ *  @note Moving the start backwards to prepend a header to a shared buffer first gives the buffer a private copy of its data,
+ *  see `EnsureUnshared()`. The process is aborted if the copy cannot be allocated, so callers that can handle running out of
+ *  buffers should make room for the header with `EnsureReservedSize()` first.
+ *
  *  @param[in] aNewStart - A pointer to where the new payload should start.  newStart will be adjusted internally to fall within
  *      the boundaries of the first buffer in the PacketBuffer chain.
  */
 void PacketBuffer::SetStart(uint8_t * aNewStart)
 {
-    uint8_t * const kStart = reinterpret_cast<uint8_t *>(this) + CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE;
-    uint8_t * const kEnd   = kStart + this->AllocSize();
+    uint8_t * kStart = this->BlockStart();
+    uint8_t * kEnd   = kStart + this->AllocSize();
 
     if (aNewStart < kStart)
         aNewStart = kStart;
     else if (aNewStart > kEnd)
         aNewStart = kEnd;
 
+    if (aNewStart < static_cast<uint8_t *>(this->payload) && this->IsShared())
+    {
+        const ptrdiff_t kOffset = aNewStart - kStart;
+
+        VerifyOrDieWithMsg(this->EnsureUnshared(), chipSystemLayer, "cannot unshare buffer %p", this);
+
+        // The data now lives in a private copy; move the new start along with it.
+        kStart    = this->BlockStart();
+        aNewStart = kStart + kOffset;
+    }
+
     ptrdiff_t lDelta = aNewStart - static_cast<uint8_t *>(this->payload);
     if (lDelta > this->len)
         lDelta = this->len;
@@ -197,7 +523,7 @@ uint16_t PacketBuffer::TotalLength() const
  */
 uint16_t PacketBuffer::MaxDataLength() const
 {
-    const uint8_t * const kStart = reinterpret_cast<const uint8_t *>(this) + CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE;
+    const uint8_t * const kStart = this->BlockStart();
     const ptrdiff_t kDelta       = static_cast<uint8_t *>(this->payload) - kStart;
     return static_cast<uint16_t>(this->AllocSize() - kDelta);
 }
@@ -219,8 +545,8 @@ uint16_t PacketBuffer::AvailableDataLength() const
  */
 uint16_t PacketBuffer::ReservedSize() const
 {
-    const ptrdiff_t kDelta = static_cast<uint8_t *>(this->payload) - reinterpret_cast<const uint8_t *>(this);
-    return static_cast<uint16_t>(kDelta - CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE);
+    const ptrdiff_t kDelta = static_cast<uint8_t *>(this->payload) - this->BlockStart();
+    return static_cast<uint16_t>(kDelta);
 }
 
 /**
@@ -276,10 +602,14 @@ PacketBuffer * PacketBuffer::DetachTail()
  *  reserved space.  The remaining available space is filled with data moved from subsequent buffers in the chain, until the
  *  current buffer is full.  If a subsequent buffer in the chain is moved into the current buffer in its entirety, it is removed
  *  from the chain and freed.  The method takes no parameters, returns no results and cannot fail.
+ *
+ *  @note A shared buffer is first given a private copy of its data. The process is aborted if the copy cannot be allocated.
  */
 void PacketBuffer::CompactHead()
 {
-    uint8_t * const kStart = reinterpret_cast<uint8_t *>(this) + CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE;
+    VerifyOrDieWithMsg(this->EnsureUnshared(), chipSystemLayer, "cannot unshare buffer %p", this);
+
+    uint8_t * const kStart = this->BlockStart();
 
     if (this->payload != kStart)
     {
@@ -366,14 +696,18 @@ PacketBuffer * PacketBuffer::Consume(uint16_t aConsumeLength)
  * Ensure the buffer has at least the specified amount of reserved space.
  *
  *  Ensure the buffer has at least the specified amount of reserved space moving the data in the buffer forward to make room if
- *  necessary.
+ *  necessary. As the reserved space is about to be written to, a shared buffer is given a private copy of its data.
  *
  *  @param[in] aReservedSize - number of bytes desired for the headers.
  *
- *  @return \c true if the requested reserved size is available, \c false if there's not enough room in the buffer.
+ *  @return \c true if the requested reserved size is available, \c false if there's not enough room in the buffer or the data of
+ *      a shared buffer could not be copied.
  */
 bool PacketBuffer::EnsureReservedSize(uint16_t aReservedSize)
 {
+    if (!this->EnsureUnshared())
+        return false;
+
     const uint16_t kCurrentReservedSize = this->ReservedSize();
     if (aReservedSize <= kCurrentReservedSize)
         return true;
@@ -412,6 +746,156 @@ bool PacketBuffer::AlignPayload(uint16_t aAlignBytes)
     return (this->EnsureReservedSize(this->ReservedSize() + kPayloadShift));
 }
 
+/**
+ * Check whether the data of the current buffer is shared with a clone.
+ *
+ *  The data of a shared buffer must not be written to. Writing to it through `SetStart()` or `EnsureReservedSize()` first gives
+ *  the buffer a private copy; other writers should call `EnsureUnshared()` beforehand.
+ *
+ *  @return \c true if the data of the buffer is also referred to by another buffer, \c false otherwise.
+ */
+bool PacketBuffer::IsShared() const
+{
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    return false;
+#else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
+    const pbuf * const lBlock = (this->owner != NULL) ? this->owner : this;
+
+    // The data is referred to by the clones of the buffer that holds it and, while it is still referenced other than by those
+    // clones, by that buffer itself, unless it was since given a copy of its own.
+    unsigned int lNumUsers = lBlock->clones;
+    if (lBlock->owner == NULL && lBlock->ref > lBlock->clones)
+        lNumUsers++;
+
+    return lNumUsers > 1;
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+}
+
+/**
+ * Give the current buffer a private copy of its data if the data is shared with a clone.
+ *
+ *  The copy keeps the reserved size, data length and maximum data length of the buffer. Only the current buffer is affected.
+ *
+ *  @return \c true if the data of the buffer may be written to, \c false if a copy was needed but could not be allocated.
+ */
+bool PacketBuffer::EnsureUnshared()
+{
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+    if (this->IsShared())
+    {
+        const uint16_t kReservedSize = this->ReservedSize();
+        PacketBuffer * lOwner        = static_cast<PacketBuffer *>(this->owner);
+        PacketBuffer * lCopy         = PacketBuffer::NewWithAvailableSize(kReservedSize, this->AllocSize() - kReservedSize);
+
+        if (lCopy == NULL)
+            return false;
+
+        memcpy(lCopy->payload, this->payload, this->len);
+
+        // The buffer becomes the only clone of the copy, which it holds the single reference to.
+        lCopy->clones = 1;
+        this->owner   = lCopy;
+        this->payload = lCopy->payload;
+
+        if (lOwner != NULL)
+            lOwner->ReleaseClone();
+    }
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+
+    return true;
+}
+
+/**
+ * Check whether the data of the current buffer may be written to in place.
+ *
+ *  In LwIP-based environments, a pbuf of type \c PBUF_ROM or \c PBUF_REF refers to data held elsewhere, e.g. by a network driver
+ *  receiving without copying, which may be read-only; only the data of pbufs allocated along with it may be written to. Otherwise,
+ *  the data must not be shared with a clone, see `IsShared()`.
+ *
+ *  @return \c true if the data of the buffer may be written to, \c false if it must first be copied.
+ */
+bool PacketBuffer::IsWritable() const
+{
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+#if (LWIP_VERSION_MAJOR >= 2 && LWIP_VERSION_MINOR >= 1)
+    return (this->type_internal & PBUF_TYPE_FLAG_STRUCT_DATA_CONTIGUOUS) != 0;
+#else  // !(LWIP_VERSION_MAJOR >= 2 && LWIP_VERSION_MINOR >= 1)
+    return this->type == PBUF_RAM || this->type == PBUF_POOL;
+#endif // !(LWIP_VERSION_MAJOR >= 2 && LWIP_VERSION_MINOR >= 1)
+#else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
+    return !this->IsShared();
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+}
+
+/**
+ * Clone a chain of buffers.
+ *
+ *  Each buffer of the chain is cloned into a new buffer that shares its data rather than copying it, so that the same message can
+ *  be handed to several destinations at the cost of a buffer header each. When no buffer smaller than the source is available,
+ *  as with a pool without size classes, the data is copied into the clone instead. The clone and the original have their own start,
+ *  length and chaining, and whichever of them is written to next through `SetStart()`, `EnsureReservedSize()` or
+ *  `EnsureUnshared()` first gets a private copy of the data. The data remains allocated until the original and all its clones are
+ *  freed.
+ *
+ *  In LwIP-based environments the data is copied into the clone right away.
+ *
+ *  @return the head of the cloned chain on success, \c NULL if a buffer could not be allocated.
+ */
+PacketBuffer * PacketBuffer::Clone()
+{
+    PacketBuffer * lHead = NULL;
+
+    for (PacketBuffer * lSource = this; lSource != NULL; lSource = static_cast<PacketBuffer *>(lSource->next))
+    {
+        PacketBuffer * lClone;
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+        const uint16_t kReservedSize = lSource->ReservedSize();
+
+        lClone = PacketBuffer::NewWithAvailableSize(kReservedSize, lSource->AllocSize() - kReservedSize);
+        VerifyOrExit(lClone != NULL, );
+
+        memcpy(lClone->payload, lSource->payload, lSource->len);
+#else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
+        PacketBuffer * const lOwner = static_cast<PacketBuffer *>((lSource->owner != NULL) ? lSource->owner : lSource);
+
+        // A clone only needs a header; take it from the smallest buffers available.
+        lClone = PacketBuffer::NewWithAvailableSize(0, 0);
+        VerifyOrExit(lClone != NULL, );
+
+        if (lClone->AllocSize() >= lSource->AllocSize())
+        {
+            // No smaller buffer was available, e.g. the pool has no size classes: sharing would save no memory, and copying the
+            // data now spares copying it when either buffer is written to.
+            lClone->payload = lClone->BlockStart() + lSource->ReservedSize();
+            memcpy(lClone->payload, lSource->payload, lSource->len);
+        }
+        else
+        {
+            // Count the reference before the clone, so that a racing IsShared() errs on the side of copying.
+            lOwner->AddRef();
+            __sync_fetch_and_add(&lOwner->clones, 1);
+
+            lClone->owner   = lOwner;
+            lClone->payload = lSource->payload;
+        }
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+
+        lClone->len = lClone->tot_len = lSource->len;
+
+        if (lHead == NULL)
+            lHead = lClone;
+        else
+            lHead->AddToEnd(lClone);
+    }
+
+    return lHead;
+
+exit:
+    PacketBuffer::Free(lHead);
+    return NULL;
+}
+
 /**
  * Get pointer to next buffer in chain.
  *
@@ -430,9 +914,7 @@ void PacketBuffer::AddRef()
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     pbuf_ref(this);
 #else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
-    LOCK_BUF_POOL();
-    ++this->ref;
-    UNLOCK_BUF_POOL();
+    __sync_fetch_and_add(&this->ref, 1);
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 }
 
@@ -457,6 +939,7 @@ PacketBuffer * PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
     if (lAllocSize > CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: allocation too large.");
+        SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_PacketBufAllocFailures);
         return NULL;
     }
 
@@ -471,17 +954,25 @@ PacketBuffer * PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
 
     static_cast<void>(lBlockSize);
 
-    LOCK_BUF_POOL();
-
-    lPacket = sFreeList;
-    if (lPacket != NULL)
+    // Take a buffer from the smallest size class that fits, falling back to larger ones when it is exhausted.
+    lPacket = NULL;
+    for (unsigned int lSizeClass = 0; lPacket == NULL && lSizeClass < kNumSizeClasses; lSizeClass++)
     {
-        sFreeList = static_cast<PacketBuffer *>(lPacket->next);
-        SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+        if (lAllocSize > sSizeClasses[lSizeClass].mCapacity)
+            continue;
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+        lPacket = ThreadCache::Allocate(lSizeClass);
+#else  // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+        LOCK_BUF_POOL();
+        lPacket = TakeFromFreeList(lSizeClass);
+        UNLOCK_BUF_POOL();
+#endif // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+        if (lPacket != NULL)
+            lPacket->alloc_size = sSizeClasses[lSizeClass].mCapacity;
     }
 
-    UNLOCK_BUF_POOL();
-
 #else // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
     lPacket = reinterpret_cast<PacketBuffer *>(malloc(lBlockSize));
@@ -493,16 +984,23 @@ PacketBuffer * PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
     if (lPacket == NULL)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
+        SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_PacketBufAllocFailures);
         return NULL;
     }
 
+    SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_PacketBufAllocs);
+
     lPacket->payload = reinterpret_cast<uint8_t *>(lPacket) + CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE + lReservedSize;
     lPacket->len = lPacket->tot_len = 0;
     lPacket->next                   = NULL;
     lPacket->ref                    = 1;
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
 #if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     lPacket->alloc_size = lAllocSize;
 #endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+    lPacket->owner  = NULL;
+    lPacket->clones = 0;
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 
     return lPacket;
 }
@@ -583,26 +1081,36 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
 
 #else // !CHIP_SYSTEM_CONFIG_USE_LWIP
 
-    LOCK_BUF_POOL();
-
+    // Reference counts are updated atomically; the pool lock is only taken to return a buffer to the pool.
     while (aPacket != NULL)
     {
         PacketBuffer * lNextPacket = static_cast<PacketBuffer *>(aPacket->next);
+        const uint16_t lRefCount   = __sync_fetch_and_sub(&aPacket->ref, 1);
 
-        VerifyOrDieWithMsg(aPacket->ref > 0, chipSystemLayer, "SystemPacketBuffer::Free: aPacket->ref = 0");
+        VerifyOrDieWithMsg(lRefCount > 0, chipSystemLayer, "SystemPacketBuffer::Free: aPacket->ref = 0");
 
-        aPacket->ref--;
-        if (aPacket->ref == 0)
+        if (lRefCount == 1)
         {
-            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+            PacketBuffer * lOwner = static_cast<PacketBuffer *>(aPacket->owner);
+
+            SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_PacketBufFrees);
             aPacket->Clear();
-#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-            aPacket->next = sFreeList;
-            sFreeList     = aPacket;
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+            ThreadCache::Recycle(aPacket, SizeClassOf(aPacket));
+#elif CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+            LOCK_BUF_POOL();
+            ReturnToFreeList(aPacket, SizeClassOf(aPacket));
+            UNLOCK_BUF_POOL();
 #else  // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
             free(aPacket);
 #endif // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-            aPacket       = lNextPacket;
+
+            // The data of a clone is held by another buffer, which in turn is freed with its last clone.
+            if (lOwner != NULL)
+                lOwner->ReleaseClone();
+
+            aPacket = lNextPacket;
         }
         else
         {
@@ -610,8 +1118,6 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
         }
     }
 
-    UNLOCK_BUF_POOL();
-
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 }
 
@@ -627,8 +1133,24 @@ void PacketBuffer::Clear(void)
 #if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     alloc_size = 0;
 #endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+    owner  = NULL;
+    clones = 0;
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 }
 
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+/**
+ * Drop the reference held by a clone to the buffer that holds its data.
+ */
+void PacketBuffer::ReleaseClone(void)
+{
+    // Uncount the clone before its reference, so that a racing IsShared() errs on the side of copying.
+    __sync_fetch_and_sub(&this->clones, 1);
+    PacketBuffer::Free(this);
+}
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+
 /**
  * Free the first buffer in a chain, returning a pointer to the remaining buffers.
  `*
@@ -649,7 +1171,10 @@ PacketBuffer * PacketBuffer::FreeHead(PacketBuffer * aPacket)
 
 /**
  * Copy the given buffer to a right-sized buffer if applicable.
- * This function is a no-op for sockets.
+ *
+ *  With LwIP custom pools, the chain is copied into the smallest pbufs that fit. With packet buffer size classes, a single,
+ *  unshared buffer is copied into a buffer of the smallest size class that fits its reserved space and data and has a free
+ *  buffer. Otherwise, this function is a no-op.
  *
  *  @param[in] aPacket - buffer or buffer chain.
  *
@@ -666,29 +1191,78 @@ PacketBuffer * PacketBuffer::RightSize(PacketBuffer * aPacket)
 
         ChipLogProgress(chipSystemLayer, "PacketBuffer: RightSize Copied");
     }
+#elif !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC || CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC)
+    VerifyOrExit(aPacket != NULL && aPacket->next == NULL && aPacket->ref == 1, );
+    VerifyOrExit(SizeClassOf(aPacket) > 0, );
+
+    lNewPacket = PacketBuffer::NewWithAvailableSize(aPacket->ReservedSize(), aPacket->len);
+    VerifyOrExit(lNewPacket != NULL, lNewPacket = aPacket);
+
+    if (SizeClassOf(lNewPacket) >= SizeClassOf(aPacket))
+    {
+        PacketBuffer::Free(lNewPacket);
+        ExitNow(lNewPacket = aPacket);
+    }
+
+    memcpy(lNewPacket->payload, aPacket->payload, aPacket->len);
+    lNewPacket->len = lNewPacket->tot_len = aPacket->len;
+    PacketBuffer::Free(aPacket);
+
+exit:
 #endif
     return lNewPacket;
 }
 
 #if !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
-PacketBuffer * PacketBuffer::BuildFreeList()
+PacketBuffer * PacketBuffer::BuildFreeList(unsigned int aSizeClass)
 {
-    PacketBuffer * lHead = NULL;
+    const BufferSizeClass & lClass = sSizeClasses[aSizeClass];
+    PacketBuffer * lHead           = NULL;
 
-    for (int i = 0; i < CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC; i++)
+    for (size_t i = 0; i < lClass.mNumElements; i++)
     {
-        PacketBuffer * lCursor = &sBufferPool[i].Header;
+        PacketBuffer * lCursor = reinterpret_cast<PacketBuffer *>(lClass.mPool + i * lClass.mElementSize);
         lCursor->next          = lHead;
         lCursor->ref           = 0;
+        lCursor->alloc_size    = lClass.mCapacity;
         lHead                  = lCursor;
     }
 
-    Mutex::Init(sBufferPoolMutex);
+    // The free lists are built in size class order during static initialization; initialize the lock with the first one.
+    if (aSizeClass == 0)
+        Mutex::Init(sBufferPoolMutex);
 
     return lHead;
 }
 
+/**
+ *  Take a buffer from the free list of a size class. The pool lock must be held.
+ */
+PacketBuffer * PacketBuffer::TakeFromFreeList(unsigned int aSizeClass)
+{
+    PacketBuffer * lPacket = sFreeList[aSizeClass];
+
+    if (lPacket != NULL)
+    {
+        sFreeList[aSizeClass] = static_cast<PacketBuffer *>(lPacket->next);
+        SYSTEM_STATS_INCREMENT(sSizeClasses[aSizeClass].mStatsEntry);
+    }
+
+    return lPacket;
+}
+
+/**
+ *  Put a buffer back on the free list of its size class. The pool lock must be held.
+ */
+void PacketBuffer::ReturnToFreeList(PacketBuffer * aPacket, unsigned int aSizeClass)
+{
+    SYSTEM_STATS_DECREMENT(sSizeClasses[aSizeClass].mStatsEntry);
+
+    aPacket->next         = sFreeList[aSizeClass];
+    sFreeList[aSizeClass] = aPacket;
+}
+
 #endif //  !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
 } // namespace System
@@ -35,6 +35,7 @@
 #include <system/SystemError.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/mem.h>
@@ -53,9 +54,9 @@ struct pbuf
     uint16_t tot_len;
     uint16_t len;
     uint16_t ref;
-#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     uint16_t alloc_size;
-#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+    struct pbuf * owner; ///< Buffer whose memory holds the data of a clone, or NULL if the data is held in this buffer.
+    uint16_t clones;     ///< Number of clones referring to the data held in this buffer.
 };
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 
@@ -83,6 +84,11 @@ struct pbuf
  *      simple case, the size of the data buffer is #CHIP_SYSTEM_PACKETBUFFER_SIZE. A composer is provided that permits usage of
  *      data buffers of other sizes.
  *
+ *      A buffer may be cloned to send the same data to several destinations without copying it. Unless buffers smaller than
+ *      the original are unavailable, a clone shares the data of the original buffer, and either of them is given a private
+ *      copy of the data when it is written to through `SetStart()`, `EnsureReservedSize()` or `EnsureUnshared()`. For
+ *      details, see `PacketBuffer::Clone()`.
+ *
  *      PacketBuffer objects may be chained to accomodate larger payloads.  Chaining, however, is not transparent, and users of the
  *      class must explicitly decide to support chaining.  Examples of classes written with chaining support are as follows:
  *
@@ -118,6 +124,11 @@ public:
     bool EnsureReservedSize(uint16_t aReservedSize);
     bool AlignPayload(uint16_t aAlignBytes);
 
+    bool IsShared(void) const;
+    bool EnsureUnshared(void);
+    bool IsWritable(void) const;
+    PacketBuffer * Clone(void);
+
     void AddRef(void);
 
     static PacketBuffer * NewWithAvailableSize(size_t aAvailableSize);
@@ -131,14 +142,28 @@ public:
     static void Free(PacketBuffer * aPacket);
     static PacketBuffer * FreeHead(PacketBuffer * aPacket);
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    static void GetThreadCacheStatistics(uint64_t & aNumHits, uint64_t & aNumMisses);
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
 private:
 #if !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-    static PacketBuffer * sFreeList;
+    static PacketBuffer * sFreeList[];
 
-    static PacketBuffer * BuildFreeList(void);
+    static PacketBuffer * BuildFreeList(unsigned int aSizeClass);
+    static PacketBuffer * TakeFromFreeList(unsigned int aSizeClass);
+    static void ReturnToFreeList(PacketBuffer * aPacket, unsigned int aSizeClass);
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    struct ThreadCache;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+    uint8_t * BlockStart(void) const;
     void Clear(void);
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+    void ReleaseClone(void);
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 };
 
 } // namespace System
@@ -220,12 +245,9 @@ inline size_t PacketBuffer::AllocSize(void) const
     return LWIP_MEM_ALIGN_SIZE(PBUF_POOL_BUFSIZE) - CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE;
 #endif // !LWIP_PBUF_FROM_CUSTOM_POOLS
 #else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
-#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
-    return static_cast<size_t>(this->alloc_size);
-#else  // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
-    extern BufferPoolElement gDummyBufferPoolElement;
-    return sizeof(gDummyBufferPoolElement.Block) - CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE;
-#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
+    // The data of a clone is held in the buffer that owns it.
+    const pbuf * const lBlock = (this->owner != NULL) ? this->owner : this;
+    return static_cast<size_t>(lBlock->alloc_size);
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 }
 
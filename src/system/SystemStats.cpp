@@ -25,9 +25,6 @@
 // Include common private header
 #include "SystemLayerPrivate.h"
 
-// Include local headers
-#include <system/SystemTimer.h>
-
 // Include module header
 #include <system/SystemStats.h>
 
@@ -44,6 +41,12 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "SystemLayer_NumPacketBufs",
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    "SystemLayer_NumSmallPacketBufs",
+#endif
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    "SystemLayer_NumMediumPacketBufs",
+#endif
 #endif
     "SystemLayer_NumTimersInUse",
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -69,14 +72,57 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 
 };
 
+static const Label sCounterStrings[chip::System::Stats::kNumCounters] = {
+    "SystemLayer_PacketBufAllocs",
+    "SystemLayer_PacketBufAllocFailures",
+    "SystemLayer_PacketBufFrees",
+    "SystemLayer_TimerStarts",
+    "SystemLayer_TimerFires",
+#if INET_CONFIG_NUM_RAW_ENDPOINTS
+    "InetLayer_RawPacketsSent",
+    "InetLayer_RawBytesSent",
+    "InetLayer_RawPacketsReceived",
+    "InetLayer_RawBytesReceived",
+#endif
+#if INET_CONFIG_NUM_TCP_ENDPOINTS
+    "InetLayer_TCPPacketsSent",
+    "InetLayer_TCPBytesSent",
+    "InetLayer_TCPPacketsReceived",
+    "InetLayer_TCPBytesReceived",
+#endif
+#if INET_CONFIG_NUM_UDP_ENDPOINTS
+    "InetLayer_UDPPacketsSent",
+    "InetLayer_UDPBytesSent",
+    "InetLayer_UDPPacketsReceived",
+    "InetLayer_UDPBytesReceived",
+#endif
+#if INET_CONFIG_NUM_TUN_ENDPOINTS
+    "InetLayer_TunPacketsSent",
+    "InetLayer_TunBytesSent",
+    "InetLayer_TunPacketsReceived",
+    "InetLayer_TunBytesReceived",
+#endif
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE
+    "InetLayer_DNSCacheHits",
+    "InetLayer_DNSCacheMisses",
+    "InetLayer_DNSCacheCoalesced",
+#endif
+};
+
 count_t sResourcesInUse[kNumEntries];
 count_t sHighWatermarks[kNumEntries];
+counter_t sCounters[kNumCounters];
 
 const Label * GetStrings(void)
 {
     return sStatsStrings;
 }
 
+const Label * GetCounterStrings(void)
+{
+    return sCounterStrings;
+}
+
 count_t * GetResourcesInUse(void)
 {
     return sResourcesInUse;
@@ -87,17 +133,37 @@ count_t * GetHighWatermarks(void)
     return sHighWatermarks;
 }
 
+counter_t * GetCounters(void)
+{
+    return sCounters;
+}
+
+/**
+ *  Copy the global statistics into a snapshot.
+ *
+ *  Timers and endpoints are allocated from pools owned by each layer; their counts are filled in by
+ *  System::Layer::UpdateSnapshot() and Inet::InetLayer::UpdateSnapshot().
+ */
 void UpdateSnapshot(Snapshot & aSnapshot)
 {
     memcpy(&aSnapshot.mResourcesInUse, &sResourcesInUse, sizeof(aSnapshot.mResourcesInUse));
     memcpy(&aSnapshot.mHighWatermarks, &sHighWatermarks, sizeof(aSnapshot.mHighWatermarks));
 
-    chip::System::Timer::GetStatistics(aSnapshot.mResourcesInUse[kSystemLayer_NumTimers],
-                                       aSnapshot.mHighWatermarks[kSystemLayer_NumTimers]);
+    // The counters may be updated concurrently; read each one atomically.
+    for (int i = 0; i < kNumCounters; i++)
+        aSnapshot.mCounters[i] = __sync_fetch_and_add(&sCounters[i], 0);
 
     SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS();
 }
 
+/**
+ *  Compute the change of every statistic between two snapshots.
+ *
+ *  For the counters, the result is the throughput over the interval between the snapshots; it is correct across a wrap
+ *  around of a counter, as long as the counter did not wrap twice.
+ *
+ *  @return true if more resources are in use in @a after than in @a before, i.e. if a leak is likely.
+ */
 bool Difference(Snapshot & result, Snapshot & after, Snapshot & before)
 {
     int i;
@@ -114,6 +180,11 @@ bool Difference(Snapshot & result, Snapshot & after, Snapshot & before)
         }
     }
 
+    for (i = 0; i < kNumCounters; i++)
+    {
+        result.mCounters[i] = after.mCounters[i] - before.mCounters[i];
+    }
+
     return leak;
 }
 
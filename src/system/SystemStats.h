@@ -31,6 +31,7 @@
 
 // Include configuration headers
 #include <core/CHIPConfig.h>
+#include <inet/InetConfig.h>
 
 // Include dependent headers
 #include <support/DLLUtil.h>
@@ -41,6 +42,7 @@
 #include <lwip/pbuf.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#include <inttypes.h>
 #include <stdint.h>
 
 namespace chip {
@@ -55,6 +57,12 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    kSystemLayer_NumSmallPacketBufs,
+#endif
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    kSystemLayer_NumMediumPacketBufs,
+#endif
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -83,9 +91,88 @@ enum
     kNumEntries
 };
 
+/**
+ *  Monotonic throughput counters, in contrast to the entries above, which count resources currently in use.
+ *
+ *  Each endpoint type has four consecutive counters, in the order of the TrafficCounter offsets. For TCP, a packet is a
+ *  chunk of the stream handed to or received from the network stack in one call.
+ */
+enum Counter
+{
+    kSystemLayer_PacketBufAllocs,
+    kSystemLayer_PacketBufAllocFailures,
+    kSystemLayer_PacketBufFrees,
+    kSystemLayer_TimerStarts,
+    kSystemLayer_TimerFires,
+#if INET_CONFIG_NUM_RAW_ENDPOINTS
+    kInetLayer_RawPacketsSent,
+    kInetLayer_RawBytesSent,
+    kInetLayer_RawPacketsReceived,
+    kInetLayer_RawBytesReceived,
+#endif
+#if INET_CONFIG_NUM_TCP_ENDPOINTS
+    kInetLayer_TCPPacketsSent,
+    kInetLayer_TCPBytesSent,
+    kInetLayer_TCPPacketsReceived,
+    kInetLayer_TCPBytesReceived,
+#endif
+#if INET_CONFIG_NUM_UDP_ENDPOINTS
+    kInetLayer_UDPPacketsSent,
+    kInetLayer_UDPBytesSent,
+    kInetLayer_UDPPacketsReceived,
+    kInetLayer_UDPBytesReceived,
+#endif
+#if INET_CONFIG_NUM_TUN_ENDPOINTS
+    kInetLayer_TunPacketsSent,
+    kInetLayer_TunBytesSent,
+    kInetLayer_TunPacketsReceived,
+    kInetLayer_TunBytesReceived,
+#endif
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_DNS_CACHE_SIZE
+    kInetLayer_DNSCacheHits,
+    kInetLayer_DNSCacheMisses,
+    kInetLayer_DNSCacheCoalesced,
+#endif
+
+    kNumCounters
+};
+
+/**
+ *  Offsets of the traffic counters of an endpoint type from its first counter, e.g. kInetLayer_UDPPacketsSent.
+ */
+enum TrafficCounter
+{
+    kTraffic_PacketsSent     = 0,
+    kTraffic_BytesSent       = 1,
+    kTraffic_PacketsReceived = 2,
+    kTraffic_BytesReceived   = 3,
+};
+
+#if CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS == 8
 typedef int8_t count_t;
 #define PRI_CHIP_SYS_STATS_COUNT PRId8
 #define CHIP_SYS_STATS_COUNT_MAX INT8_MAX
+#elif CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS == 16
+typedef int16_t count_t;
+#define PRI_CHIP_SYS_STATS_COUNT PRId16
+#define CHIP_SYS_STATS_COUNT_MAX INT16_MAX
+#elif CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS == 32
+typedef int32_t count_t;
+#define PRI_CHIP_SYS_STATS_COUNT PRId32
+#define CHIP_SYS_STATS_COUNT_MAX INT32_MAX
+#else
+#error "CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS must be 8, 16 or 32"
+#endif
+
+#if CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS == 32
+typedef uint32_t counter_t;
+#define PRI_CHIP_SYS_STATS_COUNTER PRIu32
+#elif CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS == 64
+typedef uint64_t counter_t;
+#define PRI_CHIP_SYS_STATS_COUNTER PRIu64
+#else
+#error "CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS must be 32 or 64"
+#endif
 
 extern count_t ResourcesInUse[kNumEntries];
 extern count_t HighWatermarks[kNumEntries];
@@ -95,12 +182,14 @@ class Snapshot
 public:
     count_t mResourcesInUse[kNumEntries];
     count_t mHighWatermarks[kNumEntries];
+    counter_t mCounters[kNumCounters];
 };
 
 bool Difference(Snapshot & result, Snapshot & after, Snapshot & before);
 void UpdateSnapshot(Snapshot & aSnapshot);
 count_t * GetResourcesInUse(void);
 count_t * GetHighWatermarks(void);
+counter_t * GetCounters(void);
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 void UpdateLwipPbufCounts(void);
@@ -108,6 +197,7 @@ void UpdateLwipPbufCounts(void);
 
 typedef const char * Label;
 const Label * GetStrings(void);
+const Label * GetCounterStrings(void);
 
 } // namespace Stats
 } // namespace System
@@ -153,6 +243,14 @@ const Label * GetStrings(void);
         chip::System::Stats::GetResourcesInUse()[entry] = 0;                                                                       \
     } while (0);
 
+#define SYSTEM_STATS_COUNT_N(counter, count)                                                                                       \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        __sync_fetch_and_add(&chip::System::Stats::GetCounters()[counter], static_cast<chip::System::Stats::counter_t>(count));    \
+    } while (0);
+
+#define SYSTEM_STATS_COUNT(counter) SYSTEM_STATS_COUNT_N(counter, 1)
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()                                                                                     \
     do                                                                                                                             \
@@ -173,6 +271,10 @@ const Label * GetStrings(void);
 
 #define SYSTEM_STATS_RESET(entry)
 
+#define SYSTEM_STATS_COUNT_N(counter, count)
+
+#define SYSTEM_STATS_COUNT(counter)
+
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
 
 #endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
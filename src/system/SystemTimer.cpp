@@ -75,8 +75,6 @@
 namespace chip {
 namespace System {
 
-ObjectPool<Timer, CHIP_SYSTEM_CONFIG_NUM_TIMERS> Timer::sPool;
-
 /**
  *  This method returns the current epoch, corrected by system sleep with the system timescale, in milliseconds.
  *
@@ -135,6 +133,9 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
         chipDie();
     }
 
+    this->Enqueue(lLayer);
+    SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_TimerStarts);
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     // add to the sorted list of timers. Earliest timer appears first.
     if (lLayer.mTimerList == NULL || this->IsEarlierEpoch(this->mAwakenEpoch, lLayer.mTimerList->mAwakenEpoch))
@@ -178,22 +179,21 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
 
 Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
 {
-    Error err      = CHIP_SYSTEM_NO_ERROR;
-    Layer & lLayer = this->SystemLayer();
+    Error err = CHIP_SYSTEM_NO_ERROR;
 
     this->AppState     = aAppState;
     this->mAwakenEpoch = Timer::GetCurrentEpoch();
+    this->mQueue       = kQueue_None;
     if (!__sync_bool_compare_and_swap(&this->OnComplete, NULL, aOnComplete))
     {
         chipDie();
     }
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
+    Layer & lLayer = this->SystemLayer();
+
     err = lLayer.PostEvent(*this, chip::System::kEvent_ScheduleWork, 0);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-    lLayer.WakeSelect();
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     return err;
 }
@@ -205,9 +205,7 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
  */
 Error Timer::Cancel()
 {
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    Layer & lLayer = this->SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+    Layer & lLayer              = this->SystemLayer();
     OnCompleteFunct lOnComplete = this->OnComplete;
 
     // Check if the timer is armed
@@ -217,38 +215,193 @@ Error Timer::Cancel()
 
     // Since this thread changed the state of OnComplete, release the timer.
     this->AppState = NULL;
+    this->Dequeue(lLayer);
+    this->Release();
+exit:
+    return CHIP_SYSTEM_NO_ERROR;
+}
 
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    if (lLayer.mTimerList)
+/**
+ *  Select the bucket of the cancellation table for a completion function and application state.
+ */
+size_t Timer::TableIndex(OnCompleteFunct aOnComplete, void * aAppState)
+{
+    uint64_t lHash = reinterpret_cast<uintptr_t>(aOnComplete) ^ (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(aAppState)) << 7);
+
+    // Fibonacci hashing spreads pointers, whose low bits are mostly constant, over the buckets.
+    lHash *= 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<size_t>((lHash >> 32) % CHIP_SYSTEM_CONFIG_NUM_TIMERS);
+}
+
+/**
+ *  Look up the armed timer started on @a aLayer with the given completion function and application state.
+ *
+ *  @return The timer, or NULL if there is none.
+ */
+Timer * Timer::Find(Layer & aLayer, OnCompleteFunct aOnComplete, void * aAppState)
+{
+    Timer * lTimer = aLayer.mTimerTable[TableIndex(aOnComplete, aAppState)];
+
+    while (lTimer != NULL && !(lTimer->OnComplete == aOnComplete && lTimer->AppState == aAppState))
+        lTimer = lTimer->mNextInBucket;
+
+    return lTimer;
+}
+
+/**
+ *  Link a timer armed by Start() into the cancellation table and, on sockets, the expiration heap of @a aLayer.
+ */
+void Timer::Enqueue(Layer & aLayer)
+{
+    this->mQueue                          = kQueue_Timers;
+    this->mTableIndex                     = TableIndex(this->OnComplete, this->AppState);
+    this->mNextInBucket                   = aLayer.mTimerTable[this->mTableIndex];
+    aLayer.mTimerTable[this->mTableIndex] = this;
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    this->mSequence = aLayer.mTimerSequence++;
+    HeapPush(aLayer, *this);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+}
+
+/**
+ *  Unlink a disarmed timer from whatever queue of @a aLayer it is linked into.
+ */
+void Timer::Dequeue(Layer & aLayer)
+{
+    if (this->mQueue == kQueue_Timers)
     {
-        if (this == lLayer.mTimerList)
-        {
-            lLayer.mTimerList = this->mNextTimer;
-        }
-        else
-        {
-            Timer * lTimer = lLayer.mTimerList;
+        Timer ** lLink = &aLayer.mTimerTable[this->mTableIndex];
+
+        while (*lLink != this)
+            lLink = &(*lLink)->mNextInBucket;
+
+        *lLink              = this->mNextInBucket;
+        this->mNextInBucket = NULL;
 
-            while (lTimer->mNextTimer)
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+        if (this->mHeapIndex != kNotInHeap)
+            HeapRemove(aLayer, *this);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+        if (aLayer.mTimerList)
+        {
+            if (this == aLayer.mTimerList)
             {
-                if (this == lTimer->mNextTimer)
+                aLayer.mTimerList = this->mNextTimer;
+            }
+            else
+            {
+                Timer * lTimer = aLayer.mTimerList;
+
+                while (lTimer->mNextTimer)
                 {
-                    lTimer->mNextTimer = this->mNextTimer;
-                    break;
-                }
+                    if (this == lTimer->mNextTimer)
+                    {
+                        lTimer->mNextTimer = this->mNextTimer;
+                        break;
+                    }
 
-                lTimer = lTimer->mNextTimer;
+                    lTimer = lTimer->mNextTimer;
+                }
             }
+
+            this->mNextTimer = NULL;
         }
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+    }
+
+    this->mQueue = kQueue_None;
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+/**
+ *  Order timers by expiration and, for equal expirations, by start order.
+ */
+bool Timer::IsDueBefore(const Timer & aOther) const
+{
+    if (this->mAwakenEpoch != aOther.mAwakenEpoch)
+        return IsEarlierEpoch(this->mAwakenEpoch, aOther.mAwakenEpoch);
 
-        this->mNextTimer = NULL;
+    return static_cast<int32_t>(this->mSequence - aOther.mSequence) < 0;
+}
+
+void Timer::HeapPush(Layer & aLayer, Timer & aTimer)
+{
+    VerifyOrDie(aLayer.mTimerHeapSize < CHIP_SYSTEM_CONFIG_NUM_TIMERS);
+
+    aTimer.mHeapIndex                        = aLayer.mTimerHeapSize;
+    aLayer.mTimerHeap[aLayer.mTimerHeapSize] = &aTimer;
+    aLayer.mTimerHeapSize++;
+
+    HeapSiftUp(aLayer, aTimer.mHeapIndex);
+}
+
+void Timer::HeapRemove(Layer & aLayer, Timer & aTimer)
+{
+    const size_t lIndex = aTimer.mHeapIndex;
+    Timer * lLast       = aLayer.mTimerHeap[--aLayer.mTimerHeapSize];
+
+    aTimer.mHeapIndex = kNotInHeap;
+
+    if (lLast != &aTimer)
+    {
+        aLayer.mTimerHeap[lIndex] = lLast;
+        lLast->mHeapIndex         = lIndex;
+
+        HeapSiftUp(aLayer, lIndex);
+        HeapSiftDown(aLayer, lLast->mHeapIndex);
     }
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+}
 
-    this->Release();
-exit:
-    return CHIP_SYSTEM_NO_ERROR;
+void Timer::HeapSiftUp(Layer & aLayer, size_t aIndex)
+{
+    Timer * lTimer = aLayer.mTimerHeap[aIndex];
+
+    while (aIndex > 0)
+    {
+        const size_t lParent = (aIndex - 1) / 2;
+
+        if (!lTimer->IsDueBefore(*aLayer.mTimerHeap[lParent]))
+            break;
+
+        aLayer.mTimerHeap[aIndex]             = aLayer.mTimerHeap[lParent];
+        aLayer.mTimerHeap[aIndex]->mHeapIndex = aIndex;
+        aIndex                                = lParent;
+    }
+
+    aLayer.mTimerHeap[aIndex] = lTimer;
+    lTimer->mHeapIndex        = aIndex;
+}
+
+void Timer::HeapSiftDown(Layer & aLayer, size_t aIndex)
+{
+    Timer * lTimer = aLayer.mTimerHeap[aIndex];
+
+    while (true)
+    {
+        size_t lChild = 2 * aIndex + 1;
+
+        if (lChild >= aLayer.mTimerHeapSize)
+            break;
+
+        if (lChild + 1 < aLayer.mTimerHeapSize && aLayer.mTimerHeap[lChild + 1]->IsDueBefore(*aLayer.mTimerHeap[lChild]))
+            lChild++;
+
+        if (!aLayer.mTimerHeap[lChild]->IsDueBefore(*lTimer))
+            break;
+
+        aLayer.mTimerHeap[aIndex]             = aLayer.mTimerHeap[lChild];
+        aLayer.mTimerHeap[aIndex]->mHeapIndex = aIndex;
+        aIndex                                = lChild;
+    }
+
+    aLayer.mTimerHeap[aIndex] = lTimer;
+    lTimer->mHeapIndex        = aIndex;
 }
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 /**
  *  This method is called by the underlying timer mechanism provided by the platform when the timer fires.
@@ -265,8 +418,15 @@ void Timer::HandleComplete()
     // Atomically disarm if the value has not changed.
     VerifyOrExit(__sync_bool_compare_and_swap(&this->OnComplete, lOnComplete, NULL), );
 
+    // Work scheduled on LwIP also completes here, but only counts as a timer if it was started as one.
+    if (this->mQueue == kQueue_Timers)
+    {
+        SYSTEM_STATS_COUNT(chip::System::Stats::kSystemLayer_TimerFires);
+    }
+
     // Since this thread changed the state of OnComplete, release the timer.
     AppState = NULL;
+    this->Dequeue(lLayer);
     this->Release();
 
     // Invoke the app's callback, if it's still valid.
@@ -307,7 +467,7 @@ Error Timer::HandleExpiredTimers(Layer & aLayer)
         // (though not exactly same) as that on the sockets-based systems.
 
         // The platform timer API has MSEC resolution so expire any timer with less than 1 msec remaining.
-        if ((timersHandled < Timer::sPool.Size()) && Timer::IsEarlierEpoch(aLayer.mTimerList->mAwakenEpoch, currentEpoch + 1))
+        if ((timersHandled < aLayer.mTimerPool.Size()) && Timer::IsEarlierEpoch(aLayer.mTimerList->mAwakenEpoch, currentEpoch + 1))
         {
             Timer & lTimer    = *aLayer.mTimerList;
             aLayer.mTimerList = lTimer.mNextTimer;
@@ -72,12 +72,40 @@ public:
     Error Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, void * aAppState);
     Error Cancel(void);
 
-    static void GetStatistics(chip::System::Stats::count_t & aNumInUse, chip::System::Stats::count_t & aHighWatermark);
-
 private:
-    static ObjectPool<Timer, CHIP_SYSTEM_CONFIG_NUM_TIMERS> sPool;
+    /**
+     *  The queue of the owning layer an armed timer is linked into.
+     */
+    enum Queue
+    {
+        kQueue_None   = 0, /**< Not linked into any queue. */
+        kQueue_Timers = 1, /**< Started with Start(); indexed by the cancellation table and ordered by expiration. */
+    };
+
+    static const size_t kNotInHeap = SIZE_MAX;
 
     Epoch mAwakenEpoch;
+    uint8_t mQueue;
+    size_t mTableIndex;    ///< bucket of the cancellation table holding this timer
+    Timer * mNextInBucket; ///< next timer in the same bucket of the cancellation table
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    size_t mHeapIndex;  ///< position in the expiration heap of the layer, or kNotInHeap
+    uint32_t mSequence; ///< start order, breaking ties between timers expiring at the same epoch
+
+    bool IsDueBefore(const Timer & aOther) const;
+
+    static void HeapPush(Layer & aLayer, Timer & aTimer);
+    static void HeapRemove(Layer & aLayer, Timer & aTimer);
+    static void HeapSiftUp(Layer & aLayer, size_t aIndex);
+    static void HeapSiftDown(Layer & aLayer, size_t aIndex);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+    static size_t TableIndex(OnCompleteFunct aOnComplete, void * aAppState);
+    static Timer * Find(Layer & aLayer, OnCompleteFunct aOnComplete, void * aAppState);
+
+    void Enqueue(Layer & aLayer);
+    void Dequeue(Layer & aLayer);
 
     void HandleComplete(void);
 
@@ -94,11 +122,6 @@ private:
     Timer & operator=(const Timer &);
 };
 
-inline void Timer::GetStatistics(chip::System::Stats::count_t & aNumInUse, chip::System::Stats::count_t & aHighWatermark)
-{
-    sPool.GetStatistics(aNumInUse, aHighWatermark);
-}
-
 } // namespace System
 } // namespace chip
 
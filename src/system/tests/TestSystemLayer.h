@@ -30,6 +30,7 @@ extern "C" {
 #endif
 
 int TestSystemErrorStr(void);
+int TestSystemLoopMetrics(void);
 int TestSystemObject(void);
 int TestSystemPacketBuffer(void);
 int TestSystemTimer(void);
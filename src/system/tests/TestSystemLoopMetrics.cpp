@@ -0,0 +1,292 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::System::LoopMetrics</tt>,
+ *      the part of the CHIP System Layer that measures the event loop.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+// config
+#include <system/SystemConfig.h>
+
+// module header
+#include "TestSystemLayer.h"
+
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/TestUtils.h>
+#include <system/SystemError.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLoopMetrics.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#include <sys/select.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+using chip::ErrorStr;
+using namespace chip::System;
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+namespace LoopMetrics = chip::System::LoopMetrics;
+
+class TestContext
+{
+public:
+    Layer * mLayer;
+    nlTestSuite * mTestSuite;
+};
+
+static bool sTimerHandled;
+static bool sWorkHandled;
+
+static void ServiceEvents(Layer & aLayer, ::timeval & aSleepTime)
+{
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    aLayer.PrepareEvents(aSleepTime);
+
+    SYSTEM_LOOP_METRICS_WAIT_BEGIN();
+    int eventCount = aLayer.WaitForEvents(aSleepTime);
+    SYSTEM_LOOP_METRICS_WAIT_END();
+    if (eventCount < 0)
+    {
+        printf("epoll_wait failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    aLayer.HandleEvents(eventCount);
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+    fd_set readFDs, writeFDs, exceptFDs;
+    int numFDs = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    aLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, aSleepTime);
+
+    SYSTEM_LOOP_METRICS_WAIT_BEGIN();
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &aSleepTime);
+    SYSTEM_LOOP_METRICS_WAIT_END();
+    if (selectRes < 0)
+    {
+        printf("select failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    aLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+
+static void HandleTimer(Layer * aLayer, void * aState, Error aError)
+{
+    (void) aLayer, (void) aState, (void) aError;
+    sTimerHandled = true;
+}
+
+static void HandleWork(Layer * aLayer, void * aState, Error aError)
+{
+    (void) aLayer, (void) aState, (void) aError;
+    sWorkHandled = true;
+}
+
+/**
+ *  Test that durations are counted in the bucket of their power of two.
+ */
+static void CheckHistogram(nlTestSuite * inSuite, void * aContext)
+{
+    LoopMetrics::Histogram lHistogram;
+
+    NL_TEST_ASSERT(inSuite, LoopMetrics::Histogram::BucketFor(0) == 0);
+    NL_TEST_ASSERT(inSuite, LoopMetrics::Histogram::BucketFor(1) == 1);
+    NL_TEST_ASSERT(inSuite, LoopMetrics::Histogram::BucketFor(3) == 2);
+    NL_TEST_ASSERT(inSuite, LoopMetrics::Histogram::BucketFor(4) == 3);
+    NL_TEST_ASSERT(inSuite, LoopMetrics::Histogram::BucketFor(UINT64_MAX) == LoopMetrics::Histogram::kNumBuckets - 1);
+
+    lHistogram.Clear();
+    lHistogram.Record(10);
+    lHistogram.Record(12);
+
+    NL_TEST_ASSERT(inSuite, lHistogram.mCount == 2 && lHistogram.mMaxUS == 12 && lHistogram.mTotalUS == 22);
+    NL_TEST_ASSERT(inSuite, lHistogram.mBuckets[LoopMetrics::Histogram::BucketFor(10)] == 2);
+}
+
+/**
+ *  Test that timers and scheduled work dispatched by the event loop are recorded under their callbacks.
+ */
+static void CheckSources(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    const LoopMetrics::Source * lSource;
+
+    LoopMetrics::Reset();
+    sTimerHandled = false;
+    sWorkHandled  = false;
+
+    lSys.StartTimer(2, HandleTimer, aContext);
+    lSys.ScheduleWork(HandleWork, aContext);
+
+    for (size_t lTicks = 0; lTicks < 1000 && !(sTimerHandled && sWorkHandled); lTicks++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sTimerHandled && sWorkHandled);
+
+    lSource = LoopMetrics::FindSource(LoopMetrics::kSource_Timer, reinterpret_cast<uintptr_t>(HandleTimer));
+    NL_TEST_ASSERT(inSuite, lSource != NULL && lSource->mDurationUS.mCount == 1);
+
+    lSource = LoopMetrics::FindSource(LoopMetrics::kSource_Work, reinterpret_cast<uintptr_t>(HandleWork));
+    NL_TEST_ASSERT(inSuite, lSource != NULL && lSource->mDurationUS.mCount == 1);
+
+    NL_TEST_ASSERT(inSuite, LoopMetrics::GetTimerLag().mCount >= 1);
+    NL_TEST_ASSERT(inSuite, LoopMetrics::GetWaitTime().mCount >= 1);
+
+    // Sources beyond the capacity of the table are accounted together.
+    LoopMetrics::Reset();
+    for (uintptr_t i = 0; i <= CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES; i++)
+        LoopMetrics::Record(LoopMetrics::kSource_Event, i, 10);
+
+    size_t lNumSources;
+    LoopMetrics::GetSources(lNumSources);
+    NL_TEST_ASSERT(inSuite, lNumSources == CHIP_SYSTEM_CONFIG_LOOP_METRICS_NUM_SOURCES);
+    NL_TEST_ASSERT(inSuite, LoopMetrics::FindSource(LoopMetrics::kSource_Overflow, 0)->mDurationUS.mCount == 1);
+    NL_TEST_ASSERT(inSuite, LoopMetrics::FindSource(LoopMetrics::kSource_Event, 3)->mDurationUS.mBuckets[4] == 1);
+
+    LoopMetrics::Reset();
+}
+
+/**
+ *  Test the JSON dump of the metrics, complete and truncated.
+ */
+static void CheckWriteJSON(nlTestSuite * inSuite, void * aContext)
+{
+    char lJSON[2048];
+    size_t lLength;
+
+    LoopMetrics::Reset();
+    LoopMetrics::Record(LoopMetrics::kSource_Timer, reinterpret_cast<uintptr_t>(HandleTimer), 10);
+    LoopMetrics::RecordTimerLag(100);
+
+    lLength = LoopMetrics::WriteJSON(lJSON, sizeof(lJSON));
+    NL_TEST_ASSERT(inSuite, lLength < sizeof(lJSON) && strlen(lJSON) == lLength);
+    NL_TEST_ASSERT(inSuite, strncmp(lJSON, "{\"waitTime\":{\"count\":", 21) == 0);
+    NL_TEST_ASSERT(inSuite, strstr(lJSON, "{\"kind\":\"timer\",\"key\":\"0x") != NULL);
+    NL_TEST_ASSERT(inSuite, lJSON[lLength - 1] == '}');
+
+    // A truncated dump is still terminated, and reports the length of the complete one.
+    NL_TEST_ASSERT(inSuite, LoopMetrics::WriteJSON(lJSON, 16) == lLength && strlen(lJSON) == 15);
+
+    LoopMetrics::Reset();
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("LoopMetrics::TestHistogram",      CheckHistogram),
+    NL_TEST_DEF("LoopMetrics::TestSources",        CheckSources),
+    NL_TEST_DEF("LoopMetrics::TestWriteJSON",      CheckWriteJSON),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static int TestSetup(void * aContext);
+static int TestTeardown(void * aContext);
+
+// clang-format off
+static nlTestSuite kTheSuite =
+{
+    "chip-system-loop-metrics",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * aContext)
+{
+    static Layer sLayer;
+
+    TestContext & lContext = *reinterpret_cast<TestContext *>(aContext);
+
+    if (sLayer.Init(NULL) != CHIP_SYSTEM_NO_ERROR)
+        return FAILURE;
+
+    lContext.mLayer     = &sLayer;
+    lContext.mTestSuite = &kTheSuite;
+
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * aContext)
+{
+    TestContext & lContext = *reinterpret_cast<TestContext *>(aContext);
+
+    lContext.mLayer->Shutdown();
+
+    return (SUCCESS);
+}
+
+int TestSystemLoopMetrics(void)
+{
+    TestContext context;
+
+    nlTestRunner(&kTheSuite, &context);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
+
+#else // !(CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS && CHIP_SYSTEM_CONFIG_USE_SOCKETS)
+
+int TestSystemLoopMetrics(void)
+{
+    // Nothing to test without the loop metrics.
+    return 0;
+}
+
+#endif // !(CHIP_SYSTEM_CONFIG_PROVIDE_LOOP_METRICS && CHIP_SYSTEM_CONFIG_USE_SOCKETS)
+
+static void __attribute__((constructor)) TestSystemLoopMetricsCtor(void)
+{
+    VerifyOrDie(chip::RegisterUnitTests(&TestSystemLoopMetrics) == CHIP_NO_ERROR);
+}
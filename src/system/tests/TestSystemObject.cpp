@@ -88,6 +88,8 @@ private:
     };
     static ObjectPool<TestObject, kPoolSize> sPool;
 
+    static void ResetPool(void);
+
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     unsigned int mDelay;
 
@@ -111,6 +113,15 @@ private:
 
 ObjectPool<TestObject, TestObject::kPoolSize> TestObject::sPool;
 
+/**
+ *  Forget the objects of the pool, and its allocation state, as if it were never used.
+ */
+void TestObject::ResetPool(void)
+{
+    memset(&sPool.mArena, 0, sizeof(sPool.mArena));
+    memset(&sPool.mBase, 0, sizeof(sPool.mBase));
+}
+
 Error TestObject::Init(void)
 {
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -142,7 +153,7 @@ void TestObject::CheckRetention(nlTestSuite * inSuite, void * aContext)
     unsigned int i, j;
 
     lLayer.Init(lContext.mLayerContext);
-    memset(&sPool, 0, sizeof(sPool));
+    ResetPool();
 
     for (i = 0; i < kPoolSize; ++i)
     {
@@ -337,7 +348,7 @@ void TestObject::MultithreadedTest(nlTestSuite * inSuite, void * aContext, void
     TestContext & lContext = *static_cast<TestContext *>(aContext);
     pthread_t lThread[kNumThreads];
 
-    memset(&sPool, 0, sizeof(sPool));
+    ResetPool();
 
     for (unsigned int i = 0; i < kNumThreads; ++i)
     {
@@ -374,7 +385,7 @@ void TestObject::CheckHighWatermarkConcurrency(nlTestSuite * inSuite, void * aCo
 
 void TestObject::CheckHighWatermark(nlTestSuite * inSuite, void * aContext)
 {
-    memset(&sPool, 0, sizeof(sPool));
+    ResetPool();
 
     const int kNumObjects  = kPoolSize;
     TestObject * lObject   = NULL;
@@ -37,6 +37,11 @@
 #include <support/CodeUtils.h>
 #include <support/TestUtils.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -149,7 +154,9 @@ static void BufferAlloc(struct TestContext * theContext)
     memset(theContext->buf, 0, lAllocSize);
 #if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     theContext->buf->alloc_size = lAllocSize;
-#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#else  // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
+    theContext->buf->alloc_size = CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
     theContext->start_buffer = reinterpret_cast<uint8_t *>(theContext->buf);
@@ -1123,12 +1130,279 @@ static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext)
     (void) inContext;
 }
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+/**
+ *  Allocate every buffer available to the calling thread, then free them all.
+ *
+ *  @return the number of buffers allocated.
+ */
+static size_t AllocateAllAndFree(void)
+{
+    PacketBuffer * lChain = NULL;
+    PacketBuffer * lBuffer;
+    size_t lCount = 0;
+
+    while ((lBuffer = PacketBuffer::New(0)) != NULL)
+    {
+        if (lChain == NULL)
+            lChain = lBuffer;
+        else
+            lChain->AddToEnd(lBuffer);
+        lCount++;
+    }
+
+    PacketBuffer::Free(lChain);
+
+    return lCount;
+}
+
+static void * AllocateAllAndFreeThread(void * aCount)
+{
+    *static_cast<size_t *>(aCount) = AllocateAllAndFree();
+    return NULL;
+}
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+/**
+ *  Test that buffers cached by a thread are returned to the pool when it exits.
+ *
+ *  This runs first, as other tests do not return every buffer they take to the pool.
+ */
+static void CheckThreadCache(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    size_t lThreadCount = 0;
+    size_t lMainCount;
+    uint64_t lHitsBefore, lMissesBefore, lHitsAfter, lMissesAfter;
+    pthread_t lThread;
+
+    PacketBuffer::GetThreadCacheStatistics(lHitsBefore, lMissesBefore);
+
+    NL_TEST_ASSERT(inSuite, pthread_create(&lThread, NULL, AllocateAllAndFreeThread, &lThreadCount) == 0);
+    NL_TEST_ASSERT(inSuite, pthread_join(lThread, NULL) == 0);
+    NL_TEST_ASSERT(inSuite, lThreadCount > 0);
+
+    // The buffers freed into the cache of the exited thread must be available to this one.
+    lMainCount = AllocateAllAndFree();
+    NL_TEST_ASSERT(inSuite, lMainCount >= lThreadCount);
+
+    PacketBuffer::GetThreadCacheStatistics(lHitsAfter, lMissesAfter);
+    NL_TEST_ASSERT(inSuite, lHitsAfter > lHitsBefore);
+    NL_TEST_ASSERT(inSuite, lMissesAfter > lMissesBefore);
+#else  // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    (void) inSuite;
+    (void) inContext;
+#endif // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+}
+
+/**
+ *  Test that buffers are taken from the smallest size class that fits, and that RightSize() moves them to smaller classes.
+ */
+static void CheckSizeClasses(nlTestSuite * inSuite, void * inContext)
+{
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC || CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC)
+    const size_t kSmallestCapacity = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC ? CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+                                                                                    : CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY;
+    static const uint8_t kData[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    PacketBuffer * lBuffer;
+
+    lBuffer = PacketBuffer::NewWithAvailableSize(0, sizeof(kData));
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL && lBuffer->AllocSize() == kSmallestCapacity);
+    PacketBuffer::Free(lBuffer);
+
+    lBuffer = PacketBuffer::NewWithAvailableSize(0, CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX);
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL && lBuffer->AllocSize() == CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX);
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    {
+        PacketBuffer * lMedium = PacketBuffer::NewWithAvailableSize(0, CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY);
+        NL_TEST_ASSERT(inSuite, lMedium != NULL && lMedium->AllocSize() == CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY);
+        PacketBuffer::Free(lMedium);
+    }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+
+    // A full size buffer holding little data moves to the smallest class, keeping its reserved space and data.
+    if (lBuffer != NULL)
+    {
+        memcpy(lBuffer->Start(), kData, sizeof(kData));
+        lBuffer->SetDataLength(sizeof(kData));
+
+        lBuffer = PacketBuffer::RightSize(lBuffer);
+        NL_TEST_ASSERT(inSuite, lBuffer->AllocSize() == kSmallestCapacity);
+        NL_TEST_ASSERT(inSuite, lBuffer->ReservedSize() == 0);
+        NL_TEST_ASSERT(inSuite, lBuffer->DataLength() == sizeof(kData));
+        NL_TEST_ASSERT(inSuite, memcmp(lBuffer->Start(), kData, sizeof(kData)) == 0);
+
+        PacketBuffer::Free(lBuffer);
+    }
+#else
+    (void) inSuite;
+    (void) inContext;
+#endif
+}
+
+// Clones copy the data of a buffer rather than share it when no smaller buffer can hold their header.
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP &&                                                                                                \
+    (!CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC || CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC ||                                \
+     CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC)
+#define TEST_CLONES_SHARE_DATA 1
+#else
+#define TEST_CLONES_SHARE_DATA 0
+#endif
+
+/**
+ *  Test that clones share the data of a buffer until one of them prepends a header.
+ */
+static void CheckClone(nlTestSuite * inSuite, void * inContext)
+{
+    static const uint8_t kData[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    PacketBuffer * lBuffer;
+    PacketBuffer * lClone;
+    PacketBuffer * lSecondClone;
+
+    (void) inContext;
+
+    lBuffer = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, lBuffer != NULL);
+    if (lBuffer == NULL)
+        return;
+
+    memcpy(lBuffer->Start(), kData, sizeof(kData));
+    lBuffer->SetDataLength(sizeof(kData));
+    NL_TEST_ASSERT(inSuite, !lBuffer->IsShared());
+    NL_TEST_ASSERT(inSuite, lBuffer->IsWritable());
+
+    lClone = lBuffer->Clone();
+    NL_TEST_ASSERT(inSuite, lClone != NULL);
+    if (lClone == NULL)
+    {
+        PacketBuffer::Free(lBuffer);
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, lClone->DataLength() == sizeof(kData) && lClone->TotalLength() == sizeof(kData));
+    NL_TEST_ASSERT(inSuite, lClone->ReservedSize() == lBuffer->ReservedSize());
+    NL_TEST_ASSERT(inSuite, lClone->MaxDataLength() == lBuffer->MaxDataLength());
+    NL_TEST_ASSERT(inSuite, memcmp(lClone->Start(), kData, sizeof(kData)) == 0);
+
+#if !TEST_CLONES_SHARE_DATA
+    NL_TEST_ASSERT(inSuite, lClone->Start() != lBuffer->Start());
+    NL_TEST_ASSERT(inSuite, !lBuffer->IsShared() && !lClone->IsShared());
+    lSecondClone = NULL;
+#else  // TEST_CLONES_SHARE_DATA
+    static const uint8_t kHeader[] = { 0xA, 0xB, 0xC, 0xD };
+
+    NL_TEST_ASSERT(inSuite, lClone->Start() == lBuffer->Start());
+    NL_TEST_ASSERT(inSuite, lBuffer->IsShared() && lClone->IsShared());
+    NL_TEST_ASSERT(inSuite, !lBuffer->IsWritable() && !lClone->IsWritable());
+
+    lSecondClone = lClone->Clone();
+    NL_TEST_ASSERT(inSuite, lSecondClone != NULL && lSecondClone->Start() == lBuffer->Start());
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+    // Without a buffer to copy the data into, unsharing fails and leaves the buffer unchanged.
+    {
+        uint8_t * const lStart = lClone->Start();
+        PacketBuffer * lAllBuffers = NULL;
+        PacketBuffer * lExtra;
+
+        while ((lExtra = PacketBuffer::New(0)) != NULL)
+        {
+            if (lAllBuffers == NULL)
+                lAllBuffers = lExtra;
+            else
+                lAllBuffers->AddToEnd(lExtra);
+        }
+
+        NL_TEST_ASSERT(inSuite, !lClone->EnsureUnshared());
+        NL_TEST_ASSERT(inSuite, !lClone->EnsureReservedSize(static_cast<uint16_t>(lClone->ReservedSize() + sizeof(kHeader))));
+        NL_TEST_ASSERT(inSuite, lClone->Start() == lStart && lClone->DataLength() == sizeof(kData));
+        NL_TEST_ASSERT(inSuite, lClone->IsShared());
+
+        PacketBuffer::Free(lAllBuffers);
+    }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+
+    // Prepending a header gives the clone a private copy, leaving the data seen by the others unchanged.
+    lClone->SetStart(lClone->Start() - sizeof(kHeader));
+    memcpy(lClone->Start(), kHeader, sizeof(kHeader));
+
+    NL_TEST_ASSERT(inSuite, !lClone->IsShared() && lClone->IsWritable());
+    NL_TEST_ASSERT(inSuite, lClone->DataLength() == sizeof(kHeader) + sizeof(kData));
+    NL_TEST_ASSERT(inSuite, memcmp(lClone->Start() + sizeof(kHeader), kData, sizeof(kData)) == 0);
+    NL_TEST_ASSERT(inSuite, lBuffer->Start() == lSecondClone->Start() && lBuffer->IsShared());
+    NL_TEST_ASSERT(inSuite, memcmp(lBuffer->Start() - sizeof(kHeader), kHeader, sizeof(kHeader)) != 0);
+
+    // Once the original is freed, its last clone has the data to itself and writes to it in place.
+    PacketBuffer::Free(lBuffer);
+    lBuffer = NULL;
+
+    NL_TEST_ASSERT(inSuite, !lSecondClone->IsShared());
+    NL_TEST_ASSERT(inSuite, memcmp(lSecondClone->Start(), kData, sizeof(kData)) == 0);
+
+    {
+        uint8_t * const lStart = lSecondClone->Start();
+
+        NL_TEST_ASSERT(inSuite, lSecondClone->EnsureReservedSize(sizeof(kHeader)));
+        NL_TEST_ASSERT(inSuite, lSecondClone->Start() == lStart);
+    }
+#endif // TEST_CLONES_SHARE_DATA
+
+    PacketBuffer::Free(lBuffer);
+    PacketBuffer::Free(lClone);
+    PacketBuffer::Free(lSecondClone);
+}
+
+/**
+ *  Test that allocations and frees are counted in the System::Stats throughput counters.
+ */
+static void CheckStatsCounters(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    using namespace chip::System::Stats;
+
+    Snapshot lBefore;
+    Snapshot lAfter;
+    Snapshot lDelta;
+    PacketBuffer * lBuffers[2];
+
+    (void) inContext;
+
+    NL_TEST_ASSERT(inSuite, sizeof(count_t) * 8 == CHIP_SYSTEM_CONFIG_STATS_COUNT_BITS);
+    NL_TEST_ASSERT(inSuite, sizeof(counter_t) * 8 == CHIP_SYSTEM_CONFIG_STATS_COUNTER_BITS);
+
+    UpdateSnapshot(lBefore);
+
+    lBuffers[0] = PacketBuffer::New();
+    lBuffers[1] = PacketBuffer::NewWithAvailableSize(0, CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX + 1);
+    NL_TEST_ASSERT(inSuite, lBuffers[0] != NULL && lBuffers[1] == NULL);
+    PacketBuffer::Free(lBuffers[0]);
+
+    UpdateSnapshot(lAfter);
+    Difference(lDelta, lAfter, lBefore);
+
+    NL_TEST_ASSERT(inSuite, lDelta.mCounters[kSystemLayer_PacketBufAllocs] == 1);
+    NL_TEST_ASSERT(inSuite, lDelta.mCounters[kSystemLayer_PacketBufAllocFailures] == 1);
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+    NL_TEST_ASSERT(inSuite, lDelta.mCounters[kSystemLayer_PacketBufFrees] == 1);
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+    NL_TEST_ASSERT(inSuite, strcmp(GetCounterStrings()[kSystemLayer_PacketBufAllocs], "SystemLayer_PacketBufAllocs") == 0);
+#else
+    (void) inSuite;
+    (void) inContext;
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
 // clang-format off
 static const nlTest sTests[] =
 {
+    NL_TEST_DEF("PacketBuffer::ThreadCache",                    CheckThreadCache),
+    NL_TEST_DEF("PacketBuffer::SizeClasses",                    CheckSizeClasses),
+    NL_TEST_DEF("PacketBuffer::Clone",                          CheckClone),
+    NL_TEST_DEF("PacketBuffer::StatsCounters",                  CheckStatsCounters),
     NL_TEST_DEF("PacketBuffer::NewWithAvailableSize&PacketBuffer::Free", CheckNewWithAvailableSizeAndFree),
     NL_TEST_DEF("PacketBuffer::Start",                          CheckStart),
     NL_TEST_DEF("PacketBuffer::SetStart",                       CheckSetStart),
@@ -38,6 +38,7 @@
 #include <support/TestUtils.h>
 #include <system/SystemError.h>
 #include <system/SystemLayer.h>
+#include <system/SystemLoopMetrics.h>
 #include <system/SystemTimer.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -59,7 +60,19 @@ using namespace chip::System;
 
 static void ServiceEvents(Layer & aLayer, ::timeval & aSleepTime)
 {
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    if (aLayer.State() == kLayerState_Initialized)
+        aLayer.PrepareEvents(aSleepTime);
+
+    SYSTEM_LOOP_METRICS_WAIT_BEGIN();
+    int eventCount = aLayer.WaitForEvents(aSleepTime);
+    SYSTEM_LOOP_METRICS_WAIT_END();
+    if (eventCount < 0)
+    {
+        printf("epoll_wait failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+#elif CHIP_SYSTEM_CONFIG_USE_SOCKETS
     fd_set readFDs, writeFDs, exceptFDs;
     int numFDs = 0;
 
@@ -70,7 +83,9 @@ static void ServiceEvents(Layer & aLayer, ::timeval & aSleepTime)
     if (aLayer.State() == kLayerState_Initialized)
         aLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, aSleepTime);
 
+    SYSTEM_LOOP_METRICS_WAIT_BEGIN();
     int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &aSleepTime);
+    SYSTEM_LOOP_METRICS_WAIT_END();
     if (selectRes < 0)
     {
         printf("select failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
@@ -80,7 +95,9 @@ static void ServiceEvents(Layer & aLayer, ::timeval & aSleepTime)
 
     if (aLayer.State() == kLayerState_Initialized)
     {
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        aLayer.HandleEvents(eventCount);
+#elif CHIP_SYSTEM_CONFIG_USE_SOCKETS
         aLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -180,6 +197,114 @@ static void CheckOverflow(nlTestSuite * inSuite, void * aContext)
     lSys.CancelTimer(HandleTimer10Success, aContext);
 }
 
+static const size_t kNumOrderedTimers = 8;
+
+static size_t sOrderedTimersHandled;
+static size_t sOrderedTimerIndices[kNumOrderedTimers];
+
+void HandleOrderedTimer(Layer * aLayer, void * aState, Error aError)
+{
+    (void) aLayer, (void) aError;
+
+    if (sOrderedTimersHandled < kNumOrderedTimers)
+        sOrderedTimerIndices[sOrderedTimersHandled] = *static_cast<size_t *>(aState);
+    sOrderedTimersHandled++;
+}
+
+static void CheckOrderAndCancel(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    size_t lIndices[kNumOrderedTimers];
+
+    sOrderedTimersHandled = 0;
+
+    // Start the timers in reverse order of expiration, then cancel every other one.
+    for (size_t i = 0; i < kNumOrderedTimers; i++)
+    {
+        lIndices[i] = i;
+        lSys.StartTimer(static_cast<uint32_t>(5 * (kNumOrderedTimers - i)), HandleOrderedTimer, &lIndices[i]);
+    }
+
+    for (size_t i = 1; i < kNumOrderedTimers; i += 2)
+        lSys.CancelTimer(HandleOrderedTimer, &lIndices[i]);
+
+    for (size_t lTicks = 0; lTicks < 1000 && sOrderedTimersHandled < kNumOrderedTimers / 2; lTicks++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sOrderedTimersHandled == kNumOrderedTimers / 2);
+
+    for (size_t i = 0; i < sOrderedTimersHandled && i < kNumOrderedTimers / 2; i++)
+        NL_TEST_ASSERT(inSuite, sOrderedTimerIndices[i] == kNumOrderedTimers - 2 - 2 * i);
+}
+
+static size_t sScheduledWorkHandled;
+
+void HandleScheduledWork(Layer * aLayer, void * aState, Error aError)
+{
+    (void) aLayer, (void) aState, (void) aError;
+    sScheduledWorkHandled++;
+}
+
+/**
+ *  Test that CancelTimer() cancels the work scheduled with the same arguments, and Shutdown() the work that has not run.
+ */
+static void CheckCancelScheduledWork(nlTestSuite * inSuite, void * aContext)
+{
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    static Layer sOtherLayer;
+
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    int lStates[2];
+
+    sScheduledWorkHandled = 0;
+
+    NL_TEST_ASSERT(inSuite, lSys.ScheduleWork(HandleScheduledWork, &lStates[0]) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, lSys.ScheduleWork(HandleScheduledWork, &lStates[1]) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, lSys.ScheduleWork(HandleScheduledWork, &lStates[0]) == CHIP_SYSTEM_NO_ERROR);
+    lSys.CancelTimer(HandleScheduledWork, &lStates[0]);
+
+    for (size_t lTicks = 0; lTicks < 20; lTicks++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sScheduledWorkHandled == 1);
+
+    // Work left over by a shut down layer does not run once the layer is initialized again.
+    sScheduledWorkHandled = 0;
+
+    NL_TEST_ASSERT(inSuite, sOtherLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sOtherLayer.ScheduleWork(HandleScheduledWork, &lStates[0]) == CHIP_SYSTEM_NO_ERROR);
+    sOtherLayer.Shutdown();
+    NL_TEST_ASSERT(inSuite, sOtherLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+
+    for (size_t lTicks = 0; lTicks < 20; lTicks++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(sOtherLayer, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sScheduledWorkHandled == 0);
+
+    sOtherLayer.Shutdown();
+#else  // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    (void) inSuite;
+    (void) aContext;
+#endif // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+}
+
 void HandleGreedyTimer(Layer * aLayer, void * aState, Error aError)
 {
     static uint32_t sNumTimersHandled = 0;
@@ -209,6 +334,95 @@ static void CheckStarvation(nlTestSuite * inSuite, void * aContext)
     ServiceEvents(lSys, sleepTime);
 }
 
+static void CheckWakeSelect(nlTestSuite * inSuite, void * aContext)
+{
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    struct timeval sleepTime;
+    uint64_t lStart;
+
+    // A burst of wake requests ends a single wait...
+    for (int i = 0; i < 100; i++)
+        lSys.WakeSelect();
+
+    sleepTime.tv_sec  = 1;
+    sleepTime.tv_usec = 0;
+    lStart            = Layer::GetClock_MonotonicMS();
+    ServiceEvents(lSys, sleepTime);
+    NL_TEST_ASSERT(inSuite, Layer::GetClock_MonotonicMS() - lStart < 500);
+
+    // ...and is entirely drained by it.
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = 20000;
+    lStart            = Layer::GetClock_MonotonicMS();
+    ServiceEvents(lSys, sleepTime);
+    NL_TEST_ASSERT(inSuite, Layer::GetClock_MonotonicMS() - lStart >= 15);
+
+    // A later request wakes the loop again.
+    lSys.WakeSelect();
+
+    sleepTime.tv_sec  = 1;
+    sleepTime.tv_usec = 0;
+    lStart            = Layer::GetClock_MonotonicMS();
+    ServiceEvents(lSys, sleepTime);
+    NL_TEST_ASSERT(inSuite, Layer::GetClock_MonotonicMS() - lStart < 500);
+#else  // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    (void) inSuite;
+    (void) aContext;
+#endif // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+}
+
+/**
+ *  Test that each layer allocates timers from a pool of its own, so that exhausting one layer does not affect another.
+ */
+static void CheckIndependentLayers(nlTestSuite * inSuite, void * aContext)
+{
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    static Layer sOtherLayer;
+
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    Timer * lTimers[CHIP_SYSTEM_CONFIG_NUM_TIMERS];
+    Timer * lTimer = NULL;
+    size_t lNumTimers;
+
+    NL_TEST_ASSERT(inSuite, sOtherLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+
+    for (lNumTimers = 0; lNumTimers < CHIP_SYSTEM_CONFIG_NUM_TIMERS; lNumTimers++)
+    {
+        if (lSys.NewTimer(lTimers[lNumTimers]) != CHIP_SYSTEM_NO_ERROR)
+            break;
+    }
+
+    NL_TEST_ASSERT(inSuite, lSys.NewTimer(lTimer) == CHIP_SYSTEM_ERROR_NO_MEMORY);
+
+    // The other layer still has all of its timers.
+    NL_TEST_ASSERT(inSuite, sOtherLayer.NewTimer(lTimer) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, lTimer != NULL && &lTimer->SystemLayer() == &sOtherLayer);
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    {
+        Stats::Snapshot lSnapshot;
+
+        sOtherLayer.UpdateSnapshot(lSnapshot);
+        NL_TEST_ASSERT(inSuite, lSnapshot.mResourcesInUse[Stats::kSystemLayer_NumTimers] == 1);
+    }
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    if (lTimer != NULL)
+        lTimer->Release();
+
+    while (lNumTimers > 0)
+        lTimers[--lNumTimers]->Release();
+
+    sOtherLayer.Shutdown();
+#else  // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    (void) inSuite;
+    (void) aContext;
+#endif // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+}
+
 // Test Suite
 
 /**
@@ -217,7 +431,11 @@ static void CheckStarvation(nlTestSuite * inSuite, void * aContext)
 // clang-format off
 static const nlTest sTests[] =
 {
+    NL_TEST_DEF("Layer::TestWakeSelect",           CheckWakeSelect),
     NL_TEST_DEF("Timer::TestOverflow",             CheckOverflow),
+    NL_TEST_DEF("Timer::TestOrderAndCancel",       CheckOrderAndCancel),
+    NL_TEST_DEF("Layer::TestCancelScheduledWork",  CheckCancelScheduledWork),
+    NL_TEST_DEF("Layer::TestIndependentLayers",    CheckIndependentLayers),
     NL_TEST_DEF("Timer::TestTimerStarvation",      CheckStarvation),
     NL_TEST_SENTINEL()
 };
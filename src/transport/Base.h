@@ -68,6 +68,12 @@ public:
      */
     virtual CHIP_ERROR SendMessage(const MessageHeader & header, const PeerAddress & address, System::PacketBuffer * msgBuf) = 0;
 
+    /**
+     * Get the length of the largest message, not counting its header, that
+     * the transport sends and receives.
+     */
+    virtual size_t GetMaxPayloadLength() const = 0;
+
     /**
      * Get the path that this transport is associated with.
      *
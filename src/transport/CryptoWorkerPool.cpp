@@ -0,0 +1,285 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   This file implements a pool of threads that encrypt and decrypt messages
+ *   on behalf of SecureSessionMgr.
+ */
+
+#include <transport/CryptoWorkerPool.h>
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <time.h>
+
+namespace chip {
+namespace Transport {
+
+namespace {
+
+// How long a worker waits before scheduling a completion pass again when the work queue of the System::Layer is full.
+constexpr long kScheduleRetryNS = 1000000;
+
+} // namespace
+
+CHIP_ERROR CryptoWorkerPool::Init(System::Layer * systemLayer, size_t threadCount)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    int pthreadErr;
+
+    VerifyOrExit(mState == State::kNotReady, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(systemLayer != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(threadCount > 0 && threadCount <= CHIP_CONFIG_CRYPTO_WORKER_MAX_THREADS, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSystemLayer = systemLayer;
+
+    mFreeJobs = nullptr;
+    for (size_t i = 0; i < CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE; i++)
+    {
+        mJobs[i].next = mFreeJobs;
+        mFreeJobs     = &mJobs[i];
+    }
+    mJobsInFlight        = 0;
+    mCompletionScheduled = 0;
+
+    pthreadErr = pthread_mutex_init(&mMutex, NULL);
+    VerifyOrDie(pthreadErr == 0);
+
+    pthreadErr = pthread_cond_init(&mCompleted, NULL);
+    VerifyOrDie(pthreadErr == 0);
+
+    for (mWorkerCount = 0; mWorkerCount < threadCount; mWorkerCount++)
+    {
+        Worker & worker = mWorkers[mWorkerCount];
+
+        worker.pool = this;
+
+        pthreadErr = pthread_cond_init(&worker.wake, NULL);
+        VerifyOrDie(pthreadErr == 0);
+
+        pthreadErr = pthread_create(&worker.thread, NULL, &WorkerMain, &worker);
+        VerifyOrDie(pthreadErr == 0);
+    }
+
+    mState = State::kInitialized;
+
+exit:
+    return err;
+}
+
+CHIP_ERROR CryptoWorkerPool::Shutdown()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    int pthreadErr;
+
+    VerifyOrExit(mState == State::kInitialized, err = CHIP_ERROR_INCORRECT_STATE);
+
+    Flush();
+
+    for (size_t i = 0; i < mWorkerCount; i++)
+    {
+        Worker & worker = mWorkers[i];
+
+        VerifyOrDie(worker.jobs.Push(nullptr));
+
+        pthread_mutex_lock(&mMutex);
+        pthread_cond_signal(&worker.wake);
+        pthread_mutex_unlock(&mMutex);
+
+        pthreadErr = pthread_join(worker.thread, NULL);
+        VerifyOrDie(pthreadErr == 0);
+
+        pthreadErr = pthread_cond_destroy(&worker.wake);
+        VerifyOrDie(pthreadErr == 0);
+    }
+
+    pthreadErr = pthread_cond_destroy(&mCompleted);
+    VerifyOrDie(pthreadErr == 0);
+
+    pthreadErr = pthread_mutex_destroy(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    // With the workers stopped, nothing schedules HandleCompletions() any more; the pass a worker scheduled after the jobs it
+    // completed were flushed must not run, as the pool may be gone by then.
+    mSystemLayer->CancelTimer(HandleCompletions, this);
+    mCompletionScheduled = 0;
+
+    mWorkerCount = 0;
+    mState       = State::kNotReady;
+
+exit:
+    return err;
+}
+
+CryptoWorkerPool::Job * CryptoWorkerPool::NewJob()
+{
+    Job * job = mFreeJobs;
+
+    if (job != nullptr)
+    {
+        mFreeJobs = job->next;
+        mJobsInFlight++;
+
+        job->msgBuf = nullptr;
+        job->error  = CHIP_NO_ERROR;
+    }
+
+    return job;
+}
+
+void CryptoWorkerPool::Submit(Job * job)
+{
+    // The same session always goes to the same worker, which keeps its jobs in order.
+    const uint64_t hash = reinterpret_cast<uintptr_t>(job->session) * 0x9E3779B97F4A7C15ull;
+    Worker & worker     = mWorkers[(hash >> 32) % mWorkerCount];
+
+    // Never full: there are fewer jobs than slots, and nullptr is only pushed once all jobs are back.
+    VerifyOrDie(worker.jobs.Push(job));
+
+    pthread_mutex_lock(&mMutex);
+    pthread_cond_signal(&worker.wake);
+    pthread_mutex_unlock(&mMutex);
+}
+
+void CryptoWorkerPool::Flush()
+{
+    while (mJobsInFlight > 0)
+    {
+        if (!CompleteJobs())
+        {
+            // Workers signal after pushing a completed job, so one pushed after the check below still wakes this thread.
+            pthread_mutex_lock(&mMutex);
+            while (mCompletedJobs.IsEmpty())
+            {
+                pthread_cond_wait(&mCompleted, &mMutex);
+            }
+            pthread_mutex_unlock(&mMutex);
+        }
+    }
+}
+
+void CryptoWorkerPool::RunJob(Job & job)
+{
+    if (job.kind == Job::Kind::kEncrypt)
+    {
+        job.error = job.session->Encrypt(job.msgBuf, job.header);
+    }
+    else
+    {
+        job.error = job.session->Decrypt(job.msgBuf, job.header);
+    }
+}
+
+bool CryptoWorkerPool::CompleteJobs()
+{
+    bool completed = false;
+    Job * job;
+
+    // Cleared first, so that a job completed while draining schedules another pass. The full barrier keeps the queue from being
+    // read before the flag is seen cleared; otherwise a worker could push a job, still see the flag set and not schedule a pass,
+    // while this pass misses the job.
+    __atomic_store_n(&mCompletionScheduled, 0, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    while (mCompletedJobs.Pop(job))
+    {
+        job->onComplete(*job);
+
+        job->next = mFreeJobs;
+        mFreeJobs = job;
+        mJobsInFlight--;
+        completed = true;
+    }
+
+    return completed;
+}
+
+void * CryptoWorkerPool::WorkerMain(void * arg)
+{
+    Worker & worker         = *static_cast<Worker *>(arg);
+    CryptoWorkerPool & pool = *worker.pool;
+
+    while (true)
+    {
+        Job * job = nullptr;
+
+        pthread_mutex_lock(&pool.mMutex);
+        while (worker.jobs.IsEmpty())
+        {
+            pthread_cond_wait(&worker.wake, &pool.mMutex);
+        }
+        pthread_mutex_unlock(&pool.mMutex);
+
+        // The event loop thread is the only producer, and it completes each push before waking the worker.
+        VerifyOrDie(worker.jobs.Pop(job));
+
+        if (job == nullptr)
+        {
+            break;
+        }
+
+        pool.RunJob(*job);
+
+        VerifyOrDie(pool.mCompletedJobs.Push(job));
+
+        pthread_mutex_lock(&pool.mMutex);
+        pthread_cond_signal(&pool.mCompleted);
+        pthread_mutex_unlock(&pool.mMutex);
+
+        // Sequentially consistent, so that either this worker schedules a pass, or the pass clearing the flag sees the job.
+        if (__atomic_exchange_n(&pool.mCompletionScheduled, 1, __ATOMIC_SEQ_CST) == 0)
+        {
+            // The work queue only fills up transiently; the jobs must not be stranded, so try again once the event loop has had
+            // time to drain it.
+            while (pool.mSystemLayer->ScheduleWork(HandleCompletions, &pool) == CHIP_SYSTEM_ERROR_NO_MEMORY)
+            {
+                struct timespec deadline;
+
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_nsec += kScheduleRetryNS;
+                if (deadline.tv_nsec >= 1000000000)
+                {
+                    deadline.tv_sec++;
+                    deadline.tv_nsec -= 1000000000;
+                }
+
+                pthread_mutex_lock(&pool.mMutex);
+                pthread_cond_timedwait(&worker.wake, &pool.mMutex, &deadline);
+                pthread_mutex_unlock(&pool.mMutex);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void CryptoWorkerPool::HandleCompletions(System::Layer * layer, void * param, System::Error error)
+{
+    CryptoWorkerPool * pool = reinterpret_cast<CryptoWorkerPool *>(param);
+
+    pool->CompleteJobs();
+}
+
+} // namespace Transport
+} // namespace chip
+
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   This file defines a pool of threads that encrypt and decrypt messages
+ *   on behalf of SecureSessionMgr, off the thread running the event loop.
+ */
+
+#ifndef __CRYPTOWORKERPOOL_H__
+#define __CRYPTOWORKERPOOL_H__
+
+#include <core/CHIPCore.h>
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+#include <support/MPSCQueue.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/MessageHeader.h>
+#include <transport/PeerAddress.h>
+#include <transport/SecureSession.h>
+
+#include <pthread.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * @brief
+ *   Encrypts and decrypts messages on worker threads, and hands each one
+ *   back to the event loop of a System::Layer once it is done.
+ *
+ * @details
+ *   All the jobs of a session are run by the same worker, in the order they
+ *   were submitted, and they complete on the event loop in that order too.
+ *   A session must therefore not be used by anything else while it has jobs
+ *   in flight.
+ *
+ *   Except for the workers themselves, everything happens on the thread
+ *   running the event loop: jobs are allocated, submitted and completed
+ *   there, so the pool needs no lock besides the one the workers sleep on.
+ *
+ *   The pool must outlive the managers using it, and must be shut down on
+ *   the event loop thread.
+ */
+class DLL_EXPORT CryptoWorkerPool
+{
+public:
+    /** A message to encrypt or decrypt, and what to do with it afterwards. */
+    struct Job
+    {
+        enum class Kind
+        {
+            kEncrypt,
+            kDecrypt,
+        };
+
+        typedef void (*CompleteFunct)(Job & job);
+
+        Job() : peerAddress(PeerAddress::Uninitialized()) {}
+
+        Kind kind;                     ///< what to do with the message
+        SecureSession * session;       ///< session to encrypt or decrypt with; selects the worker
+        System::PacketBuffer * msgBuf; ///< message, encrypted or decrypted in place
+        MessageHeader header;          ///< header of the message; filled in by encryption
+        PeerAddress peerAddress;       ///< where the message goes to or comes from
+        void * appState;               ///< owner of the job
+        void * appContext;             ///< further state of the owner, e.g. its connection
+        CompleteFunct onComplete;      ///< called on the event loop thread once the job is done
+        CHIP_ERROR error;              ///< result of the encryption or decryption
+        Job * next;                    ///< next free job
+    };
+
+    /**
+     * Start the worker threads.
+     *
+     * @param systemLayer   the layer whose event loop completes the jobs
+     * @param threadCount   number of workers, at most CHIP_CONFIG_CRYPTO_WORKER_MAX_THREADS
+     */
+    CHIP_ERROR Init(System::Layer * systemLayer, size_t threadCount);
+
+    /**
+     * Complete all jobs in flight, then stop the worker threads. Must be called
+     * on the event loop thread, and before the pool is destroyed.
+     */
+    CHIP_ERROR Shutdown();
+
+    System::Layer * SystemLayer() const { return mSystemLayer; }
+
+    /**
+     * Allocate a job, or return nullptr when CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE
+     * jobs are already in flight.
+     */
+    Job * NewJob();
+
+    /** Hand a job allocated with NewJob() to the worker of its session. */
+    void Submit(Job * job);
+
+    /** Wait for all jobs in flight, sleeping until the workers complete them, and complete them. */
+    void Flush();
+
+private:
+    struct Worker
+    {
+        CryptoWorkerPool * pool;
+        pthread_t thread;
+        pthread_cond_t wake;                                             ///< signalled when a job is submitted
+        MPSCQueue<Job *, CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE + 1> jobs; ///< submitted jobs, and nullptr to stop
+    };
+
+    enum class State
+    {
+        kNotReady,
+        kInitialized,
+    };
+
+    static void * WorkerMain(void * arg);
+    static void HandleCompletions(System::Layer * layer, void * param, System::Error error);
+
+    void RunJob(Job & job);
+    bool CompleteJobs();
+
+    Job mJobs[CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE];
+    Job * mFreeJobs      = nullptr; ///< jobs not in flight, linked by Job::next
+    size_t mJobsInFlight = 0;
+
+    Worker mWorkers[CHIP_CONFIG_CRYPTO_WORKER_MAX_THREADS];
+    size_t mWorkerCount = 0;
+    pthread_mutex_t mMutex;     ///< held by a worker checking whether to sleep, and to wake it
+    pthread_cond_t mCompleted; ///< signalled when a worker completes a job, for Flush()
+
+    MPSCQueue<Job *, CHIP_CONFIG_CRYPTO_WORKER_QUEUE_SIZE> mCompletedJobs; ///< pushed by the workers, popped by the event loop
+    volatile int mCompletionScheduled = 0; ///< whether HandleCompletions() is already scheduled on the event loop
+
+    System::Layer * mSystemLayer = nullptr;
+    State mState                 = State::kNotReady;
+};
+
+} // namespace Transport
+} // namespace chip
+
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+#endif // __CRYPTOWORKERPOOL_H__
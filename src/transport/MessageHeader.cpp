@@ -64,6 +64,11 @@ constexpr int kVersionShift = 12;
 
 } // namespace
 
+static_assert(MessageHeader::kMaxEncodeSizeBytes == kFixedHeaderSizeBytes + 2 * kNodeIdSizeBytes,
+              "kMaxEncodeSizeBytes does not match the header layout");
+
+constexpr size_t MessageHeader::kMaxEncodeSizeBytes;
+
 size_t MessageHeader::EncodeSizeBytes() const
 {
     size_t size = kFixedHeaderSizeBytes;
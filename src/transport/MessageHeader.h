@@ -164,6 +164,9 @@ public:
      */
     size_t EncodeSizeBytes() const;
 
+    /// Largest value EncodeSizeBytes() returns, when both node ids are present.
+    static constexpr size_t kMaxEncodeSizeBytes = 44;
+
     /**
      * Decodes a header from the given buffer.
      *
@@ -22,8 +22,10 @@
 #ifndef PEER_CONNCTION_STATE_H_
 #define PEER_CONNCTION_STATE_H_
 
+#include <system/TimeSource.h>
 #include <transport/MessageHeader.h>
 #include <transport/PeerAddress.h>
+#include <transport/ReplayWindow.h>
 #include <transport/SecureSession.h>
 
 namespace chip {
@@ -39,6 +41,7 @@ namespace Transport {
  *   - LastActivityTimeMs is a monotonic timestamp of when this connection was
  *     last used. Inactive connections can expire.
  *   - SecureSession contains the encryption context of a connection
+ *   - ReplayWindow tracks received message counters to drop duplicates
  *
  * TODO: to add any message ACK information
  */
@@ -54,12 +57,11 @@ public:
     PeerConnectionState & operator=(const PeerConnectionState &) = default;
     PeerConnectionState & operator=(PeerConnectionState &&) = default;
 
+    /// Address of the peer; changed through PeerConnections::SetPeerAddress so that the state stays indexed.
     const PeerAddress & GetPeerAddress() const { return mPeerAddress; }
-    PeerAddress & GetPeerAddress() { return mPeerAddress; }
-    void SetPeerAddress(const PeerAddress & address) { mPeerAddress = address; }
 
+    /// Node id of the peer; assigned through PeerConnections::SetPeerNodeId so that the state stays indexed.
     NodeId GetPeerNodeId() const { return mPeerNodeId; }
-    void SetPeerNodeId(NodeId peerNodeId) { mPeerNodeId = peerNodeId; }
 
     uint32_t GetSendMessageIndex() const { return mSendMessageIndex; }
     void IncrementSendMessageIndex() { mSendMessageIndex++; }
@@ -70,24 +72,42 @@ public:
     SecureSession & GetSecureSession() { return mSecureSession; }
     const SecureSession & GetSecureSession() const { return mSecureSession; }
 
+    ReplayWindow & GetReplayWindow() { return mReplayWindow; }
+    const ReplayWindow & GetReplayWindow() const { return mReplayWindow; }
+
+    /// Number of messages of the connection being encrypted or decrypted on a worker thread
+    uint16_t GetPendingCryptoJobs() const { return mPendingCryptoJobs; }
+    void AddPendingCryptoJob() { mPendingCryptoJobs++; }
+    void RemovePendingCryptoJob() { mPendingCryptoJobs--; }
+
     /**
      *  Reset the connection state to a completely uninitialized status.
      */
     void Reset()
     {
-        mPeerAddress      = PeerAddress::Uninitialized();
-        mPeerNodeId       = kUndefinedNodeId;
-        mSendMessageIndex = 0;
-        mLastActityTimeMs = 0;
+        mPeerAddress       = PeerAddress::Uninitialized();
+        mPeerNodeId        = kUndefinedNodeId;
+        mSendMessageIndex  = 0;
+        mLastActityTimeMs  = 0;
+        mPendingCryptoJobs = 0;
         mSecureSession.Reset();
+        mReplayWindow.Reset();
     }
 
 private:
+    template <size_t kMaxConnectionCount, Time::Source kTimeSource>
+    friend class PeerConnections;
+
+    void SetPeerAddress(const PeerAddress & address) { mPeerAddress = address; }
+    void SetPeerNodeId(NodeId peerNodeId) { mPeerNodeId = peerNodeId; }
+
     PeerAddress mPeerAddress;
-    NodeId mPeerNodeId         = kUndefinedNodeId;
-    uint32_t mSendMessageIndex = 0;
-    uint64_t mLastActityTimeMs = 0;
+    NodeId mPeerNodeId          = kUndefinedNodeId;
+    uint32_t mSendMessageIndex  = 0;
+    uint64_t mLastActityTimeMs  = 0;
+    uint16_t mPendingCryptoJobs = 0;
     SecureSession mSecureSession;
+    ReplayWindow mReplayWindow;
 };
 
 } // namespace Transport
@@ -17,6 +17,8 @@
 #ifndef PEER_CONNECTIONS_H_
 #define PEER_CONNECTIONS_H_
 
+#include <stdint.h>
+
 #include <core/CHIPError.h>
 #include <support/CodeUtils.h>
 #include <system/TimeSource.h>
@@ -31,11 +33,29 @@ namespace Transport {
  * Intended for:
  *   - handle connection active time and expiration
  *   - allocate and free space for connection states.
+ *
+ * Lookups by peer address and by node id go through open-addressing hash
+ * indexes and free slots are kept on a stack, so the per-message cost of
+ * finding or allocating a connection does not grow with kMaxConnectionCount.
+ *
+ * The indexes are maintained by this class, so the peer address and the peer
+ * node id of a state can only be changed through SetPeerAddress() and
+ * SetPeerNodeId() of this class, which keep the indexes up to date.
  */
 template <size_t kMaxConnectionCount, Time::Source kTimeSource = Time::Source::kSystem>
 class PeerConnections
 {
 public:
+    PeerConnections()
+    {
+        // Slot 0 is at the top of the stack so that slots are initially handed out in order.
+        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        {
+            mFreeSlots[i] = static_cast<SlotIndex>(kMaxConnectionCount - 1 - i);
+        }
+        mFreeSlotCount = kMaxConnectionCount;
+    }
+
     /**
      * Allocates a new peer connection state state object out of the internal resource pool.
      *
@@ -57,23 +77,26 @@ public:
             *state = nullptr;
         }
 
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        VerifyOrExit(address.IsInitialized(), err = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(mFreeSlotCount > 0, err = CHIP_ERROR_NO_MEMORY);
+
         {
-            if (!mStates[i].GetPeerAddress().IsInitialized())
-            {
-                mStates[i] = PeerConnectionState(address);
-                mStates[i].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+            const SlotIndex slot = mFreeSlots[--mFreeSlotCount];
+
+            mStates[slot] = PeerConnectionState(address);
+            mStates[slot].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
 
-                if (state)
-                {
-                    *state = &mStates[i];
-                }
+            AddAddressIndex(slot);
 
-                err = CHIP_NO_ERROR;
-                break;
+            if (state)
+            {
+                *state = &mStates[slot];
             }
         }
 
+        err = CHIP_NO_ERROR;
+
+    exit:
         return err;
     }
 
@@ -88,15 +111,9 @@ public:
     CHECK_RETURN_VALUE
     bool FindPeerConnectionState(const PeerAddress & address, PeerConnectionState ** state)
     {
-        *state = nullptr;
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
-        {
-            if (mStates[i].GetPeerAddress() == address)
-            {
-                *state = &mStates[i];
-                break;
-            }
-        }
+        const SlotIndex slot = FindAddressIndex(address);
+
+        *state = (slot != kInvalidSlot) ? &mStates[slot] : nullptr;
         return *state != nullptr;
     }
 
@@ -112,20 +129,64 @@ public:
     CHECK_RETURN_VALUE
     bool FindPeerConnectionState(NodeId nodeId, PeerConnectionState ** state)
     {
-        *state = nullptr;
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        const SlotIndex slot = (nodeId != kUndefinedNodeId) ? FindNodeIdIndex(nodeId) : kInvalidSlot;
+
+        *state = (slot != kInvalidSlot) ? &mStates[slot] : nullptr;
+        return *state != nullptr;
+    }
+
+    /**
+     * Assigns the node id of a peer connection state, and indexes the state under it. The node id
+     * may be changed at any time; the state is then no longer found under the previous one.
+     *
+     * @param state is a connection state created by this object
+     * @param nodeId is the node id of the peer, or kUndefinedNodeId to clear it
+     */
+    void SetPeerNodeId(PeerConnectionState * state, NodeId nodeId)
+    {
+        VerifyOrDie(state >= mStates && state < mStates + kMaxConnectionCount);
+
+        const SlotIndex slot = static_cast<SlotIndex>(state - mStates);
+
+        if (state->GetPeerNodeId() != kUndefinedNodeId)
         {
-            if (!mStates[i].GetPeerAddress().IsInitialized())
-            {
-                continue;
-            }
-            if (mStates[i].GetPeerNodeId() == nodeId)
-            {
-                *state = &mStates[i];
-                break;
-            }
+            RemoveNodeIdIndex(slot);
         }
-        return *state != nullptr;
+
+        state->SetPeerNodeId(nodeId);
+
+        if (nodeId != kUndefinedNodeId)
+        {
+            AddNodeIdIndex(slot);
+        }
+    }
+
+    /**
+     * Changes the address of a peer connection state, and indexes the state under it. The state is
+     * then no longer found under the previous address.
+     *
+     * @param state is a connection state created by this object
+     * @param address is the new address of the peer
+     *
+     * @returns CHIP_NO_ERROR on success, or CHIP_ERROR_INVALID_ARGUMENT if the address is not initialized.
+     */
+    CHECK_RETURN_VALUE
+    CHIP_ERROR SetPeerAddress(PeerConnectionState * state, const PeerAddress & address)
+    {
+        VerifyOrDie(state >= mStates && state < mStates + kMaxConnectionCount);
+
+        const SlotIndex slot = static_cast<SlotIndex>(state - mStates);
+
+        if (!address.IsInitialized())
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+
+        RemoveAddressIndex(slot);
+        state->SetPeerAddress(address);
+        AddAddressIndex(slot);
+
+        return CHIP_NO_ERROR;
     }
 
     /// Convenience method to mark a peer connection state as active
@@ -157,13 +218,18 @@ public:
                 continue; // not expired
             }
 
+            if (mStates[i].GetPendingCryptoJobs() > 0)
+            {
+                continue; // still referenced by messages being encrypted or decrypted
+            }
+
             if (OnConnectionExpired)
             {
                 OnConnectionExpired(mStates[i], mConnectionExpiredArgument);
             }
 
             // Connection is assumed expired, marking it as invalid
-            mStates[i] = PeerConnectionState(PeerAddress::Uninitialized());
+            ReleaseSlot(static_cast<SlotIndex>(i));
         }
     }
 
@@ -185,9 +251,167 @@ public:
     }
 
 private:
+    static_assert(kMaxConnectionCount > 0 && kMaxConnectionCount < UINT16_MAX, "Unsupported peer connection pool size");
+
+    typedef uint16_t SlotIndex;
+
+    static constexpr SlotIndex kInvalidSlot = UINT16_MAX;
+
+    /// Smallest power of two that keeps the index load factor at or below 50%.
+    static constexpr size_t IndexSizeFor(size_t count, size_t size = 4)
+    {
+        return (size >= 2 * count) ? size : IndexSizeFor(count, size * 2);
+    }
+
+    static constexpr size_t kIndexSize = IndexSizeFor(kMaxConnectionCount);
+    static constexpr size_t kIndexMask = kIndexSize - 1;
+
+    struct AddressIndexEntry
+    {
+        SlotIndex slot = kInvalidSlot;
+    };
+
+    struct NodeIdIndexEntry
+    {
+        NodeId nodeId  = kUndefinedNodeId;
+        SlotIndex slot = kInvalidSlot;
+    };
+
+    static size_t HashAddress(const PeerAddress & address)
+    {
+        const Inet::IPAddress & ipAddress = address.GetIPAddress();
+        uint32_t hash = 2166136261u ^ (static_cast<uint32_t>(address.GetTransportType()) << 16) ^ address.GetPort();
+
+        for (size_t i = 0; i < sizeof(ipAddress.Addr) / sizeof(ipAddress.Addr[0]); i++)
+        {
+            hash = (hash ^ ipAddress.Addr[i]) * 16777619u;
+        }
+
+        return hash ^ (hash >> 15);
+    }
+
+    static size_t HashNodeId(NodeId nodeId) { return static_cast<size_t>((nodeId * 0x9E3779B97F4A7C15ull) >> 32); }
+
+    /**
+     * Removes the entry at the given bucket of a linear probing table, shifting back any
+     * following entries of the same probe sequence so that no tombstones are needed.
+     */
+    template <typename Entry, typename HashFn>
+    static void RemoveIndexBucket(Entry * table, size_t hole, HashFn hashOf)
+    {
+        for (size_t next = (hole + 1) & kIndexMask; table[next].slot != kInvalidSlot; next = (next + 1) & kIndexMask)
+        {
+            const size_t home = hashOf(table[next]) & kIndexMask;
+
+            // Entries whose home bucket is cyclically after the hole must stay where they are.
+            if (((next - home) & kIndexMask) >= ((next - hole) & kIndexMask))
+            {
+                table[hole] = table[next];
+                hole        = next;
+            }
+        }
+
+        table[hole] = Entry();
+    }
+
+    SlotIndex FindAddressIndex(const PeerAddress & address)
+    {
+        for (size_t bucket = HashAddress(address) & kIndexMask; mAddressIndex[bucket].slot != kInvalidSlot;
+             bucket        = (bucket + 1) & kIndexMask)
+        {
+            if (mStates[mAddressIndex[bucket].slot].GetPeerAddress() == address)
+            {
+                return mAddressIndex[bucket].slot;
+            }
+        }
+        return kInvalidSlot;
+    }
+
+    void AddAddressIndex(SlotIndex slot)
+    {
+        size_t bucket = HashAddress(mStates[slot].GetPeerAddress()) & kIndexMask;
+
+        while (mAddressIndex[bucket].slot != kInvalidSlot)
+        {
+            bucket = (bucket + 1) & kIndexMask;
+        }
+        mAddressIndex[bucket].slot = slot;
+    }
+
+    void RemoveAddressIndex(SlotIndex slot)
+    {
+        size_t bucket = HashAddress(mStates[slot].GetPeerAddress()) & kIndexMask;
+
+        while (mAddressIndex[bucket].slot != slot)
+        {
+            VerifyOrDie(mAddressIndex[bucket].slot != kInvalidSlot);
+            bucket = (bucket + 1) & kIndexMask;
+        }
+
+        RemoveIndexBucket(mAddressIndex, bucket,
+                          [this](const AddressIndexEntry & entry) { return HashAddress(mStates[entry.slot].GetPeerAddress()); });
+    }
+
+    SlotIndex FindNodeIdIndex(NodeId nodeId) const
+    {
+        for (size_t bucket = HashNodeId(nodeId) & kIndexMask; mNodeIdIndex[bucket].slot != kInvalidSlot;
+             bucket        = (bucket + 1) & kIndexMask)
+        {
+            if (mNodeIdIndex[bucket].nodeId == nodeId)
+            {
+                return mNodeIdIndex[bucket].slot;
+            }
+        }
+        return kInvalidSlot;
+    }
+
+    void AddNodeIdIndex(SlotIndex slot)
+    {
+        const NodeId nodeId = mStates[slot].GetPeerNodeId();
+        size_t bucket       = HashNodeId(nodeId) & kIndexMask;
+
+        while (mNodeIdIndex[bucket].slot != kInvalidSlot)
+        {
+            bucket = (bucket + 1) & kIndexMask;
+        }
+        mNodeIdIndex[bucket].nodeId = nodeId;
+        mNodeIdIndex[bucket].slot   = slot;
+    }
+
+    void RemoveNodeIdIndex(SlotIndex slot)
+    {
+        size_t bucket = HashNodeId(mStates[slot].GetPeerNodeId()) & kIndexMask;
+
+        while (mNodeIdIndex[bucket].slot != slot)
+        {
+            VerifyOrDie(mNodeIdIndex[bucket].slot != kInvalidSlot);
+            bucket = (bucket + 1) & kIndexMask;
+        }
+
+        RemoveIndexBucket(mNodeIdIndex, bucket, [](const NodeIdIndexEntry & entry) { return HashNodeId(entry.nodeId); });
+    }
+
+    void ReleaseSlot(SlotIndex slot)
+    {
+        RemoveAddressIndex(slot);
+
+        if (mStates[slot].GetPeerNodeId() != kUndefinedNodeId)
+        {
+            RemoveNodeIdIndex(slot);
+        }
+
+        mStates[slot]                = PeerConnectionState(PeerAddress::Uninitialized());
+        mFreeSlots[mFreeSlotCount++] = slot;
+    }
+
     Time::TimeSource<kTimeSource> mTimeSource;
     PeerConnectionState mStates[kMaxConnectionCount];
 
+    SlotIndex mFreeSlots[kMaxConnectionCount];   ///< Stack of unused entries in mStates
+    size_t mFreeSlotCount = 0;                   ///< Number of valid entries in mFreeSlots
+    AddressIndexEntry mAddressIndex[kIndexSize]; ///< Open-addressing index of states by peer address
+    NodeIdIndexEntry mNodeIdIndex[kIndexSize];   ///< Open-addressing index of states by peer node id
+
     typedef void (*ConnectionExpiredHandler)(const PeerConnectionState & state, void * param);
 
     ConnectionExpiredHandler OnConnectionExpired = nullptr; ///< Callback for connection expiry
@@ -0,0 +1,129 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Defines a sliding window used to reject duplicate and replayed
+ *   message counters received from a peer.
+ */
+
+#ifndef REPLAY_WINDOW_H_
+#define REPLAY_WINDOW_H_
+
+#include <stdint.h>
+
+#include <core/CHIPError.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Tracks the most recently received message counters of a peer.
+ *
+ * The window remembers the highest counter seen so far and, in a bitmap,
+ * which of the kWindowSize counters directly below it were already
+ * received. Counters older than the window are rejected.
+ *
+ * Checking is split from recording so that a counter is only recorded once
+ * the message carrying it has been authenticated:
+ *
+ *   - Verify() is called before decryption and rejects duplicates.
+ *   - Commit() is called after successful decryption.
+ *
+ * Both operations are constant time.
+ */
+class ReplayWindow
+{
+public:
+    static constexpr uint64_t kWindowSize = 64;
+
+    /**
+     * Check whether a counter may be accepted.
+     *
+     * @param counter the message counter received from the peer
+     *
+     * @return CHIP_NO_ERROR if the counter was not received before,
+     *         CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED if it was already received
+     *         or is too old to be tracked.
+     */
+    CHIP_ERROR Verify(uint64_t counter) const
+    {
+        if (!mHasReceived || counter > mMaxCounter)
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        const uint64_t offset = mMaxCounter - counter;
+        if (offset >= kWindowSize || (mBitmap & (1ULL << offset)) != 0)
+        {
+            return CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED;
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Record a counter as received. Must only be called for counters that
+     * passed Verify() and belong to an authenticated message.
+     */
+    void Commit(uint64_t counter)
+    {
+        if (!mHasReceived)
+        {
+            mHasReceived = true;
+            mMaxCounter  = counter;
+            mBitmap      = 1;
+            return;
+        }
+
+        if (counter > mMaxCounter)
+        {
+            const uint64_t shift = counter - mMaxCounter;
+
+            mBitmap     = (shift >= kWindowSize) ? 1 : ((mBitmap << shift) | 1);
+            mMaxCounter = counter;
+        }
+        else
+        {
+            const uint64_t offset = mMaxCounter - counter;
+            if (offset < kWindowSize)
+            {
+                mBitmap |= (1ULL << offset);
+            }
+        }
+    }
+
+    /**
+     *  Forget every received counter.
+     */
+    void Reset()
+    {
+        mHasReceived = false;
+        mMaxCounter  = 0;
+        mBitmap      = 0;
+    }
+
+private:
+    bool mHasReceived    = false;
+    uint64_t mMaxCounter = 0;
+    uint64_t mBitmap     = 0; ///< bit N set if (mMaxCounter - N) was received
+};
+
+} // namespace Transport
+} // namespace chip
+
+#endif // REPLAY_WINDOW_H_
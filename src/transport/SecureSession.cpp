@@ -48,6 +48,7 @@ CHIP_ERROR SecureSession::Init(const unsigned char * remote_public_key, const si
     CHIP_ERROR error = CHIP_NO_ERROR;
     uint8_t secret[kMax_ECDH_Secret_Length];
     size_t secret_size = sizeof(secret);
+    uint8_t key[kAES_CCM128_Key_Length];
 
     VerifyOrExit(mKeyAvailable == false, error = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(remote_public_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
@@ -65,13 +66,17 @@ CHIP_ERROR SecureSession::Init(const unsigned char * remote_public_key, const si
     mNextIV = 0;
 
     error = ECDH_derive_secret(remote_public_key, public_key_length, local_private_key, private_key_length, secret, secret_size);
-    if (error == CHIP_NO_ERROR)
-    {
-        error         = HKDF_SHA256(secret, sizeof(secret), salt, salt_length, info, info_length, mKey, sizeof(mKey));
-        mKeyAvailable = (error == CHIP_NO_ERROR);
-    }
+    SuccessOrExit(error);
+
+    error = HKDF_SHA256(secret, sizeof(secret), salt, salt_length, info, info_length, key, sizeof(key));
+    SuccessOrExit(error);
+
+    error         = mKeyContext.Init(key, sizeof(key));
+    mKeyAvailable = (error == CHIP_NO_ERROR);
 
 exit:
+    memset(secret, 0, sizeof(secret));
+    memset(key, 0, sizeof(key));
     return error;
 }
 
@@ -79,7 +84,7 @@ void SecureSession::Reset(void)
 {
     mKeyAvailable = false;
     mNextIV       = 0;
-    memset(mKey, 0, sizeof(mKey));
+    mKeyContext.Clear();
 }
 
 CHIP_ERROR SecureSession::Encrypt(const unsigned char * input, size_t input_length, unsigned char * output, MessageHeader & header)
@@ -92,8 +97,8 @@ CHIP_ERROR SecureSession::Encrypt(const unsigned char * input, size_t input_leng
     VerifyOrExit(input_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(output != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    error = AES_CCM_encrypt(input, input_length, NULL, 0, mKey, sizeof(mKey), (const unsigned char *) &mNextIV, sizeof(mNextIV),
-                            output, (unsigned char *) &tag, sizeof(tag));
+    error = mKeyContext.Encrypt(input, input_length, NULL, 0, (const unsigned char *) &mNextIV, sizeof(mNextIV), output,
+                                (unsigned char *) &tag, sizeof(tag));
     SuccessOrExit(error);
 
     header.SetIV(mNextIV).SetTag(tag);
@@ -116,8 +121,82 @@ CHIP_ERROR SecureSession::Decrypt(const unsigned char * input, size_t input_leng
     VerifyOrExit(input_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(output != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    error = AES_CCM_decrypt(input, input_length, NULL, 0, (const unsigned char *) &tag, sizeof(tag), mKey, sizeof(mKey),
-                            (const unsigned char *) &IV, sizeof(IV), output);
+    error = mKeyContext.Decrypt(input, input_length, NULL, 0, (const unsigned char *) &tag, sizeof(tag),
+                                (const unsigned char *) &IV, sizeof(IV), output);
+exit:
+    return error;
+}
+
+CHIP_ERROR SecureSession::Encrypt(System::PacketBuffer * msgBuf, MessageHeader & header)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    unsigned char * segments[kMaxMessageSegments];
+    size_t lengths[kMaxMessageSegments];
+    size_t count = 0;
+    uint64_t tag = 0;
+
+    VerifyOrExit(msgBuf != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (msgBuf->Next() == NULL)
+    {
+        ExitNow(error = Encrypt(msgBuf->Start(), msgBuf->DataLength(), msgBuf->Start(), header));
+    }
+
+    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    SuccessOrExit(error = CollectSegments(msgBuf, segments, lengths, count));
+
+    error = mKeyContext.EncryptSegments(segments, lengths, count, NULL, 0, (const unsigned char *) &mNextIV, sizeof(mNextIV),
+                                        (unsigned char *) &tag, sizeof(tag));
+    SuccessOrExit(error);
+
+    header.SetIV(mNextIV).SetTag(tag);
+
+    mNextIV++;
+
+exit:
+    return error;
+}
+
+CHIP_ERROR SecureSession::Decrypt(System::PacketBuffer * msgBuf, const MessageHeader & header)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    unsigned char * segments[kMaxMessageSegments];
+    size_t lengths[kMaxMessageSegments];
+    size_t count = 0;
+    uint64_t tag = header.GetTag();
+    uint64_t IV  = header.GetIV();
+
+    VerifyOrExit(msgBuf != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (msgBuf->Next() == NULL)
+    {
+        ExitNow(error = Decrypt(msgBuf->Start(), msgBuf->DataLength(), msgBuf->Start(), header));
+    }
+
+    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    SuccessOrExit(error = CollectSegments(msgBuf, segments, lengths, count));
+
+    error = mKeyContext.DecryptSegments(segments, lengths, count, NULL, 0, (const unsigned char *) &tag, sizeof(tag),
+                                        (const unsigned char *) &IV, sizeof(IV));
+
+exit:
+    return error;
+}
+
+CHIP_ERROR SecureSession::CollectSegments(System::PacketBuffer * msgBuf, unsigned char ** segments, size_t * lengths,
+                                          size_t & count)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    for (count = 0; msgBuf != NULL; msgBuf = msgBuf->Next())
+    {
+        VerifyOrExit(count < kMaxMessageSegments, error = CHIP_ERROR_MESSAGE_TOO_LONG);
+
+        segments[count] = msgBuf->Start();
+        lengths[count]  = msgBuf->DataLength();
+        count++;
+    }
+
 exit:
     return error;
 }
@@ -27,6 +27,8 @@
 #define __SECURESESSION_H__
 
 #include <core/CHIPCore.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <system/SystemPacketBuffer.h>
 #include <transport/MessageHeader.h>
 
 namespace chip {
@@ -79,6 +81,31 @@ public:
      */
     CHIP_ERROR Decrypt(const unsigned char * input, size_t input_length, unsigned char * output, const MessageHeader & header);
 
+    /**
+     * @brief
+     *   Encrypt a message in place. The message may span a chain of buffers, of at most
+     *   kMaxMessageSegments, which are encrypted where they are rather than gathered
+     *   into one buffer.
+     *
+     * @param msgBuf First buffer of the message
+     * @param header message header structure
+     * @return CHIP_ERROR The result of encryption
+     */
+    CHIP_ERROR Encrypt(System::PacketBuffer * msgBuf, MessageHeader & header);
+
+    /**
+     * @brief
+     *   Decrypt a message in place, which may span a chain of buffers like for Encrypt.
+     *
+     * @param msgBuf First buffer of the message
+     * @param header message header structure
+     * @return CHIP_ERROR The result of decryption
+     */
+    CHIP_ERROR Decrypt(System::PacketBuffer * msgBuf, const MessageHeader & header);
+
+    /** Maximum number of buffers in a chain passed to Encrypt or Decrypt. */
+    static constexpr size_t kMaxMessageSegments = 16;
+
     /**
      * @brief
      *   Memory overhead of encrypting data. The overhead is indepedent of size of
@@ -112,9 +139,11 @@ public:
 private:
     static constexpr size_t kAES_CCM128_Key_Length = 16;
 
+    static CHIP_ERROR CollectSegments(System::PacketBuffer * msgBuf, unsigned char ** segments, size_t * lengths, size_t & count);
+
     bool mKeyAvailable;
     uint64_t mNextIV;
-    uint8_t mKey[kAES_CCM128_Key_Length];
+    Crypto::AES_CCM_Context mKeyContext; ///< Session key, expanded once at Init and reused for every message
 };
 
 } // namespace chip
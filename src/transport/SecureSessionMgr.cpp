@@ -36,16 +36,19 @@ namespace chip {
 using Transport::PeerAddress;
 using Transport::PeerConnectionState;
 
-// Maximum length of application data that can be encrypted as one block.
-// The limit is derived from IPv6 MTU (1280 bytes) - expected header overheads.
-// This limit would need additional reviews once we have formalized Secure Transport header.
-static const size_t kMax_SecureSDU_Length = 1024;
-
 SecureSessionMgr::SecureSessionMgr() : mState(State::kNotReady) {}
 
 SecureSessionMgr::~SecureSessionMgr()
 {
     CancelExpiryTimer();
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+    if (mCryptoPool != nullptr)
+    {
+        // The messages still in flight refer to the connections; they are dropped as they complete.
+        mState = State::kNotReady;
+        mCryptoPool->Flush();
+    }
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
     if (mCB != nullptr)
     {
         mCB->Release();
@@ -79,11 +82,12 @@ CHIP_ERROR SecureSessionMgr::Connect(NodeId peerNodeId, const Transport::PeerAdd
     PeerConnectionState * state = nullptr;
 
     VerifyOrExit(mState == State::kInitialized, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mTransport.IsPeerInShard(peerAddress), err = CHIP_ERROR_INVALID_ARGUMENT);
 
     err = mPeerConnections.CreateNewPeerConnectionState(peerAddress, &state);
     SuccessOrExit(err);
 
-    state->SetPeerNodeId(peerNodeId);
+    mPeerConnections.SetPeerNodeId(state, peerNodeId);
 
     // TODO:
     //   - on new connection for other transports may not be inline.
@@ -98,47 +102,104 @@ exit:
     return err;
 }
 
-CHIP_ERROR SecureSessionMgr::SendMessage(NodeId peerNodeId, System::PacketBuffer * msgBuf)
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+CHIP_ERROR SecureSessionMgr::SetCryptoWorkerPool(Transport::CryptoWorkerPool * pool)
 {
-    CHIP_ERROR err              = CHIP_NO_ERROR;
-    PeerConnectionState * state = nullptr;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mState == State::kInitialized, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(pool == nullptr || pool->SystemLayer() == mSystemLayer, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Messages still in flight must complete before the next ones, which may be processed elsewhere.
+    if (mCryptoPool != nullptr)
+    {
+        mCryptoPool->Flush();
+    }
+
+    mCryptoPool = pool;
+
+exit:
+    return err;
+}
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+CHIP_ERROR SecureSessionMgr::PrepareEncryption(NodeId peerNodeId, System::PacketBuffer * msgBuf, PeerConnectionState ** state)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
 
     VerifyOrExit(mState == State::kInitialized, err = CHIP_ERROR_INCORRECT_STATE);
 
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(msgBuf->Next() == NULL, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
-    VerifyOrExit(msgBuf->TotalLength() < kMax_SecureSDU_Length, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    VerifyOrExit(msgBuf->TotalLength() <= mTransport.GetMaxPayloadLength(), err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
     // Find an active connection to the specified peer node
-    VerifyOrExit(mPeerConnections.FindPeerConnectionState(peerNodeId, &state), err = CHIP_ERROR_INVALID_DESTINATION_NODE_ID);
+    VerifyOrExit(mPeerConnections.FindPeerConnectionState(peerNodeId, state), err = CHIP_ERROR_INVALID_DESTINATION_NODE_ID);
 
     // This marks any connection where we send data to as 'active'
-    mPeerConnections.MarkConnectionActive(state);
+    mPeerConnections.MarkConnectionActive(*state);
 
+    // The message is encrypted in place; a clone sent to several peers needs its own copy for each of them.
+    for (System::PacketBuffer * buf = msgBuf; buf != NULL; buf = buf->Next())
     {
-        uint8_t * data = msgBuf->Start();
-        MessageHeader header;
+        VerifyOrExit(buf->EnsureUnshared(), err = CHIP_ERROR_NO_MEMORY);
+    }
 
-        err = state->GetSecureSession().Encrypt(data, msgBuf->TotalLength(), data, header);
+exit:
+    return err;
+}
+
+CHIP_ERROR SecureSessionMgr::EncryptMessage(NodeId peerNodeId, System::PacketBuffer * msgBuf, MessageHeader & header,
+                                            PeerConnectionState ** state)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    err = PrepareEncryption(peerNodeId, msgBuf, state);
+    SuccessOrExit(err);
+
+    {
+        // A chain of buffers is encrypted where it is, without gathering it first.
+        err = (*state)->GetSecureSession().Encrypt(msgBuf, header);
         SuccessOrExit(err);
 
-        ChipLogProgress(Inet, "Secure transport transmitting msg %u after encryption", state->GetSendMessageIndex());
+        ChipLogProgress(Inet, "Secure transport transmitting msg %u after encryption", (*state)->GetSendMessageIndex());
 
         header
             .SetSourceNodeId(mLocalNodeId)    //
             .SetDestinationNodeId(peerNodeId) //
-            .SetMessageId(state->GetSendMessageIndex());
+            .SetMessageId((*state)->GetSendMessageIndex());
+    }
 
-        err    = mTransport.SendMessage(header, state->GetPeerAddress(), msgBuf);
+exit:
+    return err;
+}
+
+CHIP_ERROR SecureSessionMgr::SendMessage(NodeId peerNodeId, System::PacketBuffer * msgBuf)
+{
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    PeerConnectionState * state = nullptr;
+    MessageHeader header;
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+    if (mCryptoPool != nullptr)
+    {
+        err    = SubmitEncryption(peerNodeId, msgBuf);
         msgBuf = NULL;
+        ExitNow();
     }
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+    err = EncryptMessage(peerNodeId, msgBuf, header, &state);
+    SuccessOrExit(err);
+
+    err    = mTransport.SendMessage(header, state->GetPeerAddress(), msgBuf);
+    msgBuf = NULL;
     SuccessOrExit(err);
     state->IncrementSendMessageIndex();
 
 exit:
     if (msgBuf != NULL)
     {
-        ChipLogProgress(Inet, "Secure transport failed to encrypt msg %u: %s", state->GetSendMessageIndex(), ErrorStr(err));
+        ChipLogProgress(Inet, "Secure transport failed to encrypt msg: %s", ErrorStr(err));
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
     }
@@ -146,6 +207,229 @@ exit:
     return err;
 }
 
+CHIP_ERROR SecureSessionMgr::SendMessages(const NodeId * peerNodeIds, System::PacketBuffer * const * msgBufs, size_t count)
+{
+    constexpr size_t kBatchSize = INET_CONFIG_UDP_SEND_BATCH_SIZE;
+
+    MessageHeader headers[kBatchSize];
+    Transport::OutgoingMessage messages[kBatchSize];
+    size_t numMessages = 0;
+    CHIP_ERROR err     = CHIP_NO_ERROR;
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+    if (mCryptoPool != nullptr)
+    {
+        // Each message is sent on its own, as soon as it is encrypted.
+        for (size_t i = 0; i < count; i++)
+        {
+            CHIP_ERROR msgErr = SubmitEncryption(peerNodeIds[i], msgBufs[i]);
+
+            if (err == CHIP_NO_ERROR)
+            {
+                err = msgErr;
+            }
+        }
+        ExitNow();
+    }
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+    for (size_t i = 0; i < count; i++)
+    {
+        PeerConnectionState * state = nullptr;
+        CHIP_ERROR msgErr           = EncryptMessage(peerNodeIds[i], msgBufs[i], headers[numMessages], &state);
+
+        if (msgErr != CHIP_NO_ERROR)
+        {
+            ChipLogProgress(Inet, "Secure transport failed to encrypt msg: %s", ErrorStr(msgErr));
+            if (msgBufs[i] != NULL)
+            {
+                PacketBuffer::Free(msgBufs[i]);
+            }
+            if (err == CHIP_NO_ERROR)
+            {
+                err = msgErr;
+            }
+            continue;
+        }
+
+        // The message id is used up once the message is encrypted, whether or not sending it succeeds
+        state->IncrementSendMessageIndex();
+
+        messages[numMessages].header  = &headers[numMessages];
+        messages[numMessages].address = &state->GetPeerAddress();
+        messages[numMessages].msgBuf  = msgBufs[i];
+        numMessages++;
+
+        if (numMessages == kBatchSize)
+        {
+            msgErr      = mTransport.SendMessages(messages, numMessages);
+            numMessages = 0;
+
+            if (err == CHIP_NO_ERROR)
+            {
+                err = msgErr;
+            }
+        }
+    }
+
+    // Send what is left of the last batch
+    if (numMessages > 0)
+    {
+        CHIP_ERROR msgErr = mTransport.SendMessages(messages, numMessages);
+
+        if (err == CHIP_NO_ERROR)
+        {
+            err = msgErr;
+        }
+    }
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+exit:
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+    return err;
+}
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+CHIP_ERROR SecureSessionMgr::SubmitEncryption(NodeId peerNodeId, System::PacketBuffer * msgBuf)
+{
+    CHIP_ERROR err                         = CHIP_NO_ERROR;
+    PeerConnectionState * state            = nullptr;
+    Transport::CryptoWorkerPool::Job * job = nullptr;
+
+    err = PrepareEncryption(peerNodeId, msgBuf, &state);
+    SuccessOrExit(err);
+
+    job = mCryptoPool->NewJob();
+    VerifyOrExit(job != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    job->kind       = Transport::CryptoWorkerPool::Job::Kind::kEncrypt;
+    job->session    = &state->GetSecureSession();
+    job->msgBuf     = msgBuf;
+    job->header     = MessageHeader();
+    job->appState   = this;
+    job->appContext = state;
+    job->onComplete = HandleEncrypted;
+    msgBuf          = NULL;
+
+    job->header
+        .SetSourceNodeId(mLocalNodeId)    //
+        .SetDestinationNodeId(peerNodeId) //
+        .SetMessageId(state->GetSendMessageIndex());
+
+    // The message id is used up once the message is submitted, whether or not sending it succeeds
+    state->IncrementSendMessageIndex();
+    state->AddPendingCryptoJob();
+
+    mCryptoPool->Submit(job);
+
+exit:
+    if (msgBuf != NULL)
+    {
+        ChipLogProgress(Inet, "Secure transport failed to encrypt msg: %s", ErrorStr(err));
+        PacketBuffer::Free(msgBuf);
+    }
+
+    return err;
+}
+
+CHIP_ERROR SecureSessionMgr::SubmitDecryption(const MessageHeader & header, const PeerAddress & peerAddress,
+                                              System::PacketBuffer * msgBuf, PeerConnectionState * state)
+{
+    CHIP_ERROR err                         = CHIP_NO_ERROR;
+    Transport::CryptoWorkerPool::Job * job = mCryptoPool->NewJob();
+
+    VerifyOrExit(job != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    job->kind        = Transport::CryptoWorkerPool::Job::Kind::kDecrypt;
+    job->session     = &state->GetSecureSession();
+    job->msgBuf      = msgBuf;
+    job->header      = header;
+    job->peerAddress = peerAddress;
+    job->appState    = this;
+    job->appContext  = state;
+    job->onComplete  = HandleDecrypted;
+    msgBuf           = NULL;
+
+    state->AddPendingCryptoJob();
+
+    mCryptoPool->Submit(job);
+
+exit:
+    if (msgBuf != NULL)
+    {
+        PacketBuffer::Free(msgBuf);
+    }
+
+    return err;
+}
+
+void SecureSessionMgr::HandleEncrypted(Transport::CryptoWorkerPool::Job & job)
+{
+    SecureSessionMgr * mgr      = reinterpret_cast<SecureSessionMgr *>(job.appState);
+    PeerConnectionState * state = reinterpret_cast<PeerConnectionState *>(job.appContext);
+    CHIP_ERROR err              = job.error;
+
+    state->RemovePendingCryptoJob();
+
+    SuccessOrExit(err);
+    VerifyOrExit(mgr->mState == State::kInitialized, err = CHIP_ERROR_INCORRECT_STATE);
+
+    err        = mgr->mTransport.SendMessage(job.header, state->GetPeerAddress(), job.msgBuf);
+    job.msgBuf = NULL;
+
+exit:
+    if (job.msgBuf != NULL)
+    {
+        PacketBuffer::Free(job.msgBuf);
+        job.msgBuf = NULL;
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogProgress(Inet, "Secure transport failed to send msg: %s", ErrorStr(err));
+    }
+}
+
+void SecureSessionMgr::HandleDecrypted(Transport::CryptoWorkerPool::Job & job)
+{
+    SecureSessionMgr * mgr      = reinterpret_cast<SecureSessionMgr *>(job.appState);
+    PeerConnectionState * state = reinterpret_cast<PeerConnectionState *>(job.appContext);
+    CHIP_ERROR err              = job.error;
+
+    state->RemovePendingCryptoJob();
+
+    // The manager is going away; nobody is left to report to.
+    VerifyOrExit(mgr->mState == State::kInitialized, err = CHIP_NO_ERROR);
+
+    VerifyOrExit(err == CHIP_NO_ERROR, ChipLogProgress(Inet, "Secure transport failed to decrypt msg: err %d", err));
+
+    // Another copy of the message may have been accepted while this one was being decrypted.
+    err = state->GetReplayWindow().Verify(job.header.GetIV());
+    VerifyOrExit(err == CHIP_NO_ERROR,
+                 ChipLogProgress(Inet, "Secure transport dropped duplicate msg %u", job.header.GetMessageId()));
+
+    state->GetReplayWindow().Commit(job.header.GetIV());
+
+    if (mgr->mCB != nullptr)
+    {
+        mgr->mCB->OnMessageReceived(job.header, state, job.msgBuf, mgr);
+        job.msgBuf = NULL;
+    }
+
+exit:
+    if (job.msgBuf != NULL)
+    {
+        PacketBuffer::Free(job.msgBuf);
+        job.msgBuf = NULL;
+    }
+
+    if (err != CHIP_NO_ERROR && mgr->mCB != nullptr)
+    {
+        mgr->mCB->OnReceiveError(err, job.peerAddress, mgr);
+    }
+}
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
 CHIP_ERROR SecureSessionMgr::AllocateNewConnection(const MessageHeader & header, const PeerAddress & address,
                                                    Transport::PeerConnectionState ** state)
 {
@@ -156,7 +440,7 @@ CHIP_ERROR SecureSessionMgr::AllocateNewConnection(const MessageHeader & header,
 
     if (header.GetSourceNodeId().HasValue())
     {
-        (*state)->SetPeerNodeId(header.GetSourceNodeId().Value());
+        mPeerConnections.SetPeerNodeId(*state, header.GetSourceNodeId().Value());
     }
 
     if (mCB != nullptr)
@@ -184,13 +468,49 @@ void SecureSessionMgr::CancelExpiryTimer(void)
     }
 }
 
+/**
+ * Make sure that a received message can be decrypted in place.
+ *
+ * The message is only copied if its data may not be written to, e.g. when an
+ * LwIP driver received it without copying it into a pbuf of its own, in which
+ * case @a msg is freed and replaced by the copy.
+ */
+static CHIP_ERROR EnsureWritable(System::PacketBuffer *& msg)
+{
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    System::PacketBuffer * copy = nullptr;
+    System::PacketBuffer * buf  = msg;
+    uint16_t offset             = 0;
+
+    while (buf != nullptr && buf->IsWritable())
+    {
+        buf = buf->Next();
+    }
+    VerifyOrExit(buf != nullptr, /* every buffer is writable */);
+
+    copy = PacketBuffer::NewWithAvailableSize(msg->TotalLength());
+    VerifyOrExit(copy != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    for (buf = msg; buf != nullptr; buf = buf->Next())
+    {
+        memcpy(copy->Start() + offset, buf->Start(), buf->DataLength());
+        offset = static_cast<uint16_t>(offset + buf->DataLength());
+    }
+    copy->SetDataLength(offset);
+
+    PacketBuffer::Free(msg);
+    msg = copy;
+
+exit:
+    return err;
+}
+
 void SecureSessionMgr::HandleDataReceived(const MessageHeader & header, const PeerAddress & peerAddress, System::PacketBuffer * msg,
                                           SecureSessionMgr * connection)
 
 {
-    CHIP_ERROR err                 = CHIP_NO_ERROR;
-    System::PacketBuffer * origMsg = nullptr;
-    PeerConnectionState * state    = nullptr;
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    PeerConnectionState * state = nullptr;
 
     VerifyOrExit(msg != nullptr, ChipLogError(Inet, "Secure transport received NULL packet, discarding"));
 
@@ -210,21 +530,31 @@ void SecureSessionMgr::HandleDataReceived(const MessageHeader & header, const Pe
 
     // TODO this is where messages should be decoded
     {
-        uint8_t * data      = msg->Start();
-        uint8_t * plainText = nullptr;
-        uint16_t len        = msg->TotalLength();
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-        /* This is a workaround for the case where PacketBuffer payload is not allocated
-           as an inline buffer to PacketBuffer structure */
-        origMsg = msg;
-        msg     = PacketBuffer::NewWithAvailableSize(len);
-        msg->SetDataLength(len, msg);
-#endif
-        plainText = msg->Start();
-
-        err = state->GetSecureSession().Decrypt(data, len, plainText, header);
+        // Reject duplicates before spending a decrypt on them. The IV is the
+        // authenticated per-message counter, so it is what the window tracks.
+        err = state->GetReplayWindow().Verify(header.GetIV());
+        VerifyOrExit(err == CHIP_NO_ERROR, ChipLogProgress(Inet, "Secure transport dropped duplicate msg %u", header.GetMessageId()));
+
+        // The message is decrypted where it was received, which costs no buffer
+        // unless its data may not be written to.
+        err = EnsureWritable(msg);
+        SuccessOrExit(err);
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+        if (connection->mCryptoPool != nullptr)
+        {
+            // Decrypted in place on a worker thread; HandleDecrypted() finishes the job.
+            err = connection->SubmitDecryption(header, peerAddress, msg, state);
+            msg = nullptr;
+            ExitNow();
+        }
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
+        err = state->GetSecureSession().Decrypt(msg, header);
         VerifyOrExit(err == CHIP_NO_ERROR, ChipLogProgress(Inet, "Secure transport failed to decrypt msg: err %d", err));
 
+        state->GetReplayWindow().Commit(header.GetIV());
+
         if (connection->mCB != nullptr)
         {
             connection->mCB->OnMessageReceived(header, state, msg, connection);
@@ -233,11 +563,6 @@ void SecureSessionMgr::HandleDataReceived(const MessageHeader & header, const Pe
     }
 
 exit:
-    if (origMsg != nullptr)
-    {
-        PacketBuffer::Free(origMsg);
-    }
-
     if (msg != nullptr)
     {
         PacketBuffer::Free(msg);
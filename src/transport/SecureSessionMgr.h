@@ -32,6 +32,7 @@
 #include <core/ReferenceCounted.h>
 #include <inet/IPAddress.h>
 #include <inet/IPEndPointBasis.h>
+#include <transport/CryptoWorkerPool.h>
 #include <transport/PeerConnections.h>
 #include <transport/SecureSession.h>
 #include <transport/UDP.h>
@@ -107,6 +108,10 @@ public:
      * @note This is not a final API as it is UDP specific. Class will be updated to support
      * separate Transports (UDP, BLE, TCP, optional ipv4 for testing etc.). This API is currently
      * UDP-specific and that will change.
+     *
+     * To spread the work over several threads, create one manager per thread, each with its own
+     * InetLayer, and give them the same listen port with UdpListenParameters::SetShard. Every shard
+     * keeps its own peer connections; a peer belongs to the shard Transport::UDP::ShardFor selects.
      */
     CHIP_ERROR Init(NodeId localNodeId, Inet::InetLayer * inet, const Transport::UdpListenParameters & listenParams);
 
@@ -114,6 +119,8 @@ public:
      * Establishes a connection to the given peer node.
      *
      * A connection needs to be established before SendMessage can be called.
+     * When sharded, the peer must belong to this shard, or its replies would be
+     * received by another one.
      */
     CHIP_ERROR Connect(NodeId peerNodeId, const Transport::PeerAddress & peerAddress);
 
@@ -127,6 +134,26 @@ public:
      */
     CHIP_ERROR SendMessage(NodeId peerNodeId, System::PacketBuffer * msgBuf);
 
+    /**
+     * @brief
+     *   Send one message to each of several currently connected peers
+     *
+     * @details
+     *   Message \c i in \c msgBufs is encrypted for and sent to peer \c i in
+     *   \c peerNodeIds. The encrypted messages are handed to the transport in
+     *   batches so that they can be sent with few system calls. A message that
+     *   cannot be sent does not prevent the others from being sent; the error
+     *   of the first one that failed is returned.
+     *
+     *   This method calls <tt>chip::System::PacketBuffer::Free</tt> on every
+     *   message buffer on behalf of the caller regardless of the return status.
+     *
+     *   To send the same message to several peers, pass clones of it made with
+     *   <tt>chip::System::PacketBuffer::Clone</tt>; each one is only copied
+     *   when it is encrypted.
+     */
+    CHIP_ERROR SendMessages(const NodeId * peerNodeIds, System::PacketBuffer * const * msgBufs, size_t count);
+
     SecureSessionMgr();
     virtual ~SecureSessionMgr();
 
@@ -146,6 +173,22 @@ public:
         mCB = cb->Retain();
     }
 
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+    /**
+     * @brief
+     *   Encrypt and decrypt messages on the threads of a worker pool.
+     *
+     * @details
+     *   The pool must complete its jobs on the event loop of the manager's
+     *   System::Layer, and outlive the manager. Messages of a connection are
+     *   still sent and received in order. Sending returns once the message is
+     *   queued for encryption: an error sending it afterwards is only logged.
+     *
+     *   Pass nullptr to go back to encrypting on the event loop thread.
+     */
+    CHIP_ERROR SetCryptoWorkerPool(Transport::CryptoWorkerPool * pool);
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
 private:
     // TODO: add support for multiple transports (TCP, BLE to be added)
     Transport::UDP mTransport;
@@ -157,12 +200,33 @@ private:
 
     SecureSessionMgrCallback * mCB = nullptr;
 
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+    Transport::CryptoWorkerPool * mCryptoPool = nullptr; //< Where messages are encrypted and decrypted, if not inline
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
     /** Schedules a new oneshot timer for checking connection expiry. */
     void ScheduleExpiryTimer(void);
 
     /** Cancels any active timers for connection expiry checks. */
     void CancelExpiryTimer(void);
 
+    /**
+     * Finds the connection of a peer to send a message to, and makes the message
+     * ready to be encrypted in place.
+     */
+    CHIP_ERROR PrepareEncryption(NodeId peerNodeId, System::PacketBuffer * msgBuf, Transport::PeerConnectionState ** state);
+
+    /**
+     * Encrypts a message for a connected peer and fills in its header.
+     *
+     * @param peerNodeId the peer to encrypt the message for
+     * @param msgBuf the message, encrypted in place
+     * @param header [out] the header to send the message with
+     * @param state [out] the connection state of the peer
+     */
+    CHIP_ERROR EncryptMessage(NodeId peerNodeId, System::PacketBuffer * msgBuf, MessageHeader & header,
+                              Transport::PeerConnectionState ** state);
+
     /**
      * Allocates a new connection for the given source.
      *
@@ -176,6 +240,24 @@ private:
     static void HandleDataReceived(const MessageHeader & header, const Transport::PeerAddress & source,
                                    System::PacketBuffer * msgBuf, SecureSessionMgr * transport);
 
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+    /**
+     * Queues a message for encryption on the worker pool; it is sent once encrypted.
+     * Frees the message on failure.
+     */
+    CHIP_ERROR SubmitEncryption(NodeId peerNodeId, System::PacketBuffer * msgBuf);
+
+    /**
+     * Queues a received message for decryption on the worker pool; it is delivered once
+     * decrypted. Frees the message on failure.
+     */
+    CHIP_ERROR SubmitDecryption(const MessageHeader & header, const Transport::PeerAddress & peerAddress,
+                                System::PacketBuffer * msgBuf, Transport::PeerConnectionState * state);
+
+    static void HandleEncrypted(Transport::CryptoWorkerPool::Job & job);
+    static void HandleDecrypted(Transport::CryptoWorkerPool::Job & job);
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
     /**
      * Called when a specific connection expires.
      */
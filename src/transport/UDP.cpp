@@ -51,7 +51,13 @@ CHIP_ERROR UDP::Init(Inet::InetLayer * inetLayer, const UdpListenParameters & pa
 
     VerifyOrExit(mState == State::kNotReady, err = CHIP_ERROR_INCORRECT_STATE);
 
-    mSendPort = params.GetMessageSendPort();
+    VerifyOrExit(params.GetShardIndex() < params.GetShardCount(), err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(params.GetMaxPayloadLength() <= kMaxPayloadLength, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSendPort         = params.GetMessageSendPort();
+    mShardIndex       = params.GetShardIndex();
+    mShardCount       = params.GetShardCount();
+    mMaxPayloadLength = params.GetMaxPayloadLength();
 
     err = inetLayer->NewUDPEndPoint(&mUDPEndPoint);
     SuccessOrExit(err);
@@ -59,6 +65,12 @@ CHIP_ERROR UDP::Init(Inet::InetLayer * inetLayer, const UdpListenParameters & pa
     err = mUDPEndPoint->Bind(params.GetAddressType(), IPAddress::Any, params.GetListenPort(), params.GetInterfaceId());
     SuccessOrExit(err);
 
+    if (mShardCount > 1)
+    {
+        err = mUDPEndPoint->SetReusePortShards(mShardCount);
+        SuccessOrExit(err);
+    }
+
     err = mUDPEndPoint->Listen();
     SuccessOrExit(err);
 
@@ -81,7 +93,8 @@ exit:
     return err;
 }
 
-CHIP_ERROR UDP::SendMessage(const MessageHeader & header, const Transport::PeerAddress & address, System::PacketBuffer * msgBuf)
+CHIP_ERROR UDP::PrepareMessage(const MessageHeader & header, const Transport::PeerAddress & address, System::PacketBuffer * msgBuf,
+                               IPPacketInfo & addrInfo)
 {
     const size_t headerSize = header.EncodeSizeBytes();
     size_t actualEncodedHeaderSize;
@@ -91,7 +104,6 @@ CHIP_ERROR UDP::SendMessage(const MessageHeader & header, const Transport::PeerA
     VerifyOrExit(mState == State::kInitialized, err = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(mUDPEndPoint != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
-    IPPacketInfo addrInfo;
     addrInfo.Clear();
 
     addrInfo.DestAddress = address.GetIPAddress();
@@ -106,6 +118,18 @@ CHIP_ERROR UDP::SendMessage(const MessageHeader & header, const Transport::PeerA
     // This is unexpected and means header changed while encoding
     VerifyOrExit(headerSize == actualEncodedHeaderSize, err = CHIP_ERROR_INTERNAL);
 
+exit:
+    return err;
+}
+
+CHIP_ERROR UDP::SendMessage(const MessageHeader & header, const Transport::PeerAddress & address, System::PacketBuffer * msgBuf)
+{
+    IPPacketInfo addrInfo;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    err = PrepareMessage(header, address, msgBuf, addrInfo);
+    SuccessOrExit(err);
+
     err    = mUDPEndPoint->SendMsg(&addrInfo, msgBuf);
     msgBuf = nullptr;
     SuccessOrExit(err);
@@ -120,6 +144,65 @@ exit:
     return err;
 }
 
+CHIP_ERROR UDP::SendMessages(const OutgoingMessage * messages, size_t count)
+{
+    constexpr size_t kBatchSize = INET_CONFIG_UDP_SEND_BATCH_SIZE;
+
+    IPPacketInfo addrInfo[kBatchSize];
+    Inet::IPPacketBatchEntry entries[kBatchSize];
+    size_t numEntries = 0;
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const OutgoingMessage & message = messages[i];
+        CHIP_ERROR msgErr               = PrepareMessage(*message.header, *message.address, message.msgBuf, addrInfo[numEntries]);
+
+        if (msgErr != CHIP_NO_ERROR)
+        {
+            System::PacketBuffer::Free(message.msgBuf);
+            if (err == CHIP_NO_ERROR)
+            {
+                err = msgErr;
+            }
+            continue;
+        }
+
+        entries[numEntries].PktInfo = &addrInfo[numEntries];
+        entries[numEntries].Buffer  = message.msgBuf;
+        numEntries++;
+
+        if (numEntries == kBatchSize)
+        {
+            msgErr     = mUDPEndPoint->SendMsgBatch(entries, numEntries);
+            numEntries = 0;
+
+            if (err == CHIP_NO_ERROR)
+            {
+                err = msgErr;
+            }
+        }
+    }
+
+    // Send what is left of the last batch
+    if (numEntries > 0)
+    {
+        CHIP_ERROR msgErr = mUDPEndPoint->SendMsgBatch(entries, numEntries);
+
+        if (err == CHIP_NO_ERROR)
+        {
+            err = msgErr;
+        }
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogProgress(Inet, "Failed to send some UDP messages: %s", ErrorStr(err));
+    }
+
+    return err;
+}
+
 void UDP::OnUdpReceive(Inet::IPEndPointBasis * endPoint, System::PacketBuffer * buffer, const IPPacketInfo * pktInfo)
 {
     CHIP_ERROR err          = CHIP_NO_ERROR;
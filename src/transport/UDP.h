@@ -78,11 +78,58 @@ public:
         return *this;
     }
 
+    uint16_t GetShardIndex() const { return mShardIndex; }
+    uint16_t GetShardCount() const { return mShardCount; }
+
+    /**
+     * Make the transport one of several sharing the listen port, each
+     * usually running on its own InetLayer and event loop thread.
+     *
+     * Peers are spread over the shards by their address (see UDP::ShardFor);
+     * the shards must be initialized in index order.
+     */
+    UdpListenParameters & SetShard(uint16_t index, uint16_t count)
+    {
+        mShardIndex = index;
+        mShardCount = count;
+
+        return *this;
+    }
+
+    uint16_t GetMaxPayloadLength() const { return mMaxPayloadLength; }
+
+    /**
+     * Set the length of the largest message, not counting its header, to
+     * send and receive. The default keeps messages within the IPv6 minimum
+     * MTU; a link known to carry larger datagrams may raise it up to
+     * UDP::kMaxPayloadLength.
+     */
+    UdpListenParameters & SetMaxPayloadLength(uint16_t length)
+    {
+        mMaxPayloadLength = length;
+
+        return *this;
+    }
+
+    /// Default largest message: the IPv6 minimum MTU (1280 bytes) less the expected header overheads.
+    static constexpr uint16_t kDefaultMaxPayloadLength = 1024;
+
 private:
-    Inet::IPAddressType mAddressType = kIPAddressType_IPv6;   ///< type of listening socket
-    uint16_t mMessageSendPort        = CHIP_PORT;             ///< over what port to send requests
-    uint16_t mListenPort             = CHIP_PORT;             ///< UDP listen port
-    InterfaceId mInterfaceId         = INET_NULL_INTERFACEID; ///< Interface to listen on
+    Inet::IPAddressType mAddressType = kIPAddressType_IPv6;      ///< type of listening socket
+    uint16_t mMessageSendPort        = CHIP_PORT;                ///< over what port to send requests
+    uint16_t mListenPort             = CHIP_PORT;                ///< UDP listen port
+    InterfaceId mInterfaceId         = INET_NULL_INTERFACEID;    ///< Interface to listen on
+    uint16_t mShardIndex             = 0;                        ///< Position of this transport among those sharing the port
+    uint16_t mShardCount             = 1;                        ///< Number of transports sharing the port
+    uint16_t mMaxPayloadLength       = kDefaultMaxPayloadLength; ///< Largest message, without its header
+};
+
+/** A message to be sent as part of a batch by UDP::SendMessages. */
+struct OutgoingMessage
+{
+    const MessageHeader * header;  ///< header to encode in front of the message
+    const PeerAddress * address;   ///< where to send the message
+    System::PacketBuffer * msgBuf; ///< message payload
 };
 
 /** Implements a transport using UDP. */
@@ -119,17 +166,66 @@ public:
      */
     CHIP_ERROR Init(Inet::InetLayer * inetLayer) { return Init(inetLayer, UdpListenParameters()); }
 
+    /**
+     * Largest message length that SetMaxPayloadLength accepts: a received
+     * datagram, header included, must fit into one packet buffer.
+     */
+    static constexpr size_t kMaxPayloadLength = CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX - MessageHeader::kMaxEncodeSizeBytes;
+
     Type GetType() override { return Type::kUdp; }
+    size_t GetMaxPayloadLength() const override { return mMaxPayloadLength; }
     CHIP_ERROR SendMessage(const MessageHeader & header, const Transport::PeerAddress & address,
                            System::PacketBuffer * msgBuf) override;
 
+    /**
+     * @brief Send several messages, submitting them to the network stack in batches.
+     *
+     * @details
+     *   Up to INET_CONFIG_UDP_SEND_BATCH_SIZE messages are handed to the UDP
+     *   endpoint at once, which allows the platform to send them with a single
+     *   system call. A message that cannot be sent does not prevent the others
+     *   from being sent; the error of the first one that failed is returned.
+     *
+     *   This method calls <tt>chip::System::PacketBuffer::Free</tt> on every
+     *   message buffer on behalf of the caller regardless of the return status.
+     */
+    CHIP_ERROR SendMessages(const OutgoingMessage * messages, size_t count);
+
+    /**
+     * Whether messages from the given peer are received by this transport,
+     * i.e. whether it is the shard the peer is assigned to.
+     */
+    bool IsPeerInShard(const Transport::PeerAddress & address) const
+    {
+        return ShardFor(address, mShardCount) == mShardIndex;
+    }
+
+    /**
+     * Get the index of the shard, among shardCount transports sharing a
+     * port, that receives the messages from the given peer.
+     */
+    static uint16_t ShardFor(const Transport::PeerAddress & address, uint16_t shardCount)
+    {
+        return Inet::UDPEndPoint::ShardForPeer(address.GetIPAddress(), address.GetPort(), shardCount);
+    }
+
 private:
+    /**
+     * Validates that a message can be sent to the given address, fills in
+     * its packet info and encodes the header in front of the message.
+     */
+    CHIP_ERROR PrepareMessage(const MessageHeader & header, const Transport::PeerAddress & address, System::PacketBuffer * msgBuf,
+                              IPPacketInfo & addrInfo);
+
     // UDP message receive handler.
     static void OnUdpReceive(Inet::IPEndPointBasis * endPoint, System::PacketBuffer * buffer, const IPPacketInfo * pktInfo);
 
     Inet::UDPEndPoint * mUDPEndPoint = nullptr;          ///< UDP socket used by the transport
     State mState                     = State::kNotReady; ///< State of the UDP transport
     uint16_t mSendPort               = 0;                ///< Port where packets are sent by default
+    uint16_t mShardIndex             = 0;                ///< Position of this transport among those sharing the port
+    uint16_t mShardCount             = 1;                ///< Number of transports sharing the port
+    size_t mMaxPayloadLength         = 0;                ///< Largest message, without its header
 };
 
 } // namespace Transport
@@ -103,11 +103,11 @@ void TestFindByNodeId(nlTestSuite * inSuite, void * inContext)
 
     err = connections.CreateNewPeerConnectionState(kPeer1Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer1NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer1NodeId);
 
     err = connections.CreateNewPeerConnectionState(kPeer2Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer2NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer2NodeId);
 
     NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1NodeId, &statePtr));
     NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer1Addr);
@@ -121,6 +121,35 @@ void TestFindByNodeId(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, statePtr == nullptr);
 }
 
+void TestChangeAddress(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    PeerConnectionState * statePtr;
+    PeerConnectionState * changedPtr;
+    PeerConnections<2, Time::Source::kTest> connections;
+
+    err = connections.CreateNewPeerConnectionState(kPeer1Addr, nullptr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = connections.CreateNewPeerConnectionState(kPeer2Addr, &changedPtr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = connections.SetPeerAddress(changedPtr, kPeer3Addr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, changedPtr->GetPeerAddress() == kPeer3Addr);
+
+    // The state is found under its new address only.
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer3Addr, &statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr == changedPtr);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer2Addr, &statePtr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1Addr, &statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer1Addr);
+
+    err = connections.SetPeerAddress(changedPtr, PeerAddress::Uninitialized());
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer3Addr, &statePtr));
+}
+
 struct ExpiredCallInfo
 {
     int callCount                   = 0;
@@ -152,7 +181,7 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(200);
     err = connections.CreateNewPeerConnectionState(kPeer2Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer2NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer2NodeId);
 
     // cannot add before expiry
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(300);
@@ -170,7 +199,7 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(300);
     err = connections.CreateNewPeerConnectionState(kPeer3Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer3NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer3NodeId);
 
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(400);
     NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer2NodeId, &statePtr));
@@ -210,6 +239,84 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3Addr, &statePtr));
 }
 
+void TestLargePoolReuse(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kPoolSize = 64;
+
+    CHIP_ERROR err;
+    ExpiredCallInfo callInfo;
+    PeerConnectionState * statePtr;
+    static PeerConnections<kPoolSize, Time::Source::kTest> connections;
+    Inet::IPAddress baseAddr = kPeer1Addr.GetIPAddress();
+
+    connections.SetConnectionExpiredHandler(OnConnectionExpired, &callInfo);
+
+    // Fill the pool with peers that share an IP address but use different ports:
+    // even ports become active at time 100, odd ports at time 200.
+    for (size_t pass = 0; pass < 2; pass++)
+    {
+        connections.GetTimeSource().SetCurrentMonotonicTimeMs(100 + pass * 100);
+
+        for (size_t i = pass; i < kPoolSize; i += 2)
+        {
+            err = connections.CreateNewPeerConnectionState(PeerAddress::UDP(baseAddr, static_cast<uint16_t>(1000 + i)), &statePtr);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            connections.SetPeerNodeId(statePtr, 1000 + i);
+        }
+    }
+
+    err = connections.CreateNewPeerConnectionState(kPeer2Addr, nullptr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(1000 + i, &statePtr));
+        NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress().GetPort() == 1000 + i);
+        NL_TEST_ASSERT(inSuite,
+                       connections.FindPeerConnectionState(PeerAddress::UDP(baseAddr, static_cast<uint16_t>(1000 + i)), &statePtr));
+        NL_TEST_ASSERT(inSuite, statePtr->GetPeerNodeId() == 1000 + i);
+    }
+
+    // Expire every other connection: only those last active at time 100
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(250);
+    connections.ExpireInactiveConnections(100);
+    NL_TEST_ASSERT(inSuite, callInfo.callCount == kPoolSize / 2);
+
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        const bool expired = (i % 2) == 0;
+        NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(1000 + i, &statePtr) != expired);
+        NL_TEST_ASSERT(
+            inSuite,
+            connections.FindPeerConnectionState(PeerAddress::UDP(baseAddr, static_cast<uint16_t>(1000 + i)), &statePtr) != expired);
+    }
+
+    // Freed slots are reusable, and a node id assigned after creation is found
+    for (size_t i = 0; i < kPoolSize / 2; i++)
+    {
+        err = connections.CreateNewPeerConnectionState(PeerAddress::UDP(baseAddr, static_cast<uint16_t>(2000 + i)), &statePtr);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    err = connections.CreateNewPeerConnectionState(kPeer2Addr, nullptr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer2NodeId, &statePtr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(PeerAddress::UDP(baseAddr, 2005), &statePtr));
+    connections.SetPeerNodeId(statePtr, kPeer2NodeId);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer2NodeId, &statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress().GetPort() == 2005);
+
+    // A changed node id is only found under its new value
+    connections.SetPeerNodeId(statePtr, kPeer3NodeId);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer2NodeId, &statePtr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer3NodeId, &statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress().GetPort() == 2005);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(1001, &statePtr));
+    connections.SetPeerNodeId(statePtr, kUndefinedNodeId);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(1001, &statePtr));
+}
+
 } // namespace
 
 // clang-format off
@@ -218,7 +325,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("BasicFunctionality", TestBasicFunctionality),
     NL_TEST_DEF("FindByPeerAddress", TestFindByAddress),
     NL_TEST_DEF("FindByNodeId", TestFindByNodeId),
+    NL_TEST_DEF("ChangeAddress", TestChangeAddress),
     NL_TEST_DEF("ExpireConnections", TestExpireConnections),
+    NL_TEST_DEF("LargePoolReuse", TestLargePoolReuse),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,143 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a process to effect a functional test for
+ *      the ReplayWindow class within the transport layer
+ *
+ */
+#include "TestTransportLayer.h"
+
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <transport/ReplayWindow.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+void TestInOrder(nlTestSuite * inSuite, void * inContext)
+{
+    ReplayWindow window;
+
+    for (uint64_t counter = 0; counter < 3 * ReplayWindow::kWindowSize; counter++)
+    {
+        NL_TEST_ASSERT(inSuite, window.Verify(counter) == CHIP_NO_ERROR);
+        window.Commit(counter);
+        NL_TEST_ASSERT(inSuite, window.Verify(counter) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    }
+}
+
+void TestFirstCounterIsArbitrary(nlTestSuite * inSuite, void * inContext)
+{
+    ReplayWindow window;
+
+    NL_TEST_ASSERT(inSuite, window.Verify(1000) == CHIP_NO_ERROR);
+    window.Commit(1000);
+
+    NL_TEST_ASSERT(inSuite, window.Verify(1000) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Verify(999) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Verify(1001) == CHIP_NO_ERROR);
+}
+
+void TestOutOfOrder(nlTestSuite * inSuite, void * inContext)
+{
+    ReplayWindow window;
+
+    window.Commit(10);
+    window.Commit(5);
+    window.Commit(12);
+
+    NL_TEST_ASSERT(inSuite, window.Verify(5) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Verify(10) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Verify(12) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+
+    NL_TEST_ASSERT(inSuite, window.Verify(6) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Verify(11) == CHIP_NO_ERROR);
+    window.Commit(11);
+    NL_TEST_ASSERT(inSuite, window.Verify(11) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+}
+
+void TestWindowEdges(nlTestSuite * inSuite, void * inContext)
+{
+    const uint64_t kMax = 500;
+    ReplayWindow window;
+
+    window.Commit(kMax);
+
+    // The oldest counter still tracked is kWindowSize - 1 below the maximum
+    NL_TEST_ASSERT(inSuite, window.Verify(kMax - (ReplayWindow::kWindowSize - 1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Verify(kMax - ReplayWindow::kWindowSize) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+
+    window.Commit(kMax - (ReplayWindow::kWindowSize - 1));
+    NL_TEST_ASSERT(inSuite,
+                   window.Verify(kMax - (ReplayWindow::kWindowSize - 1)) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+
+    // Advancing by exactly one window forgets everything but the new maximum
+    window.Commit(kMax + ReplayWindow::kWindowSize);
+    NL_TEST_ASSERT(inSuite, window.Verify(kMax) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Verify(kMax + 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Verify(kMax + ReplayWindow::kWindowSize - 1) == CHIP_NO_ERROR);
+
+    // A large jump must not keep stale bits
+    window.Commit(kMax + 10 * ReplayWindow::kWindowSize);
+    NL_TEST_ASSERT(inSuite, window.Verify(kMax + 10 * ReplayWindow::kWindowSize - 1) == CHIP_NO_ERROR);
+}
+
+void TestReset(nlTestSuite * inSuite, void * inContext)
+{
+    ReplayWindow window;
+
+    window.Commit(0);
+    window.Commit(1);
+    NL_TEST_ASSERT(inSuite, window.Verify(0) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+
+    window.Reset();
+    NL_TEST_ASSERT(inSuite, window.Verify(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Verify(1) == CHIP_NO_ERROR);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("InOrder", TestInOrder),
+    NL_TEST_DEF("FirstCounterIsArbitrary", TestFirstCounterIsArbitrary),
+    NL_TEST_DEF("OutOfOrder", TestOutOfOrder),
+    NL_TEST_DEF("WindowEdges", TestWindowEdges),
+    NL_TEST_DEF("Reset", TestReset),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestReplayWindow(void)
+{
+    nlTestSuite theSuite = { "Transport-ReplayWindow", &sTests[0], NULL, NULL };
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
+
+static void __attribute__((constructor)) TestReplayWindowCtor(void)
+{
+    VerifyOrDie(RegisterUnitTests(&TestReplayWindow) == CHIP_NO_ERROR);
+}
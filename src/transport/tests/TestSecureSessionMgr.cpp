@@ -68,10 +68,25 @@ public:
 
         size_t data_len = msgBuf->DataLength();
 
-        int compare = memcmp(msgBuf->Start(), PAYLOAD, data_len);
-        NL_TEST_ASSERT(mSuite, compare == 0);
+        if (LargePayload != nullptr)
+        {
+            NL_TEST_ASSERT(mSuite, msgBuf->TotalLength() == LargePayloadLength);
+            NL_TEST_ASSERT(mSuite, data_len == LargePayloadLength);
+            NL_TEST_ASSERT(mSuite, memcmp(msgBuf->Start(), LargePayload, LargePayloadLength) == 0);
+        }
+        else
+        {
+            int compare = memcmp(msgBuf->Start(), PAYLOAD, data_len);
+            NL_TEST_ASSERT(mSuite, compare == 0);
+        }
+
+        // Messages of a connection are delivered in the order they were sent
+        NL_TEST_ASSERT(mSuite, ReceiveHandlerCallCount == 0 || header.GetMessageId() > LastMessageId);
+        LastMessageId = header.GetMessageId();
 
         ReceiveHandlerCallCount++;
+
+        System::PacketBuffer::Free(msgBuf);
     }
 
     virtual void OnNewConnection(Transport::PeerConnectionState * state, SecureSessionMgr * mgr)
@@ -88,6 +103,9 @@ public:
     nlTestSuite * mSuite              = nullptr;
     int ReceiveHandlerCallCount       = 0;
     int NewConnectionHandlerCallCount = 0;
+    uint32_t LastMessageId            = 0;
+    const uint8_t * LargePayload      = nullptr; ///< expected instead of PAYLOAD when set
+    size_t LargePayloadLength         = 0;
 };
 
 TestSessMgrCallback callback;
@@ -147,6 +165,189 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
 }
 
+void CheckSendMessagesTest(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kMessageCount = 3;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(NULL);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SecureSessionMgr conn;
+
+    err = conn.Init(kSourceNodeId, &ctx.GetInetLayer(), Transport::UdpListenParameters().SetAddressType(addr.Type()));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.mSuite = inSuite;
+
+    conn.SetDelegate(&callback);
+
+    err = conn.Connect(kDestinationNodeId, Transport::PeerAddress::UDP(addr));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NodeId peerNodeIds[kMessageCount];
+    chip::System::PacketBuffer * buffers[kMessageCount];
+
+    for (int i = 0; i < kMessageCount; i++)
+    {
+        buffers[i] = chip::System::PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+        memmove(buffers[i]->Start(), PAYLOAD, sizeof(PAYLOAD));
+        buffers[i]->SetDataLength(sizeof(PAYLOAD));
+
+        peerNodeIds[i] = kDestinationNodeId;
+    }
+
+    // Each message is encrypted with its own IV, so none of them is dropped as a duplicate
+    callback.ReceiveHandlerCallCount = 0;
+
+    err = conn.SendMessages(peerNodeIds, buffers, kMessageCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return callback.ReceiveHandlerCallCount == kMessageCount; });
+
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == kMessageCount);
+}
+
+void CheckChainedMessageTest(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint16_t kFirstLength  = 500;
+    constexpr uint16_t kSecondLength = 900;
+    constexpr size_t kLength         = kFirstLength + kSecondLength;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    static uint8_t payload[kLength];
+    for (size_t i = 0; i < kLength; i++)
+    {
+        payload[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    ctx.GetInetLayer().SystemLayer()->Init(NULL);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // Messages above the IPv6 minimum MTU must be enabled explicitly.
+    {
+        SecureSessionMgr conn;
+
+        err = conn.Init(kSourceNodeId, &ctx.GetInetLayer(),
+                        Transport::UdpListenParameters().SetAddressType(addr.Type()).SetMaxPayloadLength(UINT16_MAX));
+        NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    SecureSessionMgr conn;
+
+    err = conn.Init(kSourceNodeId, &ctx.GetInetLayer(),
+                    Transport::UdpListenParameters().SetAddressType(addr.Type()).SetMaxPayloadLength(kLength));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.mSuite = inSuite;
+
+    conn.SetDelegate(&callback);
+
+    err = conn.Connect(kDestinationNodeId, Transport::PeerAddress::UDP(addr));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The message spans two buffers, which are encrypted and sent without being gathered first.
+    chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::NewWithAvailableSize(kFirstLength);
+    chip::System::PacketBuffer * second = chip::System::PacketBuffer::NewWithAvailableSize(0, kSecondLength);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && second != NULL);
+
+    memcpy(buffer->Start(), payload, kFirstLength);
+    buffer->SetDataLength(kFirstLength);
+    memcpy(second->Start(), payload + kFirstLength, kSecondLength);
+    second->SetDataLength(kSecondLength);
+    buffer->AddToEnd(second);
+
+    callback.ReceiveHandlerCallCount = 0;
+    callback.LargePayload            = payload;
+    callback.LargePayloadLength      = kLength;
+
+    err = conn.SendMessage(kDestinationNodeId, buffer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return callback.ReceiveHandlerCallCount != 0; });
+
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
+
+    // One byte more than the transport carries is rejected.
+    buffer = chip::System::PacketBuffer::NewWithAvailableSize(kLength + 1);
+    buffer->SetDataLength(kLength + 1);
+
+    err = conn.SendMessage(kDestinationNodeId, buffer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    callback.LargePayload       = nullptr;
+    callback.LargePayloadLength = 0;
+}
+
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+void CheckCryptoWorkerPoolTest(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kMessageCount = 4;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(NULL);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // Declared first so that it outlives the manager; static to keep the frame small
+    static Transport::CryptoWorkerPool pool;
+    static SecureSessionMgr conn;
+
+    err = pool.Init(ctx.GetInetLayer().SystemLayer(), 2);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = conn.SetCryptoWorkerPool(&pool);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INCORRECT_STATE);
+
+    err = conn.Init(kSourceNodeId, &ctx.GetInetLayer(), Transport::UdpListenParameters().SetAddressType(addr.Type()));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = conn.SetCryptoWorkerPool(&pool);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.mSuite = inSuite;
+
+    conn.SetDelegate(&callback);
+
+    err = conn.Connect(kDestinationNodeId, Transport::PeerAddress::UDP(addr));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Both the encryption and the decryption of every message happen on the workers
+    callback.ReceiveHandlerCallCount = 0;
+
+    for (int i = 0; i < kMessageCount; i++)
+    {
+        chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+        memmove(buffer->Start(), PAYLOAD, sizeof(PAYLOAD));
+        buffer->SetDataLength(sizeof(PAYLOAD));
+
+        err = conn.SendMessage(kDestinationNodeId, buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return callback.ReceiveHandlerCallCount == kMessageCount; });
+
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == kMessageCount);
+
+    err = conn.SetCryptoWorkerPool(nullptr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = pool.Shutdown();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+#endif // CHIP_CONFIG_CRYPTO_WORKER_POOL
+
 // Test Suite
 
 /**
@@ -157,6 +358,11 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("Simple Init Test",              CheckSimpleInitTest),
     NL_TEST_DEF("Message Self Test",             CheckMessageTest),
+    NL_TEST_DEF("Send Messages Self Test",       CheckSendMessagesTest),
+    NL_TEST_DEF("Chained Message Self Test",     CheckChainedMessageTest),
+#if CHIP_CONFIG_CRYPTO_WORKER_POOL
+    NL_TEST_DEF("Crypto Worker Pool Test",       CheckCryptoWorkerPoolTest),
+#endif
 
     NL_TEST_SENTINEL()
 };
@@ -63,6 +63,8 @@ void MessageReceiveHandler(const MessageHeader & header, const Transport::PeerAd
     NL_TEST_ASSERT(inSuite, compare == 0);
 
     ReceiveHandlerCallCount++;
+
+    System::PacketBuffer::Free(msgBuf);
 }
 
 } // namespace
@@ -134,6 +136,161 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress &
     NL_TEST_ASSERT(inSuite, ReceiveHandlerCallCount == 1);
 }
 
+/////////////////////////// Burst receive test
+
+void CheckMessageBurstTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+{
+    // More datagrams than a single batched receive can read at once
+    constexpr int kMessageCount = 3 * INET_CONFIG_UDP_RECV_BATCH_SIZE + 1;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Transport::UDP udp;
+
+    err = udp.Init(&ctx.GetInetLayer(), Transport::UdpListenParameters().SetAddressType(addr.Type()));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    udp.SetMessageReceiveHandler(MessageReceiveHandler, inSuite);
+    ReceiveHandlerCallCount = 0;
+
+    MessageHeader header;
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+
+    // Queue every datagram on the socket before the event loop gets to read any of them
+    for (int i = 0; i < kMessageCount; i++)
+    {
+        chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+        memmove(buffer->Start(), PAYLOAD, sizeof(PAYLOAD));
+        buffer->SetDataLength(sizeof(PAYLOAD));
+
+        err = udp.SendMessage(header, Transport::PeerAddress::UDP(addr), buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return ReceiveHandlerCallCount == kMessageCount; });
+
+    NL_TEST_ASSERT(inSuite, ReceiveHandlerCallCount == kMessageCount);
+}
+
+/////////////////////////// Batched send test
+
+void CheckSendMessagesTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+{
+    // All buffers are held at once, so stay well within the packet buffer pool
+    constexpr int kMessageCount = 5;
+    constexpr int kBadMessage   = 2;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Transport::UDP udp;
+
+    err = udp.Init(&ctx.GetInetLayer(), Transport::UdpListenParameters().SetAddressType(addr.Type()));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    udp.SetMessageReceiveHandler(MessageReceiveHandler, inSuite);
+    ReceiveHandlerCallCount = 0;
+
+    MessageHeader header;
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+
+    const Transport::PeerAddress peerAddress = Transport::PeerAddress::UDP(addr);
+    const Transport::PeerAddress badAddress  = Transport::PeerAddress::Uninitialized();
+    Transport::OutgoingMessage messages[kMessageCount];
+
+    for (int i = 0; i < kMessageCount; i++)
+    {
+        chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+        memmove(buffer->Start(), PAYLOAD, sizeof(PAYLOAD));
+        buffer->SetDataLength(sizeof(PAYLOAD));
+
+        messages[i].header  = &header;
+        messages[i].address = (i == kBadMessage) ? &badAddress : &peerAddress;
+        messages[i].msgBuf  = buffer;
+    }
+
+    err = udp.SendMessages(messages, kMessageCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return ReceiveHandlerCallCount == kMessageCount - 1; });
+
+    NL_TEST_ASSERT(inSuite, ReceiveHandlerCallCount == kMessageCount - 1);
+}
+
+/////////////////////////// Sharded receive test
+
+#if INET_CONFIG_ENABLE_IPV4 && CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__)
+void ShardReceiveHandler(const MessageHeader & header, const Transport::PeerAddress & source, System::PacketBuffer * msgBuf,
+                         int * receiveCount)
+{
+    (*receiveCount)++;
+    System::PacketBuffer::Free(msgBuf);
+}
+
+void CheckShardedReceiveTest4(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint16_t kShardCount  = 2;
+    constexpr uint16_t kShardPort   = CHIP_PORT + 1;
+    constexpr uint16_t kSenderPorts = CHIP_PORT + 2;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+
+    Transport::UDP shards[kShardCount];
+    int receiveCounts[kShardCount] = { 0 };
+
+    for (uint16_t i = 0; i < kShardCount; i++)
+    {
+        err = shards[i].Init(&ctx.GetInetLayer(),
+                             Transport::UdpListenParameters()
+                                 .SetAddressType(addr.Type())
+                                 .SetListenPort(kShardPort)
+                                 .SetShard(i, kShardCount));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        shards[i].SetMessageReceiveHandler(ShardReceiveHandler, &receiveCounts[i]);
+    }
+
+    MessageHeader header;
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+
+    // Consecutive source ports are assigned to different shards; each sender's message must reach its own.
+    for (uint16_t i = 0; i < kShardCount; i++)
+    {
+        const uint16_t senderPort = static_cast<uint16_t>(kSenderPorts + i);
+        const uint16_t shard      = Transport::UDP::ShardFor(Transport::PeerAddress::UDP(addr, senderPort), kShardCount);
+        const int expectedCount   = receiveCounts[shard] + 1;
+        Transport::UDP sender;
+
+        NL_TEST_ASSERT(inSuite, shards[shard].IsPeerInShard(Transport::PeerAddress::UDP(addr, senderPort)));
+        NL_TEST_ASSERT(inSuite, !shards[(shard + 1) % kShardCount].IsPeerInShard(Transport::PeerAddress::UDP(addr, senderPort)));
+
+        err = sender.Init(&ctx.GetInetLayer(),
+                          Transport::UdpListenParameters().SetAddressType(addr.Type()).SetListenPort(senderPort));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+        memmove(buffer->Start(), PAYLOAD, sizeof(PAYLOAD));
+        buffer->SetDataLength(sizeof(PAYLOAD));
+
+        err = sender.SendMessage(header, Transport::PeerAddress::UDP(addr, kShardPort), buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        ctx.DriveIOUntil(1000 /* ms */, [&receiveCounts, shard, expectedCount]() { return receiveCounts[shard] == expectedCount; });
+
+        NL_TEST_ASSERT(inSuite, receiveCounts[shard] == expectedCount);
+    }
+
+    NL_TEST_ASSERT(inSuite, receiveCounts[0] == 1 && receiveCounts[1] == 1);
+}
+#endif // INET_CONFIG_ENABLE_IPV4 && CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__)
+
 void CheckMessageTest4(nlTestSuite * inSuite, void * inContext)
 {
     IPAddress addr;
@@ -148,6 +305,22 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+#if INET_CONFIG_ENABLE_IPV4
+void CheckMessageBurstTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckMessageBurstTest(inSuite, inContext, addr);
+}
+
+void CheckSendMessagesTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckSendMessagesTest(inSuite, inContext, addr);
+}
+#endif
+
 // Test Suite
 
 /**
@@ -159,6 +332,11 @@ static const nlTest sTests[] =
 #if INET_CONFIG_ENABLE_IPV4
     NL_TEST_DEF("Simple Init Test IPV4",   CheckSimpleInitTest4),
     NL_TEST_DEF("Message Self Test IPV4",  CheckMessageTest4),
+    NL_TEST_DEF("Message Burst Test IPV4", CheckMessageBurstTest4),
+    NL_TEST_DEF("Send Messages Test IPV4", CheckSendMessagesTest4),
+#endif
+#if INET_CONFIG_ENABLE_IPV4 && CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__)
+    NL_TEST_DEF("Sharded Receive Test IPV4", CheckShardedReceiveTest4),
 #endif
 
     NL_TEST_DEF("Simple Init Test IPV6",   CheckSimpleInitTest6),